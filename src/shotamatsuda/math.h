@@ -37,17 +37,37 @@ extern const unsigned char version_string[];
 }  // namespace math
 }  // namespace shotamatsuda
 
+#include "shotamatsuda/math/alias_table.h"
 #include "shotamatsuda/math/axis.h"
 #include "shotamatsuda/math/circle.h"
 #include "shotamatsuda/math/constants.h"
 #include "shotamatsuda/math/functions.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/line_intersection.h"
+#include "shotamatsuda/math/mesh_sampler.h"
+#include "shotamatsuda/math/pairwise.h"
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/pcg.h"
+#include "shotamatsuda/math/philox.h"
+#include "shotamatsuda/math/poisson.h"
+#include "shotamatsuda/math/polyline.h"
+#include "shotamatsuda/math/predicates.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
 #include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/reduction.h"
 #include "shotamatsuda/math/roots.h"
+#include "shotamatsuda/math/rsqrt.h"
+#include "shotamatsuda/math/sequence.h"
+#include "shotamatsuda/math/simplification.h"
 #include "shotamatsuda/math/size.h"
 #include "shotamatsuda/math/triangle.h"
 #include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/vector_buffer.h"
+#include "shotamatsuda/math/vector_expression.h"
+#include "shotamatsuda/math/vector4x.h"
+#include "shotamatsuda/math/xoshiro.h"
+#include "shotamatsuda/math/ziggurat.h"
 
 #endif  // SHOTAMATSUDA_MATH_H_
@@ -0,0 +1,166 @@
+//
+//  shotamatsuda/math/alias_table.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_ALIAS_TABLE_H_
+#define SHOTAMATSUDA_MATH_ALIAS_TABLE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "shotamatsuda/math/uint128.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Discrete distribution over indices with probabilities proportional to the
+// given non-negative weights, built with Vose's method of Walker's alias
+// table in O(n) time and sampled in O(1) time from a single 64-bit word.
+// Draw indices with Random::discrete() or Random::fillDiscrete().
+class AliasTable final {
+ public:
+  // Scratch storage of build(), which can be kept across builds of tables
+  // to avoid allocations
+  struct Workspace {
+    std::vector<double> probabilities;
+    std::vector<std::uint32_t> underfull;
+    std::vector<std::uint32_t> overfull;
+  };
+
+ public:
+  AliasTable() = default;
+  template <class T>
+  AliasTable(const T *weights, std::size_t size);
+
+  // Copy semantics
+  AliasTable(const AliasTable&) = default;
+  AliasTable& operator=(const AliasTable&) = default;
+
+  // Rebuilds the table in place, reusing its storage and the scratch storage
+  // of the workspace when given
+  template <class T>
+  void build(const T *weights, std::size_t size);
+  template <class T>
+  void build(const T *weights, std::size_t size, Workspace *workspace);
+
+  // Attributes
+  bool empty() const { return entries_.empty(); }
+  std::size_t size() const { return entries_.size(); }
+
+  // Maps a uniformly distributed word to an index
+  std::size_t operator()(std::uint64_t word) const;
+
+ private:
+  struct Entry {
+    std::uint32_t threshold;
+    std::uint32_t alias;
+  };
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+// MARK: -
+
+template <class T>
+inline AliasTable::AliasTable(const T *weights, std::size_t size) {
+  build(weights, size);
+}
+
+template <class T>
+inline void AliasTable::build(const T *weights, std::size_t size) {
+  Workspace workspace;
+  build(weights, size, &workspace);
+}
+
+template <class T>
+inline void AliasTable::build(const T *weights, std::size_t size,
+                              Workspace *workspace) {
+  assert(weights || !size);
+  assert(workspace);
+  assert(size <= 0xffffffff);
+  double sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    assert(weights[i] >= 0);
+    sum += weights[i];
+  }
+  assert(!size || sum > 0);
+  entries_.resize(size);
+  auto& probabilities = workspace->probabilities;
+  auto& underfull = workspace->underfull;
+  auto& overfull = workspace->overfull;
+  probabilities.resize(size);
+  underfull.clear();
+  overfull.clear();
+  const auto scale = size / sum;
+  for (std::size_t i = 0; i < size; ++i) {
+    probabilities[i] = weights[i] * scale;
+    (probabilities[i] < 1 ? underfull : overfull).emplace_back(
+        static_cast<std::uint32_t>(i));
+  }
+  while (!underfull.empty() && !overfull.empty()) {
+    const auto less = underfull.back();
+    const auto more = overfull.back();
+    underfull.pop_back();
+    entries_[less].threshold = static_cast<std::uint32_t>(
+        probabilities[less] * 4294967296.0);
+    entries_[less].alias = more;
+    probabilities[more] -= 1 - probabilities[less];
+    if (probabilities[more] < 1) {
+      overfull.pop_back();
+      underfull.emplace_back(more);
+    }
+  }
+  // What remains has a probability of 1 up to rounding errors, and aliases
+  // itself so that the threshold never needs to represent 1 exactly
+  for (const auto index : underfull) {
+    entries_[index] = {0xffffffff, index};
+  }
+  for (const auto index : overfull) {
+    entries_[index] = {0xffffffff, index};
+  }
+}
+
+inline std::size_t AliasTable::operator()(std::uint64_t word) const {
+  assert(!empty());
+  // The high half of the product is the column, and the low half is nearly
+  // uniform within it and decides between the column and its alias
+  const std::uint64_t size = entries_.size();
+  const auto index = detail::multiplyHigh(word, size);
+  const auto fraction = static_cast<std::uint32_t>(word * size >> 32);
+  const auto& entry = entries_[index];
+  return fraction < entry.threshold ? index : entry.alias;
+}
+
+}  // namespace math
+
+using math::AliasTable;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_ALIAS_TABLE_H_
@@ -28,11 +28,16 @@
 #ifndef SHOTAMATSUDA_MATH_CIRCLE2_H_
 #define SHOTAMATSUDA_MATH_CIRCLE2_H_
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <functional>
 
 #include "shotamatsuda/math/constants.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/random.h"
 #include "shotamatsuda/math/vector.h"
 
 namespace shotamatsuda {
@@ -75,6 +80,15 @@ class Circle<T, 2> final {
   Promote<T> circumference() const;
   Promote<T> area() const;
 
+  // Sampling of uniformly distributed points inside the circle
+  Vec2<Promote<T>> randomPoint() const;
+  template <class Random>
+  Vec2<Promote<T>> randomPoint(Random *random) const;
+  void randomPoints(Vec2<Promote<T>> *points, std::size_t size) const;
+  template <class Random>
+  void randomPoints(Vec2<Promote<T>> *points, std::size_t size,
+                    Random *random) const;
+
   // Canonicalization
   bool canonical() const { return radius > 0; }
   Circle& canonicalize();
@@ -202,6 +216,55 @@ inline Promote<T> Circle<T, 2>::area() const {
   return radius * radius * pi<T>();
 }
 
+// MARK: Sampling
+
+template <class T>
+inline Vec2<Promote<T>> Circle<T, 2>::randomPoint() const {
+  return randomPoint(&Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline Vec2<Promote<T>> Circle<T, 2>::randomPoint(Random *random) const {
+  assert(random);
+  using Real = Promote<T>;
+  // The square root of the uniform value makes the radial density linear,
+  // matching the circumference at each radius
+  const auto s = random->template uniform<Real>(0, 1);
+  const auto t = random->template uniform<Real>(0, 1);
+  const auto distance = radius * std::sqrt(s);
+  const auto angle = tau<Real>() * t;
+  return Vec2<Real>(x + distance * std::cos(angle),
+                    y + distance * std::sin(angle));
+}
+
+template <class T>
+inline void Circle<T, 2>::randomPoints(Vec2<Promote<T>> *points,
+                                       std::size_t size) const {
+  randomPoints(points, size, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Circle<T, 2>::randomPoints(Vec2<Promote<T>> *points,
+                                       std::size_t size,
+                                       Random *random) const {
+  assert(points || !size);
+  assert(random);
+  using Real = Promote<T>;
+  Real uniforms[detail::kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    random->fillUniform(uniforms, count * 2, Real(0), Real(1));
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto distance = radius * std::sqrt(uniforms[i]);
+      const auto angle = tau<Real>() * uniforms[count + i];
+      points[first + i].x = x + distance * std::cos(angle);
+      points[first + i].y = y + distance * std::sin(angle);
+    }
+  }
+}
+
 // MARK: Canonicalization
 
 template <class T>
@@ -237,8 +300,7 @@ using math::Circle2d;
 template <class T>
 struct std::hash<shotamatsuda::math::Circle2<T>> {
   std::size_t operator()(const shotamatsuda::math::Circle2<T>& value) const {
-    return ((std::hash<shotamatsuda::math::Vec2<T>>()(value.center) << 0) ^
-            (std::hash<T>()(value.radius) << 1));
+    return shotamatsuda::math::hash(value.center, value.radius);
   }
 };
 
@@ -0,0 +1,90 @@
+//
+//  shotamatsuda/math/hash.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_HASH_H_
+#define SHOTAMATSUDA_MATH_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace shotamatsuda {
+namespace math {
+
+// Combines the std::hash values of the arguments with the xxHash64 round and
+// avalanche steps. Unlike shifting and xoring, every input bit affects every
+// output bit, so grid-aligned integer points spread evenly across buckets.
+template <class T, class... Args>
+std::size_t hash(const T& value, const Args&... values);
+
+// MARK: -
+
+namespace detail {
+
+constexpr std::uint64_t kHashPrime1 = 0x9e3779b185ebca87;
+constexpr std::uint64_t kHashPrime2 = 0xc2b2ae3d27d4eb4f;
+constexpr std::uint64_t kHashPrime3 = 0x165667b19e3779f9;
+constexpr std::uint64_t kHashPrime4 = 0x85ebca77c2b2ae63;
+constexpr std::uint64_t kHashPrime5 = 0x27d4eb2f165667c5;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int shift) {
+  return (value << shift) | (value >> (-shift & 63));
+}
+
+inline std::uint64_t mergeHash(std::uint64_t hash, std::uint64_t value) {
+  hash ^= rotateLeft(value * kHashPrime2, 31) * kHashPrime1;
+  return rotateLeft(hash, 27) * kHashPrime1 + kHashPrime4;
+}
+
+inline std::uint64_t avalancheHash(std::uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= kHashPrime2;
+  hash ^= hash >> 29;
+  hash *= kHashPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+}  // namespace detail
+
+template <class T, class... Args>
+inline std::size_t hash(const T& value, const Args&... values) {
+  const std::uint64_t hashes[] = {
+    std::hash<T>()(value),
+    std::hash<Args>()(values)...
+  };
+  std::uint64_t result = detail::kHashPrime5 + sizeof(hashes);
+  for (const auto element : hashes) {
+    result = detail::mergeHash(result, element);
+  }
+  return static_cast<std::size_t>(detail::avalancheHash(result));
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_HASH_H_
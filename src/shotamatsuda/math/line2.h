@@ -28,16 +28,20 @@
 #ifndef SHOTAMATSUDA_MATH_LINE2_H_
 #define SHOTAMATSUDA_MATH_LINE2_H_
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <ostream>
 #include <utility>
 
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/side.h"
+#include "shotamatsuda/math/simd.h"
 #include "shotamatsuda/math/vector.h"
 
 namespace shotamatsuda {
@@ -121,6 +125,15 @@ class Line<T, 2> final {
   template <class U = T>
   Side side(const Vec2<U>& point) const;
 
+  // Classifies points in bulk without branches, using SSE for float and
+  // double points. The masks have bit i % 64 of word i / 64 set for points
+  // on the left and the right, and either may be null.
+  template <class U = T>
+  void side(const Vec2<U> *points, std::size_t size, Side *sides) const;
+  template <class U = T>
+  void side(const Vec2<U> *points, std::size_t size,
+            std::uint64_t *left, std::uint64_t *right) const;
+
   // Iterator
   Iterator begin() { return &a; }
   ConstIterator begin() const { return &a; }
@@ -158,6 +171,163 @@ using Line2d = Line2<double>;
 
 // MARK: -
 
+namespace detail {
+
+template <class T, class U>
+inline void lineSides(const Vec2<T>& a, const Vec2<T>& b,
+                      const Vec2<U> *points, std::size_t size, Side *sides) {
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto& point = points[i];
+    const auto d = ((b.x - a.x) * (point.y - a.y) -
+                    (b.y - a.y) * (point.x - a.x));
+    sides[i] = static_cast<Side>((d < 0) | (d > 0) << 1);
+  }
+}
+
+// Writes only the masks enabled by Left and Right, so that the disabled one
+// may be null
+template <bool Left, bool Right, class T, class U>
+inline void lineSides(const Vec2<T>& a, const Vec2<T>& b,
+                      const Vec2<U> *points, std::size_t size,
+                      std::uint64_t *left, std::uint64_t *right,
+                      std::size_t first = 0) {
+  for (std::size_t i = first; i < size; ++i) {
+    const auto& point = points[i];
+    const auto d = ((b.x - a.x) * (point.y - a.y) -
+                    (b.y - a.y) * (point.x - a.x));
+    const auto bit = static_cast<std::uint64_t>(1) << (i % 64);
+    if (Left) {
+      left[i / 64] |= (d < 0) * bit;
+    }
+    if (Right) {
+      right[i / 64] |= (d > 0) * bit;
+    }
+  }
+}
+
+#if SHOTAMATSUDA_HAS_SSE2
+
+// Deinterleaves four points into their coordinates and computes the cross
+// products in the same order of operations as the scalar code
+inline __m128 lineSides(__m128 ax, __m128 ay, __m128 dx, __m128 dy,
+                        const Vec2<float> *points) {
+  const auto lower = _mm_loadu_ps(&points[0].x);
+  const auto upper = _mm_loadu_ps(&points[2].x);
+  const auto x = _mm_shuffle_ps(lower, upper, _MM_SHUFFLE(2, 0, 2, 0));
+  const auto y = _mm_shuffle_ps(lower, upper, _MM_SHUFFLE(3, 1, 3, 1));
+  return _mm_sub_ps(_mm_mul_ps(dx, _mm_sub_ps(y, ay)),
+                    _mm_mul_ps(dy, _mm_sub_ps(x, ax)));
+}
+
+inline __m128d lineSides(__m128d ax, __m128d ay, __m128d dx, __m128d dy,
+                         const Vec2<double> *points) {
+  const auto lower = _mm_loadu_pd(&points[0].x);
+  const auto upper = _mm_loadu_pd(&points[1].x);
+  const auto x = _mm_unpacklo_pd(lower, upper);
+  const auto y = _mm_unpackhi_pd(lower, upper);
+  return _mm_sub_pd(_mm_mul_pd(dx, _mm_sub_pd(y, ay)),
+                    _mm_mul_pd(dy, _mm_sub_pd(x, ax)));
+}
+
+inline void lineSides(const Vec2<float>& a, const Vec2<float>& b,
+                      const Vec2<float> *points, std::size_t size,
+                      Side *sides) {
+  static_assert(sizeof(Side) == sizeof(std::int32_t),
+                "Sides must be stored in 32-bit lanes");
+  const auto ax = _mm_set1_ps(a.x);
+  const auto ay = _mm_set1_ps(a.y);
+  const auto dx = _mm_set1_ps(b.x - a.x);
+  const auto dy = _mm_set1_ps(b.y - a.y);
+  const auto zero = _mm_setzero_ps();
+  const auto left_value = _mm_set1_epi32(static_cast<int>(Side::LEFT));
+  const auto right_value = _mm_set1_epi32(static_cast<int>(Side::RIGHT));
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto d = lineSides(ax, ay, dx, dy, points + i);
+    const auto left = _mm_castps_si128(_mm_cmplt_ps(d, zero));
+    const auto right = _mm_castps_si128(_mm_cmpgt_ps(d, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sides + i),
+                     _mm_or_si128(_mm_and_si128(left, left_value),
+                                  _mm_and_si128(right, right_value)));
+  }
+  lineSides<float, float>(a, b, points + i, size - i, sides + i);
+}
+
+inline void lineSides(const Vec2<double>& a, const Vec2<double>& b,
+                      const Vec2<double> *points, std::size_t size,
+                      Side *sides) {
+  const auto ax = _mm_set1_pd(a.x);
+  const auto ay = _mm_set1_pd(a.y);
+  const auto dx = _mm_set1_pd(b.x - a.x);
+  const auto dy = _mm_set1_pd(b.y - a.y);
+  const auto zero = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    const auto d = lineSides(ax, ay, dx, dy, points + i);
+    const auto left = _mm_movemask_pd(_mm_cmplt_pd(d, zero));
+    const auto right = _mm_movemask_pd(_mm_cmpgt_pd(d, zero));
+    sides[i] = static_cast<Side>((left & 1) | (right & 1) << 1);
+    sides[i + 1] = static_cast<Side>((left >> 1) | (right & 2));
+  }
+  lineSides<double, double>(a, b, points + i, size - i, sides + i);
+}
+
+template <bool Left, bool Right>
+inline void lineSides(const Vec2<float>& a, const Vec2<float>& b,
+                      const Vec2<float> *points, std::size_t size,
+                      std::uint64_t *left, std::uint64_t *right,
+                      std::size_t first = 0) {
+  const auto ax = _mm_set1_ps(a.x);
+  const auto ay = _mm_set1_ps(a.y);
+  const auto dx = _mm_set1_ps(b.x - a.x);
+  const auto dy = _mm_set1_ps(b.y - a.y);
+  const auto zero = _mm_setzero_ps();
+  std::size_t i = first;
+  for (; i + 4 <= size; i += 4) {
+    const auto d = lineSides(ax, ay, dx, dy, points + i);
+    const auto shift = i % 64;
+    if (Left) {
+      left[i / 64] |= static_cast<std::uint64_t>(
+          _mm_movemask_ps(_mm_cmplt_ps(d, zero))) << shift;
+    }
+    if (Right) {
+      right[i / 64] |= static_cast<std::uint64_t>(
+          _mm_movemask_ps(_mm_cmpgt_ps(d, zero))) << shift;
+    }
+  }
+  lineSides<Left, Right, float, float>(a, b, points, size, left, right, i);
+}
+
+template <bool Left, bool Right>
+inline void lineSides(const Vec2<double>& a, const Vec2<double>& b,
+                      const Vec2<double> *points, std::size_t size,
+                      std::uint64_t *left, std::uint64_t *right,
+                      std::size_t first = 0) {
+  const auto ax = _mm_set1_pd(a.x);
+  const auto ay = _mm_set1_pd(a.y);
+  const auto dx = _mm_set1_pd(b.x - a.x);
+  const auto dy = _mm_set1_pd(b.y - a.y);
+  const auto zero = _mm_setzero_pd();
+  std::size_t i = first;
+  for (; i + 2 <= size; i += 2) {
+    const auto d = lineSides(ax, ay, dx, dy, points + i);
+    const auto shift = i % 64;
+    if (Left) {
+      left[i / 64] |= static_cast<std::uint64_t>(
+          _mm_movemask_pd(_mm_cmplt_pd(d, zero))) << shift;
+    }
+    if (Right) {
+      right[i / 64] |= static_cast<std::uint64_t>(
+          _mm_movemask_pd(_mm_cmpgt_pd(d, zero))) << shift;
+    }
+  }
+  lineSides<Left, Right, double, double>(a, b, points, size, left, right, i);
+}
+
+#endif  // SHOTAMATSUDA_HAS_SSE2
+
+}  // namespace detail
+
 template <class T>
 inline Line<T, 2>::Line() : a(), b() {}
 
@@ -346,7 +516,35 @@ template <class T>
 template <class U>
 inline Side Line<T, 2>::side(const Vec2<U>& point) const {
   const auto d = (b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x);
-  return !d ? (d < 0 ? Side::LEFT : Side::RIGHT) : Side::COINCIDENT;
+  return d < 0 ? Side::LEFT : d > 0 ? Side::RIGHT : Side::COINCIDENT;
+}
+
+template <class T>
+template <class U>
+inline void Line<T, 2>::side(const Vec2<U> *points, std::size_t size,
+                             Side *sides) const {
+  assert((points && sides) || !size);
+  detail::lineSides(a, b, points, size, sides);
+}
+
+template <class T>
+template <class U>
+inline void Line<T, 2>::side(const Vec2<U> *points, std::size_t size,
+                             std::uint64_t *left,
+                             std::uint64_t *right) const {
+  assert(points || !size);
+  const auto words = (size + 63) / 64;
+  if (left && right) {
+    std::fill(left, left + words, 0);
+    std::fill(right, right + words, 0);
+    detail::lineSides<true, true>(a, b, points, size, left, right);
+  } else if (left) {
+    std::fill(left, left + words, 0);
+    detail::lineSides<true, false>(a, b, points, size, left, right);
+  } else if (right) {
+    std::fill(right, right + words, 0);
+    detail::lineSides<false, true>(a, b, points, size, left, right);
+  }
 }
 
 // MARK: Stream
@@ -369,8 +567,7 @@ using math::Line2d;
 template <class T>
 struct std::hash<shotamatsuda::math::Line2<T>> {
   std::size_t operator()(const shotamatsuda::math::Line2<T>& value) const {
-    std::hash<shotamatsuda::math::Vec2<T>> hash;
-    return (hash(value.a) << 0) ^ (hash(value.b) << 1);
+    return shotamatsuda::math::hash(value.a, value.b);
   }
 };
 
@@ -35,6 +35,7 @@
 #include <iterator>
 #include <ostream>
 
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/vector.h"
 
@@ -340,8 +341,7 @@ using math::Line3d;
 template <class T>
 struct std::hash<shotamatsuda::math::Line3<T>> {
   std::size_t operator()(const shotamatsuda::math::Line3<T>& value) const {
-    std::hash<shotamatsuda::math::Vec3<T>> hash;
-    return (hash(value.a) << 0) ^ (hash(value.b) << 1);
+    return shotamatsuda::math::hash(value.a, value.b);
   }
 };
 
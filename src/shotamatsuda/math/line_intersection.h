@@ -0,0 +1,416 @@
+//
+//  shotamatsuda/math/line_intersection.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_LINE_INTERSECTION_H_
+#define SHOTAMATSUDA_MATH_LINE_INTERSECTION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/predicates.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+struct LineIntersection {
+  using Type = T;
+
+  // Collinear lines that overlap intersect in a line from the point to the
+  // end, and the other intersections have the end equal to the point.
+  bool overlaps() const { return point != end; }
+
+  std::size_t first;
+  std::size_t second;
+  Vec2<T> point;
+  Vec2<T> end;
+};
+
+// Reports every pair of intersecting lines with first < second in the order
+// of the sweep, which runs along x and then y, using the sweep of Bentley and
+// Ottmann in O((n + k) log n) time for n lines and k intersections. Shared
+// endpoints, endpoints on other lines, collinear overlaps, vertical lines,
+// lines of zero length and any number of lines through the same point are
+// all reported, and each pair exactly once.
+template <class T>
+std::vector<LineIntersection<Promote<T>>> intersectLines(
+    const Line2<T> *lines, std::size_t size);
+
+// MARK: -
+
+namespace detail {
+
+template <class T>
+inline T orientation(const Vec2<T>& a, const Vec2<T>& b,
+                     const Vec2<T>& point) {
+  return (b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x);
+}
+
+// Intersects lines whose starts precede their ends in the sweep order. The
+// orientations of the endpoints are exact, so that touching, collinearity and
+// intersections at endpoints are decided without rounding, and the latter
+// are returned as the endpoints themselves.
+template <class T>
+inline bool intersectSweepLines(const Vec2<T>& start1, const Vec2<T>& end1,
+                                const Vec2<T>& start2, const Vec2<T>& end2,
+                                Vec2<T> *point, Vec2<T> *end) {
+  const auto start2_side = orient2d(start1, end1, start2);
+  const auto end2_side = orient2d(start1, end1, end2);
+  const auto start1_side = orient2d(start2, end2, start1);
+  const auto end1_side = orient2d(start2, end2, end1);
+  if (!start1_side && !end1_side && !start2_side && !end2_side) {
+    *point = std::max(start1, start2);
+    *end = std::min(end1, end2);
+    return !(*end < *point);
+  }
+  if ((start2_side > 0 && end2_side > 0) ||
+      (start2_side < 0 && end2_side < 0) ||
+      (start1_side > 0 && end1_side > 0) ||
+      (start1_side < 0 && end1_side < 0)) {
+    return false;
+  }
+  if (!start1_side) {
+    *point = start1;
+  } else if (!end1_side) {
+    *point = end1;
+  } else if (!start2_side) {
+    *point = start2;
+  } else if (!end2_side) {
+    *point = end2;
+  } else {
+    // The sides have opposite signs, so the parameter lies in (0, 1) even
+    // when the lines are nearly parallel
+    const auto t = start1_side / (start1_side - end1_side);
+    *point = start1 + (end1 - start1) * static_cast<T>(t);
+  }
+  *end = *point;
+  return true;
+}
+
+constexpr int kLineSweepTolerance = 16;
+
+template <class T>
+class LineSweep final {
+ public:
+  LineSweep(std::vector<Vec2<T>> starts, std::vector<Vec2<T>> ends);
+
+  // Disallow copy semantics, as the status refers to the sweep
+  LineSweep(const LineSweep&) = delete;
+  LineSweep& operator=(const LineSweep&) = delete;
+
+  std::vector<LineIntersection<T>> run();
+
+ private:
+  struct Event {
+    std::vector<std::size_t> starts;
+    std::vector<std::size_t> ends;
+    std::vector<std::size_t> crossings;
+  };
+
+  struct StatusLess {
+    bool operator()(std::size_t lhs, std::size_t rhs) const {
+      return sweep->less(lhs, rhs);
+    }
+    const LineSweep *sweep;
+  };
+
+  using Status = std::set<std::size_t, StatusLess>;
+
+ private:
+  int position(std::size_t line) const;
+  bool less(std::size_t lhs, std::size_t rhs) const;
+  void collect(std::size_t line);
+  void handle(const Event& event);
+  void report(std::size_t first, std::size_t second);
+  void schedule(typename Status::iterator first,
+                typename Status::iterator second);
+  std::uint64_t key(std::size_t first, std::size_t second) const;
+
+ private:
+  std::vector<Vec2<T>> starts_;
+  std::vector<Vec2<T>> ends_;
+  std::size_t probe_;
+  Vec2<T> point_;
+  std::map<Vec2<T>, Event> events_;
+  Status status_;
+  std::vector<typename Status::iterator> positions_;
+  std::vector<unsigned char> active_;
+  std::vector<unsigned char> through_;
+  std::vector<std::size_t> found_;
+  std::vector<std::size_t> lines_;
+  std::unordered_set<std::uint64_t> reported_;
+  std::vector<LineIntersection<T>> result_;
+};
+
+template <class T>
+inline LineSweep<T>::LineSweep(std::vector<Vec2<T>> starts,
+                               std::vector<Vec2<T>> ends)
+    : starts_(std::move(starts)),
+      ends_(std::move(ends)),
+      probe_(starts_.size()),
+      status_(StatusLess{this}),
+      positions_(starts_.size()),
+      active_(starts_.size()),
+      through_(starts_.size() + 1) {
+  assert(starts_.size() == ends_.size());
+  // The probe stands for the sweep point in the status
+  through_[probe_] = true;
+  for (std::size_t i = 0; i < starts_.size(); ++i) {
+    events_[starts_[i]].starts.emplace_back(i);
+    events_[ends_[i]].ends.emplace_back(i);
+  }
+}
+
+template <class T>
+inline std::vector<LineIntersection<T>> LineSweep<T>::run() {
+  while (!events_.empty()) {
+    const auto first = events_.begin();
+    point_ = first->first;
+    const auto event = std::move(first->second);
+    events_.erase(first);
+    handle(event);
+  }
+  return std::move(result_);
+}
+
+// Returns -1, 0 or 1 when the line passes below, through or above the sweep
+// point. Lines marked as passing through it take precedence, because the
+// intersections that put them there are rounded.
+template <class T>
+inline int LineSweep<T>::position(std::size_t line) const {
+  if (through_[line]) {
+    return 0;
+  }
+  const auto& start = starts_[line];
+  const auto& end = ends_[line];
+  const auto orientation = detail::orientation(start, end, point_);
+  // Rounded intersections are off the lines by a few units in the last place
+  // of the coordinates, and lines within that distance pass through
+  const auto magnitude = std::max({
+      std::abs(start.x), std::abs(start.y),
+      std::abs(end.x), std::abs(end.y),
+      std::abs(point_.x), std::abs(point_.y)});
+  const auto tolerance = (kLineSweepTolerance *
+                          std::numeric_limits<T>::epsilon() * magnitude *
+                          (std::abs(end.x - start.x) +
+                           std::abs(end.y - start.y)));
+  if (std::abs(orientation) > tolerance) {
+    return orientation > 0 ? -1 : 1;
+  }
+  // Vertical lines in the status are collinear with the sweep point
+  return end < point_ ? -1 : point_ < start ? 1 : 0;
+}
+
+// Orders lines by where they cross the sweep line, and lines through the
+// sweep point by their directions just after it
+template <class T>
+inline bool LineSweep<T>::less(std::size_t lhs, std::size_t rhs) const {
+  const auto lhs_position = position(lhs);
+  const auto rhs_position = position(rhs);
+  if (lhs_position != rhs_position) {
+    return lhs_position < rhs_position;
+  }
+  if (lhs_position || lhs == probe_ || rhs == probe_) {
+    return false;
+  }
+  const auto cross = (ends_[lhs] - starts_[lhs]).cross(
+      ends_[rhs] - starts_[rhs]);
+  return cross ? cross > 0 : lhs < rhs;
+}
+
+template <class T>
+inline void LineSweep<T>::collect(std::size_t line) {
+  if (!through_[line]) {
+    through_[line] = true;
+    lines_.emplace_back(line);
+  }
+}
+
+template <class T>
+inline void LineSweep<T>::handle(const Event& event) {
+  // Lines in the status through the sweep point are contiguous, and are
+  // found before marking the rounded crossings that may not be
+  auto it = status_.lower_bound(probe_);
+  for (; it != status_.end() && !less(probe_, *it); ++it) {
+    found_.emplace_back(*it);
+  }
+  for (const auto line : found_) {
+    collect(line);
+  }
+  found_.clear();
+  for (const auto line : event.starts) {
+    collect(line);
+  }
+  for (const auto line : event.ends) {
+    collect(line);
+  }
+  for (const auto line : event.crossings) {
+    if (active_[line]) {
+      collect(line);
+    }
+  }
+  for (std::size_t i = 0; i < lines_.size(); ++i) {
+    for (std::size_t j = i + 1; j < lines_.size(); ++j) {
+      report(lines_[i], lines_[j]);
+    }
+  }
+
+  // Reinserting the lines that continue past the sweep point reorders them
+  // by their directions, which swaps the ones crossing at it
+  for (const auto line : lines_) {
+    if (active_[line]) {
+      status_.erase(positions_[line]);
+      active_[line] = false;
+    }
+  }
+  bool inserted = false;
+  for (const auto line : lines_) {
+    if (point_ < ends_[line]) {
+      positions_[line] = status_.insert(line).first;
+      active_[line] = true;
+      inserted = true;
+    }
+  }
+  const auto lower = status_.lower_bound(probe_);
+  if (!inserted) {
+    if (lower != status_.begin() && lower != status_.end()) {
+      schedule(std::prev(lower), lower);
+    }
+  } else {
+    const auto upper = status_.upper_bound(probe_);
+    if (lower != status_.begin()) {
+      schedule(std::prev(lower), lower);
+    }
+    if (upper != status_.end()) {
+      schedule(std::prev(upper), upper);
+    }
+  }
+  for (const auto line : lines_) {
+    through_[line] = false;
+  }
+  lines_.clear();
+}
+
+template <class T>
+inline void LineSweep<T>::report(std::size_t first, std::size_t second) {
+  if (first > second) {
+    std::swap(first, second);
+  }
+  if (reported_.count(key(first, second))) {
+    return;
+  }
+  // Lines that pass near the sweep point within the tolerance but do not
+  // intersect are not reported
+  LineIntersection<T> intersection{first, second};
+  if (detail::intersectSweepLines(starts_[first], ends_[first],
+                                  starts_[second], ends_[second],
+                                  &intersection.point, &intersection.end)) {
+    reported_.emplace(key(first, second));
+    result_.emplace_back(intersection);
+  }
+}
+
+template <class T>
+inline void LineSweep<T>::schedule(typename Status::iterator first,
+                                   typename Status::iterator second) {
+  if (reported_.count(key(std::min(*first, *second),
+                          std::max(*first, *second)))) {
+    return;
+  }
+  Vec2<T> point;
+  Vec2<T> end;
+  if (!detail::intersectSweepLines(starts_[*first], ends_[*first],
+                                   starts_[*second], ends_[*second],
+                                   &point, &end)) {
+    return;
+  }
+  // Rounding may place the intersection behind the sweep point, where it is
+  // handled right away, or past the end of either line
+  point = std::max(point, point_);
+  point = std::min(point, std::min(ends_[*first], ends_[*second]));
+  auto& crossings = events_[point].crossings;
+  crossings.emplace_back(*first);
+  crossings.emplace_back(*second);
+}
+
+template <class T>
+inline std::uint64_t LineSweep<T>::key(std::size_t first,
+                                       std::size_t second) const {
+  return static_cast<std::uint64_t>(first) * probe_ + second;
+}
+
+}  // namespace detail
+
+template <class T>
+inline std::vector<LineIntersection<Promote<T>>> intersectLines(
+    const Line2<T> *lines, std::size_t size) {
+  // The sweep runs in at least double precision, because the order of the
+  // status depends on the rounding of intersections
+  using Real = Promote<T, double>;
+  assert(lines || !size);
+  std::vector<Vec2<Real>> starts(size);
+  std::vector<Vec2<Real>> ends(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    starts[i] = std::min<Vec2<Real>>(lines[i].a, lines[i].b);
+    ends[i] = std::max<Vec2<Real>>(lines[i].a, lines[i].b);
+  }
+  detail::LineSweep<Real> sweep(std::move(starts), std::move(ends));
+  auto intersections = sweep.run();
+  std::vector<LineIntersection<Promote<T>>> result(intersections.size());
+  for (std::size_t i = 0; i < intersections.size(); ++i) {
+    const auto& intersection = intersections[i];
+    result[i] = {
+      intersection.first,
+      intersection.second,
+      intersection.point,
+      intersection.end
+    };
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::LineIntersection;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_LINE_INTERSECTION_H_
@@ -0,0 +1,218 @@
+//
+//  shotamatsuda/math/mesh_sampler.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_MESH_SAMPLER_H_
+#define SHOTAMATSUDA_MATH_MESH_SAMPLER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "shotamatsuda/math/alias_table.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/triangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T, int D>
+class MeshSampler;
+
+template <class T>
+using MeshSampler2 = MeshSampler<T, 2>;
+template <class T>
+using MeshSampler3 = MeshSampler<T, 3>;
+
+// Samples uniformly distributed points over the surface of a set of
+// triangles. A triangle is chosen in proportion to its area from an alias
+// table in O(1) time, and a point is then warped onto it without rejection.
+template <class T, int D>
+class MeshSampler final {
+ public:
+  using Type = T;
+  using Real = Promote<T>;
+  static constexpr const auto dimensions = D;
+
+ public:
+  MeshSampler() = default;
+  MeshSampler(const Triangle<T, D> *triangles, std::size_t size);
+
+  // Copy semantics
+  MeshSampler(const MeshSampler&) = default;
+  MeshSampler& operator=(const MeshSampler&) = default;
+
+  // Rebuilds the sampler in place, reusing its storage
+  void build(const Triangle<T, D> *triangles, std::size_t size);
+
+  // Attributes
+  bool empty() const { return triangles_.empty(); }
+  std::size_t size() const { return triangles_.size(); }
+  Real area() const { return area_; }
+
+  // Element access
+  const Triangle<T, D>& at(std::size_t index) const;
+  const Triangle<T, D>& operator[](std::size_t index) const;
+
+  // Sampling
+  std::size_t randomIndex() const;
+  template <class Random>
+  std::size_t randomIndex(Random *random) const;
+  Vec<Real, D> randomPoint() const;
+  template <class Random>
+  Vec<Real, D> randomPoint(Random *random) const;
+  void randomPoints(Vec<Real, D> *points, std::size_t size) const;
+  template <class Random>
+  void randomPoints(Vec<Real, D> *points, std::size_t size,
+                    Random *random) const;
+
+ private:
+  std::vector<Triangle<T, D>> triangles_;
+  std::vector<Real> areas_;
+  AliasTable table_;
+  Real area_ = 0;
+};
+
+using MeshSampler2f = MeshSampler2<float>;
+using MeshSampler2d = MeshSampler2<double>;
+using MeshSampler3f = MeshSampler3<float>;
+using MeshSampler3d = MeshSampler3<double>;
+
+// MARK: -
+
+template <class T, int D>
+inline MeshSampler<T, D>::MeshSampler(const Triangle<T, D> *triangles,
+                                      std::size_t size) {
+  build(triangles, size);
+}
+
+template <class T, int D>
+inline void MeshSampler<T, D>::build(const Triangle<T, D> *triangles,
+                                     std::size_t size) {
+  assert(triangles || !size);
+  triangles_.assign(triangles, triangles + size);
+  areas_.resize(size);
+  area_ = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    // Triangles in 2 dimensions have signed areas
+    areas_[i] = std::abs(triangles[i].area());
+    area_ += areas_[i];
+  }
+  table_.build(areas_.data(), areas_.size());
+}
+
+// MARK: Element access
+
+template <class T, int D>
+inline const Triangle<T, D>& MeshSampler<T, D>::at(std::size_t index) const {
+  assert(index < triangles_.size());
+  return triangles_[index];
+}
+
+template <class T, int D>
+inline const Triangle<T, D>& MeshSampler<T, D>::operator[](
+    std::size_t index) const {
+  return at(index);
+}
+
+// MARK: Sampling
+
+template <class T, int D>
+inline std::size_t MeshSampler<T, D>::randomIndex() const {
+  return randomIndex(&Random<>::local());
+}
+
+template <class T, int D>
+template <class Random>
+inline std::size_t MeshSampler<T, D>::randomIndex(Random *random) const {
+  assert(random);
+  assert(!empty());
+  return random->discrete(table_);
+}
+
+template <class T, int D>
+inline Vec<Promote<T>, D> MeshSampler<T, D>::randomPoint() const {
+  return randomPoint(&Random<>::local());
+}
+
+template <class T, int D>
+template <class Random>
+inline Vec<Promote<T>, D> MeshSampler<T, D>::randomPoint(
+    Random *random) const {
+  return triangles_[randomIndex(random)].randomPoint(random);
+}
+
+template <class T, int D>
+inline void MeshSampler<T, D>::randomPoints(Vec<Real, D> *points,
+                                            std::size_t size) const {
+  randomPoints(points, size, &Random<>::local());
+}
+
+template <class T, int D>
+template <class Random>
+inline void MeshSampler<T, D>::randomPoints(Vec<Real, D> *points,
+                                            std::size_t size,
+                                            Random *random) const {
+  assert(points || !size);
+  assert(random);
+  assert(!empty());
+  std::size_t indices[detail::kRandomBlock];
+  Real uniforms[detail::kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    random->fillDiscrete(table_, indices, count);
+    random->fillUniform(uniforms, count * 2, Real(0), Real(1));
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& triangle = triangles_[indices[i]];
+      const auto reflect = uniforms[i] + uniforms[count + i] > 1;
+      const auto s = reflect ? 1 - uniforms[i] : uniforms[i];
+      const auto t = reflect ? 1 - uniforms[count + i] : uniforms[count + i];
+      for (int j = 0; j < D; ++j) {
+        points[first + i][j] = (triangle.a[j] +
+                                (triangle.b[j] - triangle.a[j]) * s +
+                                (triangle.c[j] - triangle.a[j]) * t);
+      }
+    }
+  }
+}
+
+}  // namespace math
+
+using math::MeshSampler;
+using math::MeshSampler2;
+using math::MeshSampler3;
+using math::MeshSampler2f;
+using math::MeshSampler2d;
+using math::MeshSampler3f;
+using math::MeshSampler3d;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_MESH_SAMPLER_H_
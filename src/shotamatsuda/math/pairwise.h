@@ -0,0 +1,222 @@
+//
+//  shotamatsuda/math/pairwise.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_PAIRWISE_H_
+#define SHOTAMATSUDA_MATH_PAIRWISE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Writes the squared distance between a[i] and b[j] to
+// result[i * bsize + j]. The points of b are transposed once into component
+// arrays, and blocks of rows are computed against tiles of them that stay in
+// the L1 cache, one component at a time so that the inner loops vectorize.
+// Rows are split across concurrency threads, where 0 means all hardware
+// threads.
+template <class T, int D>
+void distanceSquared(const Vec<T, D> *a, std::size_t asize,
+                     const Vec<T, D> *b, std::size_t bsize,
+                     Promote<T> *result, int concurrency = 1);
+
+// Finds the k points of b nearest to each a[i], and writes their indices and
+// squared distances in ascending order to indices[i * k] and
+// distances[i * k]. Ties are broken by the smaller index. Only k candidates
+// per row are kept in memory, so neither set size is limited by the size of
+// a dense matrix. Either output may be null when it is not needed.
+template <class T, int D>
+void nearest(const Vec<T, D> *a, std::size_t asize,
+             const Vec<T, D> *b, std::size_t bsize,
+             std::size_t k, std::size_t *indices, Promote<T> *distances,
+             int concurrency = 1);
+
+// MARK: -
+
+namespace detail {
+
+constexpr std::size_t kPairwiseTile = 256;
+constexpr std::size_t kPairwiseRows = 32;
+
+// Transposes values into D component arrays of stride elements each. The
+// stride is padded to a whole number of tiles, so that the distance loops
+// have a constant trip count and vectorize without runtime alias checks.
+template <class T, int D, class V>
+inline std::size_t transpose(const Vec<T, D> *values, std::size_t size,
+                             std::vector<V> *result) {
+  const auto stride = ((size + kPairwiseTile - 1) / kPairwiseTile *
+                       kPairwiseTile);
+  result->assign(D * stride, V());
+  for (std::size_t j = 0; j < size; ++j) {
+    for (int i = 0; i < D; ++i) {
+      (*result)[i * stride + j] = values[j][i];
+    }
+  }
+  return stride;
+}
+
+template <int D, class V, class T>
+inline void distanceSquared(const Vec<T, D>& point, const V *components,
+                            std::size_t stride, V *result) {
+  V coordinates[D];
+  for (int i = 0; i < D; ++i) {
+    coordinates[i] = point[i];
+  }
+  V row[kPairwiseTile];
+  for (std::size_t j = 0; j < kPairwiseTile; ++j) {
+    V sum = V();
+    for (int i = 0; i < D; ++i) {
+      const V difference = coordinates[i] - components[i * stride + j];
+      sum += difference * difference;
+    }
+    row[j] = sum;
+  }
+  std::copy(row, row + kPairwiseTile, result);
+}
+
+}  // namespace detail
+
+template <class T, int D>
+inline void distanceSquared(const Vec<T, D> *a, std::size_t asize,
+                            const Vec<T, D> *b, std::size_t bsize,
+                            Promote<T> *result, int concurrency) {
+  assert((a && result) || !asize);
+  assert(b || !bsize);
+  using V = Promote<T>;
+  std::vector<V> components;
+  const auto stride = detail::transpose(b, bsize, &components);
+  const int chunks = chunkCount(asize, concurrency, detail::kPairwiseRows);
+  parallelFor(asize, chunks, [&](std::size_t first, std::size_t last, int) {
+    V row[detail::kPairwiseTile];
+    // Blocks of rows keep the rows being written in the cache
+    for (auto block = first; block < last; block += detail::kPairwiseRows) {
+      const auto end = std::min(block + detail::kPairwiseRows, last);
+      for (std::size_t offset = 0; offset < bsize;
+           offset += detail::kPairwiseTile) {
+        const auto size = std::min(detail::kPairwiseTile, bsize - offset);
+        for (auto i = block; i < end; ++i) {
+          detail::distanceSquared<D>(a[i], components.data() + offset,
+                                     stride, row);
+          std::copy(row, row + size, result + i * bsize + offset);
+        }
+      }
+    }
+  });
+}
+
+template <class T, int D>
+inline void nearest(const Vec<T, D> *a, std::size_t asize,
+                    const Vec<T, D> *b, std::size_t bsize,
+                    std::size_t k, std::size_t *indices, Promote<T> *distances,
+                    int concurrency) {
+  assert(a || !asize);
+  assert(b || !bsize);
+  assert(k <= bsize);
+  if (!k) {
+    return;
+  }
+  using V = Promote<T>;
+  using Candidate = std::pair<V, std::size_t>;
+  std::vector<V> components;
+  const auto stride = detail::transpose(b, bsize, &components);
+  const int chunks = chunkCount(asize, concurrency, detail::kPairwiseRows);
+  parallelFor(asize, chunks, [&](std::size_t first, std::size_t last, int) {
+    V row[detail::kPairwiseTile];
+    // Max-heaps of the k nearest candidates found so far for each row
+    std::vector<Candidate> heaps(detail::kPairwiseRows * k);
+    std::size_t sizes[detail::kPairwiseRows];
+    for (auto block = first; block < last; block += detail::kPairwiseRows) {
+      const auto end = std::min(block + detail::kPairwiseRows, last);
+      std::fill(sizes, sizes + detail::kPairwiseRows, 0);
+      for (std::size_t offset = 0; offset < bsize;
+           offset += detail::kPairwiseTile) {
+        const auto size = std::min(detail::kPairwiseTile, bsize - offset);
+        for (auto i = block; i < end; ++i) {
+          detail::distanceSquared<D>(a[i], components.data() + offset,
+                                     stride, row);
+          const auto heap = heaps.begin() + (i - block) * k;
+          auto& count = sizes[i - block];
+          auto threshold = (count < k ?
+                            std::numeric_limits<V>::infinity() :
+                            heap->first);
+          // Most tiles hold no candidate once the heap is full, and this
+          // check vectorizes while the insertion below does not
+          int hits = 0;
+          for (std::size_t j = 0; j < size; ++j) {
+            hits += row[j] <= threshold;
+          }
+          if (!hits) {
+            continue;
+          }
+          for (std::size_t j = 0; j < size; ++j) {
+            if (row[j] > threshold) {
+              continue;
+            }
+            const Candidate candidate(row[j], offset + j);
+            if (count < k) {
+              heap[count++] = candidate;
+              std::push_heap(heap, heap + count);
+            } else if (candidate < *heap) {
+              std::pop_heap(heap, heap + k);
+              heap[k - 1] = candidate;
+              std::push_heap(heap, heap + k);
+            }
+            if (count == k) {
+              threshold = heap->first;
+            }
+          }
+        }
+      }
+      for (auto i = block; i < end; ++i) {
+        const auto heap = heaps.begin() + (i - block) * k;
+        std::sort_heap(heap, heap + k);
+        for (std::size_t j = 0; j < k; ++j) {
+          if (indices) {
+            indices[i * k + j] = heap[j].second;
+          }
+          if (distances) {
+            distances[i * k + j] = heap[j].first;
+          }
+        }
+      }
+    }
+  });
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_PAIRWISE_H_
@@ -0,0 +1,90 @@
+//
+//  shotamatsuda/math/parallel.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_PARALLEL_H_
+#define SHOTAMATSUDA_MATH_PARALLEL_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace shotamatsuda {
+namespace math {
+
+// Returns the number of hardware threads, or 1 when it is unknown.
+int hardwareConcurrency();
+
+// Returns the number of chunks that parallelFor() will split size elements
+// into, given at most concurrency threads and at least grain elements per
+// chunk. A concurrency of 0 means hardwareConcurrency().
+int chunkCount(std::size_t size, int concurrency, std::size_t grain);
+
+// Splits [0, size) into chunks contiguous ranges and calls
+// function(first, last, chunk) for each of them. The calling thread runs the
+// first chunk and waits for the others.
+template <class Function>
+void parallelFor(std::size_t size, int chunks, Function function);
+
+// MARK: -
+
+inline int hardwareConcurrency() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+inline int chunkCount(std::size_t size, int concurrency, std::size_t grain) {
+  assert(concurrency >= 0);
+  if (!concurrency) {
+    concurrency = hardwareConcurrency();
+  }
+  const auto chunks = size / std::max<std::size_t>(grain, 1);
+  return static_cast<int>(std::max<std::size_t>(
+      1, std::min<std::size_t>(chunks, concurrency)));
+}
+
+template <class Function>
+inline void parallelFor(std::size_t size, int chunks, Function function) {
+  assert(chunks > 0);
+  std::vector<std::thread> threads;
+  threads.reserve(chunks - 1);
+  for (int chunk = 1; chunk < chunks; ++chunk) {
+    threads.emplace_back(function,
+                         size * chunk / chunks,
+                         size * (chunk + 1) / chunks,
+                         chunk);
+  }
+  function(std::size_t(), size / chunks, 0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_PARALLEL_H_
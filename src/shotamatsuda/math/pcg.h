@@ -0,0 +1,181 @@
+//
+//  shotamatsuda/math/pcg.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_PCG_H_
+#define SHOTAMATSUDA_MATH_PCG_H_
+
+#include <cstdint>
+#include <limits>
+
+#include "shotamatsuda/math/hash.h"
+#include "shotamatsuda/math/uint128.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// PCG64 engine of O'Neill (pcg_engines::setseq_xsl_rr_128_64), a 128-bit
+// linear congruential generator with an xor-shift-low and random-rotation
+// output function. Each odd increment selects an independent stream, and
+// discard(), jump() and longJump() advance the state in logarithmic time by
+// any count, 2^64 and 2^96 outputs. Satisfies the requirements of a uniform
+// random bit generator and can be used as Random<Pcg64>.
+class Pcg64 final {
+ public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type default_seed = 0xcafef00dd15ea5e5;
+
+ public:
+  Pcg64() : Pcg64(default_seed) {}
+  explicit Pcg64(std::uint64_t seed, std::uint64_t stream = 0);
+
+  // Copy semantics
+  Pcg64(const Pcg64&) = default;
+  Pcg64& operator=(const Pcg64&) = default;
+
+  // Comparison
+  bool operator==(const Pcg64& other) const;
+  bool operator!=(const Pcg64& other) const;
+
+  // Generation
+  void seed(std::uint64_t seed = default_seed, std::uint64_t stream = 0);
+  result_type operator()();
+  void discard(unsigned long long count);
+
+  // Stream splitting
+  void jump();
+  void longJump();
+
+  // Limits
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+ private:
+  void step();
+  void advance(detail::UInt128 count);
+
+ private:
+  detail::UInt128 state_;
+  detail::UInt128 increment_;
+};
+
+// MARK: -
+
+namespace detail {
+
+constexpr UInt128 kPcg64Multiplier = {
+  0x2360ed051fc65da4, 0x4385df649fccf645
+};
+
+}  // namespace detail
+
+inline Pcg64::Pcg64(std::uint64_t seed, std::uint64_t stream) {
+  this->seed(seed, stream);
+}
+
+// MARK: Comparison
+
+inline bool Pcg64::operator==(const Pcg64& other) const {
+  return (state_.high == other.state_.high &&
+          state_.low == other.state_.low &&
+          increment_.high == other.increment_.high &&
+          increment_.low == other.increment_.low);
+}
+
+inline bool Pcg64::operator!=(const Pcg64& other) const {
+  return !(*this == other);
+}
+
+// MARK: Generation
+
+inline void Pcg64::seed(std::uint64_t seed, std::uint64_t stream) {
+  increment_ = {stream >> 63, stream << 1 | 1};
+  state_ = {0, 0};
+  step();
+  state_ = detail::add(state_, {0, seed});
+  step();
+}
+
+inline Pcg64::result_type Pcg64::operator()() {
+  step();
+  const auto rotation = static_cast<int>(state_.high >> 58);
+  const auto value = state_.high ^ state_.low;
+  return detail::rotateLeft(value, -rotation & 63);
+}
+
+inline void Pcg64::discard(unsigned long long count) {
+  advance({0, count});
+}
+
+inline void Pcg64::step() {
+  state_ = detail::add(detail::multiply(state_, detail::kPcg64Multiplier),
+                       increment_);
+}
+
+// MARK: Stream splitting
+
+inline void Pcg64::jump() {
+  advance({1, 0});
+}
+
+inline void Pcg64::longJump() {
+  advance({std::uint64_t(1) << 32, 0});
+}
+
+inline void Pcg64::advance(detail::UInt128 count) {
+  // Brown, "Random Number Generation with Arbitrary Strides"
+  detail::UInt128 multiplier = {0, 1};
+  detail::UInt128 increment = {0, 0};
+  auto current_multiplier = detail::kPcg64Multiplier;
+  auto current_increment = increment_;
+  while (count.high || count.low) {
+    if (count.low & 1) {
+      multiplier = detail::multiply(multiplier, current_multiplier);
+      increment = detail::add(
+          detail::multiply(increment, current_multiplier), current_increment);
+    }
+    current_increment = detail::multiply(
+        detail::add(current_multiplier, {0, 1}), current_increment);
+    current_multiplier = detail::multiply(current_multiplier,
+                                          current_multiplier);
+    count.low = count.low >> 1 | count.high << 63;
+    count.high >>= 1;
+  }
+  state_ = detail::add(detail::multiply(multiplier, state_), increment);
+}
+
+}  // namespace math
+
+using math::Pcg64;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_PCG_H_
@@ -0,0 +1,201 @@
+//
+//  shotamatsuda/math/philox.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_PHILOX_H_
+#define SHOTAMATSUDA_MATH_PHILOX_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace shotamatsuda {
+namespace math {
+
+// Counter-based Philox4x32-10 engine of Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3". Each output block is a bijection of a 128-bit
+// counter under a 64-bit key, so any position of any stream can be generated
+// directly from (seed, stream, position) without shared state. The key holds
+// the seed, and the upper and lower halves of the counter hold the stream and
+// the block index. Satisfies the requirements of a uniform random bit
+// generator and can be used as Random<Philox4x32>.
+class Philox4x32 final {
+ public:
+  using result_type = std::uint32_t;
+  using Counter = std::array<std::uint32_t, 4>;
+  using Key = std::array<std::uint32_t, 2>;
+
+  static constexpr result_type default_seed = 20111115;
+
+ public:
+  Philox4x32() : Philox4x32(default_seed) {}
+  explicit Philox4x32(std::uint64_t seed, std::uint64_t stream = 0);
+
+  // Copy semantics
+  Philox4x32(const Philox4x32&) = default;
+  Philox4x32& operator=(const Philox4x32&) = default;
+
+  // Comparison
+  bool operator==(const Philox4x32& other) const;
+  bool operator!=(const Philox4x32& other) const;
+
+  // Generation
+  void seed(std::uint64_t seed = default_seed, std::uint64_t stream = 0);
+  result_type operator()();
+  void discard(unsigned long long count);
+
+  // Addressing in units of 32-bit outputs
+  std::uint64_t stream() const;
+  std::uint64_t position() const;
+  void seek(std::uint64_t position);
+
+  // Moves to the same position of the next stream, which is 2^66 outputs
+  // ahead of the current position
+  void jump();
+
+  // Bijection of a single counter block
+  static Counter generate(Counter counter, Key key);
+
+  // Limits
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+ private:
+  std::uint64_t block() const;
+  void setBlock(std::uint64_t block);
+
+ private:
+  Key key_;
+  Counter counter_;
+  Counter output_;
+  int index_;
+};
+
+// MARK: -
+
+inline Philox4x32::Philox4x32(std::uint64_t seed, std::uint64_t stream) {
+  this->seed(seed, stream);
+}
+
+// MARK: Comparison
+
+inline bool Philox4x32::operator==(const Philox4x32& other) const {
+  return (key_ == other.key_ &&
+          counter_ == other.counter_ &&
+          index_ == other.index_);
+}
+
+inline bool Philox4x32::operator!=(const Philox4x32& other) const {
+  return !(*this == other);
+}
+
+// MARK: Generation
+
+inline void Philox4x32::seed(std::uint64_t seed, std::uint64_t stream) {
+  key_ = {{static_cast<std::uint32_t>(seed),
+           static_cast<std::uint32_t>(seed >> 32)}};
+  counter_[2] = static_cast<std::uint32_t>(stream);
+  counter_[3] = static_cast<std::uint32_t>(stream >> 32);
+  seek(0);
+}
+
+inline Philox4x32::result_type Philox4x32::operator()() {
+  if (index_ == 4) {
+    setBlock(block() + 1);
+  }
+  return output_[index_++];
+}
+
+inline void Philox4x32::discard(unsigned long long count) {
+  seek(position() + count);
+}
+
+// MARK: Addressing
+
+inline std::uint64_t Philox4x32::stream() const {
+  return counter_[2] | static_cast<std::uint64_t>(counter_[3]) << 32;
+}
+
+inline std::uint64_t Philox4x32::position() const {
+  return block() * 4 + index_;
+}
+
+inline void Philox4x32::seek(std::uint64_t position) {
+  setBlock(position / 4);
+  index_ = static_cast<int>(position % 4);
+}
+
+inline void Philox4x32::jump() {
+  const auto stream = this->stream() + 1;
+  const auto index = index_;
+  counter_[2] = static_cast<std::uint32_t>(stream);
+  counter_[3] = static_cast<std::uint32_t>(stream >> 32);
+  setBlock(block());
+  index_ = index;
+}
+
+inline std::uint64_t Philox4x32::block() const {
+  return counter_[0] | static_cast<std::uint64_t>(counter_[1]) << 32;
+}
+
+inline void Philox4x32::setBlock(std::uint64_t block) {
+  counter_[0] = static_cast<std::uint32_t>(block);
+  counter_[1] = static_cast<std::uint32_t>(block >> 32);
+  output_ = generate(counter_, key_);
+  index_ = 0;
+}
+
+inline Philox4x32::Counter Philox4x32::generate(Counter counter, Key key) {
+  const std::uint64_t multiplier0 = 0xd2511f53;
+  const std::uint64_t multiplier1 = 0xcd9e8d57;
+  for (int round = 0; round < 10; ++round) {
+    if (round) {
+      key[0] += 0x9e3779b9;
+      key[1] += 0xbb67ae85;
+    }
+    const auto product0 = multiplier0 * counter[0];
+    const auto product1 = multiplier1 * counter[2];
+    counter = {{
+      static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+      static_cast<std::uint32_t>(product1),
+      static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+      static_cast<std::uint32_t>(product0)
+    }};
+  }
+  return counter;
+}
+
+}  // namespace math
+
+using math::Philox4x32;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_PHILOX_H_
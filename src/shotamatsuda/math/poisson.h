@@ -0,0 +1,292 @@
+//
+//  shotamatsuda/math/poisson.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_POISSON_H_
+#define SHOTAMATSUDA_MATH_POISSON_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "shotamatsuda/math/circle.h"
+#include "shotamatsuda/math/constants.h"
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Poisson-disk sampling of Bridson, "Fast Poisson Disk Sampling in Arbitrary
+// Dimensions", which returns points of the domain no closer to each other
+// than the distance in O(n) time using a background grid whose cells hold at
+// most one point. Each candidate makes the given number of attempts, and so
+// does each empty cell of the domain that no point covers yet, which keeps
+// narrow parts of the domain from being left out.
+//
+// The grid is split into tiles that are sampled in four phases, such that
+// tiles of the same phase never touch and can run in parallel. Every tile
+// draws from its own engine seeded by the caller's random, so the result
+// depends only on the random state and not on the concurrency. A concurrency
+// of 0 uses all hardware threads.
+template <class T, class Random>
+std::vector<Vec2<T>> poissonDisk(const Rect2<T>& domain, T distance,
+                                 Random *random, int attempts = 30,
+                                 int concurrency = 1);
+template <class T, class Random>
+std::vector<Vec2<T>> poissonDisk(const Circle2<T>& domain, T distance,
+                                 Random *random, int attempts = 30,
+                                 int concurrency = 1);
+
+// MARK: -
+
+namespace detail {
+
+constexpr std::size_t kPoissonTile = 64;
+
+template <class T>
+struct PoissonGrid {
+  Vec2<T> origin;
+  T cell;
+  std::size_t columns;
+  std::size_t rows;
+  std::vector<Vec2<T>> points;
+  std::vector<unsigned char> occupied;
+};
+
+template <class T, class Random, class Contains, class Overlaps>
+inline void poissonDiskTile(PoissonGrid<T> *grid,
+                            std::size_t column, std::size_t row,
+                            T distance, Random *random, int attempts,
+                            Contains contains, Overlaps overlaps,
+                            std::vector<Vec2<T>> *result) {
+  const auto first_column = column * kPoissonTile;
+  const auto first_row = row * kPoissonTile;
+  const auto last_column = std::min(first_column + kPoissonTile,
+                                    grid->columns);
+  const auto last_row = std::min(first_row + kPoissonTile, grid->rows);
+  const auto squared_distance = distance * distance;
+  std::vector<Vec2<T>> active;
+
+  const auto accept = [&](const Vec2<T>& point) {
+    if (!contains(point)) {
+      return false;
+    }
+    const auto x = std::floor((point.x - grid->origin.x) / grid->cell);
+    const auto y = std::floor((point.y - grid->origin.y) / grid->cell);
+    if (x < first_column || x >= last_column ||
+        y < first_row || y >= last_row) {
+      return false;
+    }
+    const auto cx = static_cast<std::size_t>(x);
+    const auto cy = static_cast<std::size_t>(y);
+    // A point within the distance lies at most two cells away
+    const auto nx = std::min(cx + 3, grid->columns);
+    const auto ny = std::min(cy + 3, grid->rows);
+    for (auto j = cy < 2 ? 0 : cy - 2; j < ny; ++j) {
+      for (auto i = cx < 2 ? 0 : cx - 2; i < nx; ++i) {
+        const auto index = j * grid->columns + i;
+        if (grid->occupied[index] &&
+            grid->points[index].distanceSquared(point) < squared_distance) {
+          return false;
+        }
+      }
+    }
+    const auto index = cy * grid->columns + cx;
+    grid->points[index] = point;
+    grid->occupied[index] = true;
+    result->emplace_back(point);
+    active.emplace_back(point);
+    return true;
+  };
+
+  // A cell counts as covered when its corners and center each lie within the
+  // distance of some point. What may remain is too small to leave a gap.
+  const auto covered = [&](std::size_t cx, std::size_t cy,
+                           const Vec2<T>& min, const Vec2<T>& max) {
+    const Vec2<T> probes[] = {
+      min, max, Vec2<T>(min.x, max.y), Vec2<T>(max.x, min.y),
+      Vec2<T>((min.x + max.x) / 2, (min.y + max.y) / 2),
+    };
+    const auto nx = std::min(cx + 3, grid->columns);
+    const auto ny = std::min(cy + 3, grid->rows);
+    unsigned mask = 0;
+    for (auto j = cy < 2 ? 0 : cy - 2; j < ny; ++j) {
+      for (auto i = cx < 2 ? 0 : cx - 2; i < nx; ++i) {
+        const auto index = j * grid->columns + i;
+        if (!grid->occupied[index]) {
+          continue;
+        }
+        for (unsigned k = 0; k < 5; ++k) {
+          if (grid->points[index].distanceSquared(probes[k]) <
+              squared_distance) {
+            mask |= 1u << k;
+          }
+        }
+        if (mask == 0x1f) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  // Seeds are drawn inside every empty cell that overlaps the domain and is
+  // not covered yet, which reaches the regions the active points cannot,
+  // such as thin slivers of the domain and the parts cut off by earlier tiles
+  for (auto cy = first_row; cy < last_row; ++cy) {
+    for (auto cx = first_column; cx < last_column; ++cx) {
+      if (grid->occupied[cy * grid->columns + cx]) {
+        continue;
+      }
+      const Vec2<T> min(grid->origin.x + cx * grid->cell,
+                        grid->origin.y + cy * grid->cell);
+      const Vec2<T> max(min.x + grid->cell, min.y + grid->cell);
+      if (!overlaps(min, max) || covered(cx, cy, min, max)) {
+        continue;
+      }
+      for (int attempt = 0; attempt < attempts; ++attempt) {
+        if (accept(Vec2<T>(random->template uniform<T>(min.x, max.x),
+                           random->template uniform<T>(min.y, max.y)))) {
+          break;
+        }
+      }
+      while (!active.empty()) {
+        const auto index = random->template uniform<std::size_t>(
+            0, active.size() - 1);
+        const auto center = active[index];
+        bool found = false;
+        for (int attempt = 0; attempt < attempts && !found; ++attempt) {
+          const auto angle = random->template uniform<T>(0, two_pi<T>());
+          const auto radius = random->template uniform<T>(
+              distance, 2 * distance);
+          found = accept(Vec2<T>(center.x + radius * std::cos(angle),
+                                 center.y + radius * std::sin(angle)));
+        }
+        if (!found) {
+          active[index] = active.back();
+          active.pop_back();
+        }
+      }
+    }
+  }
+}
+
+template <class T, class Random, class Contains, class Overlaps>
+inline std::vector<Vec2<T>> poissonDisk(const Rect2<T>& bounds, T distance,
+                                        Random *random, int attempts,
+                                        int concurrency, Contains contains,
+                                        Overlaps overlaps) {
+  static_assert(std::is_floating_point<T>::value,
+                "Poisson-disk sampling requires floating-point coordinates");
+  assert(distance > 0);
+  assert(random);
+  assert(attempts > 0);
+  PoissonGrid<T> grid;
+  grid.origin = bounds.min();
+  // Cells whose diagonal is the distance hold at most one point
+  grid.cell = distance / std::sqrt(static_cast<T>(2));
+  grid.columns = static_cast<std::size_t>(
+      (bounds.maxX() - bounds.minX()) / grid.cell) + 1;
+  grid.rows = static_cast<std::size_t>(
+      (bounds.maxY() - bounds.minY()) / grid.cell) + 1;
+  grid.points.resize(grid.columns * grid.rows);
+  grid.occupied.resize(grid.columns * grid.rows);
+
+  const auto tile_columns = (grid.columns + kPoissonTile - 1) / kPoissonTile;
+  const auto tile_rows = (grid.rows + kPoissonTile - 1) / kPoissonTile;
+  const auto tiles = tile_columns * tile_rows;
+  std::vector<typename Random::Type> seeds(tiles);
+  for (auto& seed : seeds) {
+    seed = random->next();
+  }
+  std::vector<std::vector<Vec2<T>>> results(tiles);
+  for (int phase = 0; phase < 4; ++phase) {
+    std::vector<std::size_t> indices;
+    for (std::size_t row = phase / 2; row < tile_rows; row += 2) {
+      for (std::size_t column = phase % 2; column < tile_columns;
+           column += 2) {
+        indices.emplace_back(row * tile_columns + column);
+      }
+    }
+    const int chunks = chunkCount(indices.size(), concurrency, 1);
+    parallelFor(indices.size(), chunks, [&](std::size_t first,
+                                            std::size_t last,
+                                            int) {
+      for (auto i = first; i < last; ++i) {
+        const auto tile = indices[i];
+        Random tile_random(seeds[tile]);
+        poissonDiskTile(&grid, tile % tile_columns, tile / tile_columns,
+                        distance, &tile_random, attempts, contains, overlaps,
+                        &results[tile]);
+      }
+    });
+  }
+  std::vector<Vec2<T>> result;
+  for (const auto& points : results) {
+    result.insert(result.end(), points.begin(), points.end());
+  }
+  return result;
+}
+
+}  // namespace detail
+
+template <class T, class Random>
+inline std::vector<Vec2<T>> poissonDisk(const Rect2<T>& domain, T distance,
+                                        Random *random, int attempts,
+                                        int concurrency) {
+  return detail::poissonDisk(
+      domain, distance, random, attempts, concurrency,
+      [&domain](const Vec2<T>& point) { return domain.contains(point); },
+      [](const Vec2<T>& min, const Vec2<T>& max) { return true; });
+}
+
+template <class T, class Random>
+inline std::vector<Vec2<T>> poissonDisk(const Circle2<T>& domain, T distance,
+                                        Random *random, int attempts,
+                                        int concurrency) {
+  const Rect2<T> bounds(domain.x - domain.radius, domain.y - domain.radius,
+                        2 * domain.radius, 2 * domain.radius);
+  return detail::poissonDisk(
+      bounds, distance, random, attempts, concurrency,
+      [&domain](const Vec2<T>& point) { return domain.contains(point); },
+      [&domain](const Vec2<T>& min, const Vec2<T>& max) {
+        // Nearest point of the cell to the center
+        const Vec2<T> nearest(std::min(std::max(domain.x, min.x), max.x),
+                              std::min(std::max(domain.y, min.y), max.y));
+        return (nearest.distanceSquared(domain.center) <=
+                domain.radius * domain.radius);
+      });
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_POISSON_H_
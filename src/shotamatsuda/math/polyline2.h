@@ -0,0 +1,400 @@
+//
+//  shotamatsuda/math/polyline2.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_POLYLINE2_H_
+#define SHOTAMATSUDA_MATH_POLYLINE2_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T, int D>
+class Polyline;
+
+template <class T>
+using Polyline2 = Polyline<T, 2>;
+
+// A path through vertices stored contiguously. The distances of the vertices
+// along the path are computed when they are first needed and kept until the
+// vertices change, so that points and tangents at distances take O(log n)
+// time. Queries on a polyline whose distances are out of date update them,
+// and must not run concurrently unless length() has been called before.
+template <class T>
+class Polyline<T, 2> final {
+ public:
+  using Type = T;
+  using Real = Promote<T>;
+  using ConstIterator = typename std::vector<Vec2<T>>::const_iterator;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  static constexpr const auto dimensions = Vec2<T>::dimensions;
+
+ public:
+  Polyline() = default;
+  Polyline(const Vec2<T> *points, std::size_t size);
+  Polyline(std::initializer_list<Vec2<T>> list);
+  explicit Polyline(std::vector<Vec2<T>> points);
+
+  // Copy semantics
+  Polyline(const Polyline&) = default;
+  Polyline& operator=(const Polyline&) = default;
+
+  // Move semantics
+  Polyline(Polyline&&) = default;
+  Polyline& operator=(Polyline&&) = default;
+
+  // Mutators
+  void set(const Vec2<T> *points, std::size_t size);
+  void set(std::initializer_list<Vec2<T>> list);
+  void set(std::size_t index, const Vec2<T>& point);
+  void push_back(const Vec2<T>& point);
+  void pop_back();
+  void reserve(std::size_t size);
+  void reset();
+
+  // Element access
+  const Vec2<T>& operator[](std::size_t index) const { return at(index); }
+  const Vec2<T>& at(std::size_t index) const;
+  const Vec2<T>& front() const { return at(0); }
+  const Vec2<T>& back() const { return at(points_.size() - 1); }
+  Line2<T> segment(std::size_t index) const;
+
+  // Attributes
+  bool empty() const { return points_.empty(); }
+  std::size_t size() const { return points_.size(); }
+
+  // Length
+  Real length() const;
+  Real distance(std::size_t index) const;
+
+  // Parameterization by the distance along the path, which is clamped to
+  // its length. The segment is the one whose start is at the index, and
+  // segments of zero length are skipped.
+  std::size_t segmentAt(Real distance) const;
+  Vec2<Real> pointAt(Real distance) const;
+  Vec2<Real> tangentAt(Real distance) const;
+
+  // Resampling to the number of points at even distances along the path,
+  // including both ends. Walks the segments once in O(n + size) time.
+  Polyline<Real, 2> resample(std::size_t size) const;
+  void resample(Vec2<Real> *points, std::size_t size) const;
+
+  // Iterator
+  ConstIterator begin() const { return points_.begin(); }
+  ConstIterator end() const { return points_.end(); }
+  ConstReverseIterator rbegin() const { return ConstReverseIterator(end()); }
+  ConstReverseIterator rend() const { return ConstReverseIterator(begin()); }
+
+  // Pointer
+  const Vec2<T> * data() const { return points_.data(); }
+
+ private:
+  void update() const;
+  Vec2<Real> interpolate(std::size_t segment, Real distance) const;
+
+ private:
+  std::vector<Vec2<T>> points_;
+
+  // The distances of the leading vertices that are up to date
+  mutable std::vector<Real> distances_;
+};
+
+// Comparison
+template <class T, class U>
+bool operator==(const Polyline2<T>& lhs, const Polyline2<U>& rhs);
+template <class T, class U>
+bool operator!=(const Polyline2<T>& lhs, const Polyline2<U>& rhs);
+
+// Resamples each of the polylines to the number of points per polyline, and
+// writes them to the points in the order of the polylines. The polylines are
+// divided among at most concurrency threads, where 0 means all of the
+// hardware threads, and must be distinct objects.
+template <class T>
+void resamplePolylines(const Polyline2<T> *polylines, std::size_t count,
+                       std::size_t size, Vec2<Promote<T>> *points,
+                       int concurrency = 1);
+
+using Polyline2f = Polyline2<float>;
+using Polyline2d = Polyline2<double>;
+
+// MARK: -
+
+template <class T>
+inline Polyline<T, 2>::Polyline(const Vec2<T> *points, std::size_t size) {
+  set(points, size);
+}
+
+template <class T>
+inline Polyline<T, 2>::Polyline(std::initializer_list<Vec2<T>> list)
+    : points_(list) {}
+
+template <class T>
+inline Polyline<T, 2>::Polyline(std::vector<Vec2<T>> points)
+    : points_(std::move(points)) {}
+
+// MARK: Mutators
+
+template <class T>
+inline void Polyline<T, 2>::set(const Vec2<T> *points, std::size_t size) {
+  assert(points || !size);
+  points_.assign(points, points + size);
+  distances_.clear();
+}
+
+template <class T>
+inline void Polyline<T, 2>::set(std::initializer_list<Vec2<T>> list) {
+  points_.assign(list);
+  distances_.clear();
+}
+
+template <class T>
+inline void Polyline<T, 2>::set(std::size_t index, const Vec2<T>& point) {
+  assert(index < points_.size());
+  points_[index] = point;
+  // Only the distances from the vertex on change
+  distances_.resize(std::min(distances_.size(), index));
+}
+
+template <class T>
+inline void Polyline<T, 2>::push_back(const Vec2<T>& point) {
+  points_.push_back(point);
+}
+
+template <class T>
+inline void Polyline<T, 2>::pop_back() {
+  assert(!points_.empty());
+  points_.pop_back();
+  distances_.resize(std::min(distances_.size(), points_.size()));
+}
+
+template <class T>
+inline void Polyline<T, 2>::reserve(std::size_t size) {
+  points_.reserve(size);
+}
+
+template <class T>
+inline void Polyline<T, 2>::reset() {
+  points_.clear();
+  distances_.clear();
+}
+
+// MARK: Element access
+
+template <class T>
+inline const Vec2<T>& Polyline<T, 2>::at(std::size_t index) const {
+  assert(index < points_.size());
+  return points_[index];
+}
+
+template <class T>
+inline Line2<T> Polyline<T, 2>::segment(std::size_t index) const {
+  assert(index + 1 < points_.size());
+  return Line2<T>(points_[index], points_[index + 1]);
+}
+
+// MARK: Length
+
+template <class T>
+inline void Polyline<T, 2>::update() const {
+  auto index = distances_.size();
+  if (index == points_.size()) {
+    return;
+  }
+  distances_.resize(points_.size());
+  if (!index) {
+    distances_[index++] = Real();
+  }
+  for (; index < points_.size(); ++index) {
+    distances_[index] = (distances_[index - 1] +
+                         points_[index - 1].distance(points_[index]));
+  }
+}
+
+template <class T>
+inline Promote<T> Polyline<T, 2>::length() const {
+  if (points_.empty()) {
+    return Real();
+  }
+  update();
+  return distances_.back();
+}
+
+template <class T>
+inline Promote<T> Polyline<T, 2>::distance(std::size_t index) const {
+  assert(index < points_.size());
+  update();
+  return distances_[index];
+}
+
+// MARK: Parameterization
+
+template <class T>
+inline std::size_t Polyline<T, 2>::segmentAt(Real distance) const {
+  assert(points_.size() > 1);
+  update();
+  const auto begin = distances_.begin() + 1;
+  const auto end = distances_.end();
+  auto vertex = std::upper_bound(begin, end, std::max(distance, Real()));
+  if (vertex == end) {
+    // The first vertex at the end, before any segments of zero length
+    vertex = std::lower_bound(begin, end, distances_.back());
+  }
+  return std::distance(begin, vertex);
+}
+
+template <class T>
+inline Vec2<Promote<T>> Polyline<T, 2>::interpolate(std::size_t segment,
+                                                    Real distance) const {
+  const auto& start = points_[segment];
+  const auto& end = points_[segment + 1];
+  const auto length = distances_[segment + 1] - distances_[segment];
+  if (!(length > 0)) {
+    return start;
+  }
+  const auto t = std::min(std::max(
+      (distance - distances_[segment]) / length, Real()), Real(1));
+  return Vec2<Real>(start) + (Vec2<Real>(end) - Vec2<Real>(start)) * t;
+}
+
+template <class T>
+inline Vec2<Promote<T>> Polyline<T, 2>::pointAt(Real distance) const {
+  assert(!points_.empty());
+  if (points_.size() == 1) {
+    return points_.front();
+  }
+  return interpolate(segmentAt(distance), distance);
+}
+
+template <class T>
+inline Vec2<Promote<T>> Polyline<T, 2>::tangentAt(Real distance) const {
+  assert(!points_.empty());
+  if (points_.size() == 1 || !(length() > 0)) {
+    return Vec2<Real>();
+  }
+  return segment(segmentAt(distance)).direction();
+}
+
+// MARK: Resampling
+
+template <class T>
+inline Polyline<Promote<T>, 2> Polyline<T, 2>::resample(
+    std::size_t size) const {
+  std::vector<Vec2<Real>> points(size);
+  resample(points.data(), size);
+  return Polyline<Real, 2>(std::move(points));
+}
+
+template <class T>
+inline void Polyline<T, 2>::resample(Vec2<Real> *points,
+                                     std::size_t size) const {
+  assert(points || !size);
+  if (!size) {
+    return;
+  }
+  assert(!points_.empty());
+  if (size == 1 || points_.size() == 1) {
+    std::fill(points, points + size, Vec2<Real>(points_.front()));
+    return;
+  }
+  const auto length = this->length();
+  const auto last = points_.size() - 1;
+  // Starts at the segment that segmentAt() would find for the first point,
+  // and advances as segmentAt() would for the later ones
+  auto segment = segmentAt(Real());
+  for (std::size_t i = 0; i < size - 1; ++i) {
+    const auto distance = length * i / (size - 1);
+    while (segment + 1 < last && !(distances_[segment + 1] > distance)) {
+      ++segment;
+    }
+    points[i] = interpolate(segment, distance);
+  }
+  points[size - 1] = points_.back();
+}
+
+template <class T>
+inline void resamplePolylines(const Polyline2<T> *polylines,
+                              std::size_t count, std::size_t size,
+                              Vec2<Promote<T>> *points, int concurrency) {
+  assert(polylines || !count);
+  assert(points || !count || !size);
+  // Polylines take time in proportion to their vertices, which are unknown
+  // here, so the grain is a number of polylines that amortizes threads
+  const int chunks = chunkCount(count, concurrency, 64);
+  parallelFor(count, chunks, [&](std::size_t first, std::size_t last, int) {
+    for (auto index = first; index < last; ++index) {
+      polylines[index].resample(points + index * size, size);
+    }
+  });
+}
+
+// MARK: Comparison
+
+template <class T, class U>
+inline bool operator==(const Polyline2<T>& lhs, const Polyline2<U>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class U>
+inline bool operator!=(const Polyline2<T>& lhs, const Polyline2<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+// MARK: Stream
+
+template <class T>
+inline std::ostream& operator<<(std::ostream& os,
+                                const Polyline2<T>& polyline) {
+  os << "(";
+  for (auto point = polyline.begin(); point != polyline.end(); ++point) {
+    os << (point == polyline.begin() ? " " : ", ") << *point;
+  }
+  return os << " )";
+}
+
+}  // namespace math
+
+using math::Polyline;
+using math::Polyline2;
+using math::Polyline2f;
+using math::Polyline2d;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_POLYLINE2_H_
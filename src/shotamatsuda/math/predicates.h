@@ -0,0 +1,436 @@
+//
+//  shotamatsuda/math/predicates.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_PREDICATES_H_
+#define SHOTAMATSUDA_MATH_PREDICATES_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "shotamatsuda/math/side.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Geometric predicates after Shewchuk's "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates". The determinants are
+// evaluated in double, and their signs are exact for coordinates that
+// double represents exactly, which includes float and integers up to 2^53.
+// The returned values approximate the determinants.
+
+// Returns a positive value when the points are in counterclockwise order in
+// y-up coordinates, negative when clockwise and zero when collinear. This is
+// the cross product of b - a and c - a.
+template <class T>
+double orient2d(const Vec2<T>& a, const Vec2<T>& b, const Vec2<T>& c);
+
+// Returns a positive value when d lies below the plane through a, b and c,
+// which appear counterclockwise seen from above it, negative when above and
+// zero when coplanar.
+template <class T>
+double orient3d(const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c,
+                const Vec3<T>& d);
+
+// Returns a positive value when d lies inside the circle through a, b and c
+// in counterclockwise order, negative when outside and zero when cocircular.
+// The sign is reversed when a, b and c are in clockwise order.
+template <class T>
+double incircle(const Vec2<T>& a, const Vec2<T>& b, const Vec2<T>& c,
+                const Vec2<T>& d);
+
+// Returns the side of the line through a and b that the point lies on, in
+// the same convention as Line2::side but exactly.
+template <class T>
+Side side(const Vec2<T>& a, const Vec2<T>& b, const Vec2<T>& point);
+
+// MARK: -
+
+namespace detail {
+
+// Half the distance between 1 and the next representable double
+constexpr double kPredicateEpsilon = std::numeric_limits<double>::epsilon() / 2;
+constexpr double kOrient2dErrorBound =
+    (3 + 16 * kPredicateEpsilon) * kPredicateEpsilon;
+constexpr double kOrient3dErrorBound =
+    (7 + 56 * kPredicateEpsilon) * kPredicateEpsilon;
+constexpr double kIncircleErrorBound =
+    (10 + 96 * kPredicateEpsilon) * kPredicateEpsilon;
+
+// Splits doubles into halves of 26 bits whose products are exact
+constexpr double kPredicateSplitter =
+    (1 << (std::numeric_limits<double>::digits + 1) / 2) + 1;
+
+// MARK: Error-free transformations
+
+inline void fastTwoSum(double a, double b, double *x, double *y) {
+  *x = a + b;
+  *y = b - (*x - a);
+}
+
+inline void twoSum(double a, double b, double *x, double *y) {
+  *x = a + b;
+  const auto b_virtual = *x - a;
+  const auto a_virtual = *x - b_virtual;
+  *y = (a - a_virtual) + (b - b_virtual);
+}
+
+inline void twoDiff(double a, double b, double *x, double *y) {
+  *x = a - b;
+  const auto b_virtual = a - *x;
+  const auto a_virtual = *x + b_virtual;
+  *y = (a - a_virtual) + (b_virtual - b);
+}
+
+inline void split(double a, double *high, double *low) {
+  const auto c = kPredicateSplitter * a;
+  *high = c - (c - a);
+  *low = a - *high;
+}
+
+inline void twoProduct(double a, double b, double b_high, double b_low,
+                       double *x, double *y) {
+  *x = a * b;
+  double a_high, a_low;
+  split(a, &a_high, &a_low);
+  const auto error = ((*x - a_high * b_high) - a_low * b_high -
+                      a_high * b_low);
+  *y = a_low * b_low - error;
+}
+
+// MARK: Expansions
+
+// Sums nonoverlapping expansions in increasing order of magnitude, and
+// returns the size of the result without zero components, which is at least
+// one.
+inline std::size_t sumExpansions(const double *e, std::size_t e_size,
+                                 const double *f, std::size_t f_size,
+                                 double *h) {
+  std::size_t e_index = 0;
+  std::size_t f_index = 0;
+  const auto next = [&]() {
+    if (f_index == f_size ||
+        (e_index < e_size && (f[f_index] > e[e_index]) ==
+                             (f[f_index] > -e[e_index]))) {
+      return e[e_index++];
+    }
+    return f[f_index++];
+  };
+  std::size_t h_size = 0;
+  auto q = next();
+  double sum, error;
+  if (e_index < e_size && f_index < f_size) {
+    fastTwoSum(next(), q, &sum, &error);
+    q = sum;
+    if (error) {
+      h[h_size++] = error;
+    }
+  }
+  while (e_index < e_size || f_index < f_size) {
+    twoSum(q, next(), &sum, &error);
+    q = sum;
+    if (error) {
+      h[h_size++] = error;
+    }
+  }
+  if (q || !h_size) {
+    h[h_size++] = q;
+  }
+  return h_size;
+}
+
+inline std::size_t scaleExpansion(const double *e, std::size_t size,
+                                  double b, double *h) {
+  double b_high, b_low;
+  split(b, &b_high, &b_low);
+  std::size_t h_size = 0;
+  double q, error;
+  twoProduct(e[0], b, b_high, b_low, &q, &error);
+  if (error) {
+    h[h_size++] = error;
+  }
+  for (std::size_t i = 1; i < size; ++i) {
+    double product, product_error, sum;
+    twoProduct(e[i], b, b_high, b_low, &product, &product_error);
+    twoSum(q, product_error, &sum, &error);
+    if (error) {
+      h[h_size++] = error;
+    }
+    fastTwoSum(product, sum, &q, &error);
+    if (error) {
+      h[h_size++] = error;
+    }
+  }
+  if (q || !h_size) {
+    h[h_size++] = q;
+  }
+  return h_size;
+}
+
+// Holds up to the given number of components, which limits the operations
+// on it statically
+template <std::size_t N>
+struct Expansion {
+  // The largest component has the sign of the expansion
+  double estimate() const { return components[size - 1]; }
+
+  double components[N];
+  std::size_t size;
+};
+
+inline Expansion<2> difference(double a, double b) {
+  Expansion<2> result;
+  double error;
+  twoDiff(a, b, &result.components[1], &error);
+  if (error) {
+    result.components[0] = error;
+    result.size = 2;
+  } else {
+    result.components[0] = result.components[1];
+    result.size = 1;
+  }
+  return result;
+}
+
+template <std::size_t N>
+inline Expansion<N> operator-(const Expansion<N>& e) {
+  Expansion<N> result;
+  std::transform(e.components, e.components + e.size, result.components,
+                 [](double component) { return -component; });
+  result.size = e.size;
+  return result;
+}
+
+template <std::size_t N, std::size_t M>
+inline Expansion<N + M> operator+(const Expansion<N>& e,
+                                  const Expansion<M>& f) {
+  Expansion<N + M> result;
+  result.size = sumExpansions(e.components, e.size,
+                              f.components, f.size, result.components);
+  return result;
+}
+
+template <std::size_t N, std::size_t M>
+inline Expansion<N + M> operator-(const Expansion<N>& e,
+                                  const Expansion<M>& f) {
+  return e + -f;
+}
+
+template <std::size_t N, std::size_t M>
+inline Expansion<2 * N * M> operator*(const Expansion<N>& e,
+                                      const Expansion<M>& f) {
+  Expansion<2 * N * M> result;
+  double buffer[2 * N * M];
+  double term[2 * N];
+  auto product = result.components;
+  auto other = buffer;
+  std::size_t size = scaleExpansion(e.components, e.size, f.components[0],
+                                    product);
+  for (std::size_t i = 1; i < f.size; ++i) {
+    const auto term_size = scaleExpansion(e.components, e.size,
+                                          f.components[i], term);
+    size = sumExpansions(product, size, term, term_size, other);
+    std::swap(product, other);
+  }
+  if (product != result.components) {
+    std::copy(product, product + size, result.components);
+  }
+  result.size = size;
+  return result;
+}
+
+// MARK: Exact evaluation
+
+inline double orient2dExact(double ax, double ay, double bx, double by,
+                            double cx, double cy) {
+  const auto acx = difference(ax, cx);
+  const auto acy = difference(ay, cy);
+  const auto bcx = difference(bx, cx);
+  const auto bcy = difference(by, cy);
+  return (acx * bcy - acy * bcx).estimate();
+}
+
+inline double orient3dExact(double ax, double ay, double az,
+                            double bx, double by, double bz,
+                            double cx, double cy, double cz,
+                            double dx, double dy, double dz) {
+  const auto adx = difference(ax, dx);
+  const auto ady = difference(ay, dy);
+  const auto adz = difference(az, dz);
+  const auto bdx = difference(bx, dx);
+  const auto bdy = difference(by, dy);
+  const auto bdz = difference(bz, dz);
+  const auto cdx = difference(cx, dx);
+  const auto cdy = difference(cy, dy);
+  const auto cdz = difference(cz, dz);
+  return ((adz * (bdx * cdy - cdx * bdy) +
+           bdz * (cdx * ady - adx * cdy)) +
+          cdz * (adx * bdy - bdx * ady)).estimate();
+}
+
+inline double incircleExact(double ax, double ay, double bx, double by,
+                            double cx, double cy, double dx, double dy) {
+  const auto adx = difference(ax, dx);
+  const auto ady = difference(ay, dy);
+  const auto bdx = difference(bx, dx);
+  const auto bdy = difference(by, dy);
+  const auto cdx = difference(cx, dx);
+  const auto cdy = difference(cy, dy);
+  return (((adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+           (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)) +
+          (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady)).estimate();
+}
+
+// MARK: Filtered evaluation
+
+// The determinants are first evaluated in floating point, and only when
+// their magnitudes fall within the error bounds are they evaluated again
+// in expansions, whose sizes adapt to the bits that the inputs need.
+inline double orient2d(double ax, double ay, double bx, double by,
+                       double cx, double cy) {
+  const auto left = (ax - cx) * (by - cy);
+  const auto right = (ay - cy) * (bx - cx);
+  const auto determinant = left - right;
+  // Products of opposite signs never cancel, and pass without branching on
+  // their signs
+  const auto bound = kOrient2dErrorBound * (std::abs(left) + std::abs(right));
+  if (std::abs(determinant) >= bound) {
+    return determinant;
+  }
+  return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+inline double orient3d(double ax, double ay, double az,
+                       double bx, double by, double bz,
+                       double cx, double cy, double cz,
+                       double dx, double dy, double dz) {
+  const auto adx = ax - dx;
+  const auto ady = ay - dy;
+  const auto adz = az - dz;
+  const auto bdx = bx - dx;
+  const auto bdy = by - dy;
+  const auto bdz = bz - dz;
+  const auto cdx = cx - dx;
+  const auto cdy = cy - dy;
+  const auto cdz = cz - dz;
+  const auto bdxcdy = bdx * cdy;
+  const auto cdxbdy = cdx * bdy;
+  const auto cdxady = cdx * ady;
+  const auto adxcdy = adx * cdy;
+  const auto adxbdy = adx * bdy;
+  const auto bdxady = bdx * ady;
+  const auto determinant = (adz * (bdxcdy - cdxbdy) +
+                            bdz * (cdxady - adxcdy) +
+                            cdz * (adxbdy - bdxady));
+  const auto permanent = ((std::abs(bdxcdy) + std::abs(cdxbdy)) *
+                              std::abs(adz) +
+                          (std::abs(cdxady) + std::abs(adxcdy)) *
+                              std::abs(bdz) +
+                          (std::abs(adxbdy) + std::abs(bdxady)) *
+                              std::abs(cdz));
+  if (std::abs(determinant) > kOrient3dErrorBound * permanent) {
+    return determinant;
+  }
+  return orient3dExact(ax, ay, az, bx, by, bz, cx, cy, cz, dx, dy, dz);
+}
+
+inline double incircle(double ax, double ay, double bx, double by,
+                       double cx, double cy, double dx, double dy) {
+  const auto adx = ax - dx;
+  const auto ady = ay - dy;
+  const auto bdx = bx - dx;
+  const auto bdy = by - dy;
+  const auto cdx = cx - dx;
+  const auto cdy = cy - dy;
+  const auto bdxcdy = bdx * cdy;
+  const auto cdxbdy = cdx * bdy;
+  const auto cdxady = cdx * ady;
+  const auto adxcdy = adx * cdy;
+  const auto adxbdy = adx * bdy;
+  const auto bdxady = bdx * ady;
+  const auto a_lift = adx * adx + ady * ady;
+  const auto b_lift = bdx * bdx + bdy * bdy;
+  const auto c_lift = cdx * cdx + cdy * cdy;
+  const auto determinant = (a_lift * (bdxcdy - cdxbdy) +
+                            b_lift * (cdxady - adxcdy) +
+                            c_lift * (adxbdy - bdxady));
+  const auto permanent = ((std::abs(bdxcdy) + std::abs(cdxbdy)) * a_lift +
+                          (std::abs(cdxady) + std::abs(adxcdy)) * b_lift +
+                          (std::abs(adxbdy) + std::abs(bdxady)) * c_lift);
+  if (std::abs(determinant) > kIncircleErrorBound * permanent) {
+    return determinant;
+  }
+  return incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+}  // namespace detail
+
+// MARK: Predicates
+
+template <class T>
+inline double orient2d(const Vec2<T>& a, const Vec2<T>& b,
+                       const Vec2<T>& c) {
+  static_assert(std::is_arithmetic<T>::value, "Type must be arithmetic");
+  return detail::orient2d(a.x, a.y, b.x, b.y, c.x, c.y);
+}
+
+template <class T>
+inline double orient3d(const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c,
+                       const Vec3<T>& d) {
+  static_assert(std::is_arithmetic<T>::value, "Type must be arithmetic");
+  return detail::orient3d(a.x, a.y, a.z, b.x, b.y, b.z,
+                          c.x, c.y, c.z, d.x, d.y, d.z);
+}
+
+template <class T>
+inline double incircle(const Vec2<T>& a, const Vec2<T>& b, const Vec2<T>& c,
+                       const Vec2<T>& d) {
+  static_assert(std::is_arithmetic<T>::value, "Type must be arithmetic");
+  return detail::incircle(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y);
+}
+
+template <class T>
+inline Side side(const Vec2<T>& a, const Vec2<T>& b, const Vec2<T>& point) {
+  const auto determinant = orient2d(a, b, point);
+  return (determinant < 0 ? Side::LEFT :
+          determinant > 0 ? Side::RIGHT : Side::COINCIDENT);
+}
+
+}  // namespace math
+
+using math::incircle;
+using math::orient2d;
+using math::orient3d;
+using math::side;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_PREDICATES_H_
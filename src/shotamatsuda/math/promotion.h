@@ -33,30 +33,51 @@
 namespace shotamatsuda {
 namespace math {
 
-template <class T>
+// Integral operands are promoted to the floating-point type of the policy.
+// Define SHOTAMATSUDA_MATH_PROMOTION_POLICY to FloatPromotion before including
+// any header to keep integer geometry in single precision. The setting changes
+// the return types of inline functions, so every translation unit of a
+// program must be compiled with the same value.
+struct DoublePromotion {
+  using Integral = double;
+};
+
+struct FloatPromotion {
+  using Integral = float;
+};
+
+#ifndef SHOTAMATSUDA_MATH_PROMOTION_POLICY
+#define SHOTAMATSUDA_MATH_PROMOTION_POLICY DoublePromotion
+#endif  // SHOTAMATSUDA_MATH_PROMOTION_POLICY
+
+using PromotionPolicy = SHOTAMATSUDA_MATH_PROMOTION_POLICY;
+
+// MARK: -
+
+template <class T, class Policy = PromotionPolicy>
 struct Promotion1 {
   using Type = typename std::conditional<
     std::is_integral<T>::value,
-    double, T
+    typename Policy::Integral, T
   >::type;
 };
 
-template <>
-struct Promotion1<float> { using Type = float; };
-template <>
-struct Promotion1<double> { using Type = double; };
-template <>
-struct Promotion1<long double> { using Type = long double; };
-template <>
-struct Promotion1<int> { using Type = double; };
+template <class Policy>
+struct Promotion1<float, Policy> { using Type = float; };
+template <class Policy>
+struct Promotion1<double, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion1<long double, Policy> { using Type = long double; };
+template <class Policy>
+struct Promotion1<int, Policy> { using Type = typename Policy::Integral; };
 
 // MARK: -
 
-template <class T, class U>
+template <class T, class U, class Policy = PromotionPolicy>
 struct Promotion2 {
  private:
-  using PromotedT = typename Promotion1<T>::Type;
-  using PromotedU = typename Promotion1<U>::Type;
+  using PromotedT = typename Promotion1<T, Policy>::Type;
+  using PromotedU = typename Promotion1<U, Policy>::Type;
 
  public:
   using Type = typename std::conditional<
@@ -80,38 +101,44 @@ struct Promotion2 {
   >::type;
 };
 
-template <>
-struct Promotion2<float, float> { using Type = float; };
-template <>
-struct Promotion2<double, double> { using Type = double; };
-template <>
-struct Promotion2<long double, long double> { using Type = long double; };
-template <>
-struct Promotion2<int, int> { using Type = double; };
-template <>
-struct Promotion2<int, float> { using Type = double; };
-template <>
-struct Promotion2<float, int> { using Type = double; };
-template <>
-struct Promotion2<int, double> { using Type = double; };
-template <>
-struct Promotion2<double, int> { using Type = double; };
-template <>
-struct Promotion2<int, long double> { using Type = long double; };
-template <>
-struct Promotion2<long double, int> { using Type = long double; };
-template <>
-struct Promotion2<float, double> { using Type = double; };
-template <>
-struct Promotion2<double, float> { using Type = double; };
-template <>
-struct Promotion2<float, long double> { using Type = long double; };
-template <>
-struct Promotion2<long double, float> { using Type = long double; };
-template <>
-struct Promotion2<double, long double> { using Type = long double; };
-template <>
-struct Promotion2<long double, double> { using Type = long double; };
+template <class Policy>
+struct Promotion2<float, float, Policy> { using Type = float; };
+template <class Policy>
+struct Promotion2<double, double, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion2<long double, long double, Policy> {
+  using Type = long double;
+};
+template <class Policy>
+struct Promotion2<float, double, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion2<double, float, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion2<float, long double, Policy> { using Type = long double; };
+template <class Policy>
+struct Promotion2<long double, float, Policy> { using Type = long double; };
+template <class Policy>
+struct Promotion2<double, long double, Policy> { using Type = long double; };
+template <class Policy>
+struct Promotion2<long double, double, Policy> { using Type = long double; };
+
+// Mixed integral operands follow the promoted type of int
+template <class Policy>
+struct Promotion2<int, int, Policy> : Promotion1<int, Policy> {};
+template <class Policy>
+struct Promotion2<int, float, Policy>
+    : Promotion2<typename Promotion1<int, Policy>::Type, float, Policy> {};
+template <class Policy>
+struct Promotion2<float, int, Policy>
+    : Promotion2<float, typename Promotion1<int, Policy>::Type, Policy> {};
+template <class Policy>
+struct Promotion2<int, double, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion2<double, int, Policy> { using Type = double; };
+template <class Policy>
+struct Promotion2<int, long double, Policy> { using Type = long double; };
+template <class Policy>
+struct Promotion2<long double, int, Policy> { using Type = long double; };
 
 // MARK: -
 
@@ -28,21 +28,45 @@
 #ifndef SHOTAMATSUDA_MATH_RANDOM_H_
 #define SHOTAMATSUDA_MATH_RANDOM_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <random>
-
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/math/alias_table.h"
+#include "shotamatsuda/math/constants.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/xoshiro.h"
+#include "shotamatsuda/math/ziggurat.h"
 
 namespace shotamatsuda {
 namespace math {
 
 using DefaultRandomEngine = std::mt19937;
 
+// Selects how gaussian and exponential values are sampled. STANDARD uses the
+// standard library distributions, or Box-Muller pairs and inversion in bulk.
+// ZIGGURAT uses the ziggurat method, which consumes 64 bits per sample and
+// avoids transcendental functions for about 99% of samples.
+enum class Sampling {
+  STANDARD,
+  ZIGGURAT
+};
+
 template <class Engine = DefaultRandomEngine>
 class Random final {
  public:
@@ -51,19 +75,53 @@ class Random final {
  public:
   Random();
   explicit Random(Type seed);
+  explicit Random(const Engine& engine);
 
   // Copy semantics
   Random(const Random&) = default;
   Random& operator=(const Random&) = default;
 
-  // Shared instance
+  // Shared instance, which is not safe to draw from concurrently. It is
+  // seeded from std::random_device, and random::seed() does not affect it;
+  // call seed() on it directly for reproducible results.
   static Random& shared();
 
+  // Thread-local instance. seedLocal(value, index) seeds the calling thread's
+  // instance from the value and an index the caller chooses, such as the
+  // index of a worker in a thread pool, which is deterministic regardless of
+  // scheduling. seedLocal(value) does the same with index 0 and also reseeds
+  // every other thread on its next access, including threads that accessed
+  // their instances before, with indices 1, 2, ... in the order of those
+  // accesses. That order is only deterministic when the threads are.
+  static Random& local();
+  static void seedLocal(Type value);
+  static void seedLocal(Type value, std::uint64_t index);
+
   // Random generation
   void seed(Type value);
   void randomize();
   Type next();
 
+  // Splitting into children seeded from hashed output of this instance, so
+  // that nested splits derive from different sequences. Streams are unlikely
+  // rather than guaranteed not to overlap, and how unlikely depends on the
+  // seeding of the engine. Engines with seed(seed, stream) such as Philox4x32
+  // and Pcg64 take a 64-bit key and a 64-bit stream, and engines with seed
+  // sequences fill their whole state. Other engines such as Xoshiro256 get a
+  // single 64-bit seed, so two of their children are likely to share a seed
+  // after about 2^32 splits.
+  Random split();
+  std::vector<Random> spawn(std::size_t count);
+
+  // Binary state behind a versioned header. Engines that are trivially
+  // copyable, which include all the engines of this library and of libstdc++
+  // and libc++, are copied as raw bytes and the others go through their text
+  // representation. loadState() returns false and leaves the state unchanged
+  // when the data was not saved from the same engine type and version.
+  std::vector<std::uint8_t> saveState() const;
+  void saveState(std::vector<std::uint8_t> *data) const;
+  bool loadState(const std::uint8_t *data, std::size_t size);
+
   // Random engine
   Engine& engine() { return engine_; }
   const Engine& engine() const { return engine_; }
@@ -76,23 +134,65 @@ class Random final {
   template <class T>
   T uniform(T min, T max);
   template <class T>
-  T gaussian();
+  T gaussian(Sampling sampling = Sampling::STANDARD);
+  template <class T>
+  T gaussian(Promote<T> mean, Promote<T> stddev,
+             Sampling sampling = Sampling::STANDARD);
+  template <class T>
+  T exponential(Promote<T> lambda = 1,
+                Sampling sampling = Sampling::STANDARD);
+
+  // Bulk distribution. Floating-point values are converted from whole blocks
+  // of engine output, and gaussian values are generated in Box-Muller pairs.
+  template <class T>
+  void fillUniform(T *values, std::size_t size, T min, T max);
   template <class T>
-  T gaussian(Promote<T> mean, Promote<T> stddev);
+  void fillGaussian(T *values, std::size_t size,
+                    Promote<T> mean = 0, Promote<T> stddev = 1,
+                    Sampling sampling = Sampling::STANDARD);
+  template <class T>
+  void fillExponential(T *values, std::size_t size, Promote<T> lambda = 1,
+                       Sampling sampling = Sampling::STANDARD);
+
+  // Discrete distribution, consuming 64 bits per index
+  std::size_t discrete(const AliasTable& table);
+  void fillDiscrete(const AliasTable& table, std::size_t *indices,
+                    std::size_t size);
 
  private:
+  struct Local;
+
   static void deleteShared();
+  static Local& localInstance();
+  static void reseedLocal(Local *local);
+  static Type localSeed(Type value, std::uint64_t index);
 
  private:
   Engine engine_;
   static std::atomic<Random *> shared_;
   static std::mutex shared_mutex_;
   static bool shared_deleted_;
+
+  // The seed, the next order-based index and the generation are only
+  // written together under local_mutex_. The generation is also read
+  // without the lock to detect that a thread-local instance is stale.
+  static std::mutex local_mutex_;
+  static Type local_seed_;
+  static std::uint64_t local_count_;
+  static std::atomic<std::uint64_t> local_generation_;
+};
+
+// Thread-local instance and the generation of seedLocal() it follows
+template <class Engine>
+struct Random<Engine>::Local {
+  Random random{Type()};
+  std::uint64_t generation{std::numeric_limits<std::uint64_t>::max()};
 };
 
 namespace random {
 
-// Random generation
+// Random generation. These draw from Random<Engine>::local(), so seed()
+// calls seedLocal() and leaves the shared instance as it is.
 template <class Engine = DefaultRandomEngine>
 void seed(typename Random<Engine>::Type value);
 template <class Engine = DefaultRandomEngine>
@@ -108,9 +208,30 @@ T uniform(T max);
 template <class T, class Engine = DefaultRandomEngine>
 T uniform(T min, T max);
 template <class T, class Engine = DefaultRandomEngine>
-T gaussian();
+T gaussian(Sampling sampling = Sampling::STANDARD);
+template <class T, class Engine = DefaultRandomEngine>
+T gaussian(Promote<T> mean, Promote<T> stddev,
+           Sampling sampling = Sampling::STANDARD);
+template <class T, class Engine = DefaultRandomEngine>
+T exponential(Promote<T> lambda = 1, Sampling sampling = Sampling::STANDARD);
+
+// Bulk distribution
+template <class T, class Engine = DefaultRandomEngine>
+void fillUniform(T *values, std::size_t size, T min, T max);
+template <class T, class Engine = DefaultRandomEngine>
+void fillGaussian(T *values, std::size_t size,
+                  Promote<T> mean = 0, Promote<T> stddev = 1,
+                  Sampling sampling = Sampling::STANDARD);
 template <class T, class Engine = DefaultRandomEngine>
-T gaussian(Promote<T> mean, Promote<T> stddev);
+void fillExponential(T *values, std::size_t size, Promote<T> lambda = 1,
+                     Sampling sampling = Sampling::STANDARD);
+
+// Discrete distribution
+template <class Engine = DefaultRandomEngine>
+std::size_t discrete(const AliasTable& table);
+template <class Engine = DefaultRandomEngine>
+void fillDiscrete(const AliasTable& table, std::size_t *indices,
+                  std::size_t size);
 
 }  // namespace random
 
@@ -120,15 +241,298 @@ template <class Engine>
 std::mutex Random<Engine>::shared_mutex_;
 template <class Engine>
 bool Random<Engine>::shared_deleted_;
+template <class Engine>
+std::mutex Random<Engine>::local_mutex_;
+template <class Engine>
+typename Random<Engine>::Type Random<Engine>::local_seed_;
+template <class Engine>
+std::uint64_t Random<Engine>::local_count_;
+template <class Engine>
+std::atomic<std::uint64_t> Random<Engine>::local_generation_;
 
 // MARK: -
 
+namespace detail {
+
+constexpr std::size_t kRandomBlock = 256;
+
+// Returns the number of random bits in each output of the engine, or 0 when
+// its range is not a whole 32- or 64-bit word.
+template <class Engine>
+constexpr int randomBits() {
+  return (Engine::min() != 0 ? 0 :
+          Engine::max() == 0xffffffff ? 32 :
+          Engine::max() == 0xffffffffffffffff ? 64 : 0);
+}
+
+template <class Engine>
+inline void fillWords(Engine *engine, std::uint32_t *words, std::size_t size) {
+  if (randomBits<Engine>() == 64) {
+    for (std::size_t i = 0; i + 1 < size; i += 2) {
+      const std::uint64_t word = (*engine)();
+      words[i] = static_cast<std::uint32_t>(word);
+      words[i + 1] = static_cast<std::uint32_t>(word >> 32);
+    }
+    if (size % 2) {
+      words[size - 1] = static_cast<std::uint32_t>((*engine)());
+    }
+  } else {
+    for (std::size_t i = 0; i < size; ++i) {
+      words[i] = static_cast<std::uint32_t>((*engine)());
+    }
+  }
+}
+
+template <class Engine>
+inline std::uint64_t randomWord(Engine *engine) {
+  if (randomBits<Engine>() == 64) {
+    return (*engine)();
+  }
+  if (randomBits<Engine>() == 32) {
+    const std::uint64_t high = (*engine)();
+    return high << 32 | static_cast<std::uint32_t>((*engine)());
+  }
+  return std::uniform_int_distribution<std::uint64_t>()(*engine);
+}
+
+template <class Engine, class = void>
+struct HasStreamSeed : std::false_type {};
+
+template <class Engine>
+struct HasStreamSeed<Engine, decltype(std::declval<Engine&>().seed(
+    std::uint64_t(), std::uint64_t()))> : std::true_type {};
+
+template <class Engine, class = void>
+struct HasSeedSequence : std::false_type {};
+
+template <class Engine>
+struct HasSeedSequence<Engine, decltype(std::declval<Engine&>().seed(
+    std::declval<std::seed_seq&>()))> : std::true_type {};
+
+// jump() is not used here because it partitions streams only one level deep;
+// a child's own jump would land on the stream its parent moved to.
+template <class Engine, class SeedSequence>
+inline Engine splitEngine(Engine *engine, std::true_type, SeedSequence) {
+  const auto seed = hash(randomWord(engine));
+  const auto stream = hash(randomWord(engine));
+  return Engine(seed, stream);
+}
+
+// Seed sequence that expands a 64-bit seed with SplitMix64, which fills the
+// state of large engines such as mt19937 several times faster than seed_seq
+class SplitMixSequence final {
+ public:
+  using result_type = std::uint32_t;
+
+ public:
+  explicit SplitMixSequence(std::uint64_t seed) : seed_(seed) {}
+
+  template <class Iterator>
+  void generate(Iterator first, Iterator last) const {
+    auto state = seed_;
+    for (; first != last; ++first) {
+      *first = static_cast<std::uint32_t>(splitMix64(&state) >> 32);
+    }
+  }
+
+ private:
+  std::uint64_t seed_;
+};
+
+template <class Engine>
+inline Engine splitEngine(Engine *engine, std::false_type, std::true_type) {
+  SplitMixSequence sequence(randomWord(engine));
+  return Engine(sequence);
+}
+
+template <class Engine>
+inline Engine splitEngine(Engine *engine, std::false_type, std::false_type) {
+  using Type = typename Engine::result_type;
+  return Engine(static_cast<Type>(hash(randomWord(engine))));
+}
+
+template <class Engine>
+inline Engine splitEngine(Engine *engine) {
+  return splitEngine(engine, HasStreamSeed<Engine>(),
+                     HasSeedSequence<Engine>());
+}
+
+constexpr std::uint32_t kRandomStateMagic = 0x53524d53;  // "SMRS"
+constexpr std::uint32_t kRandomStateVersion = 1;
+
+struct RandomStateHeader {
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint64_t engine;
+  std::uint64_t size;
+};
+
+// Identifies the engine type by its layout, its range and its first output
+// from the default seed, which is computed once per type
+template <class Engine>
+inline std::uint64_t engineSignature() {
+  static const std::uint64_t signature = hash(
+      sizeof(Engine), Engine::min(), Engine::max(), Engine()());
+  return signature;
+}
+
+template <class Engine>
+inline void saveEngine(const Engine& engine,
+                       std::vector<std::uint8_t> *data, std::true_type) {
+  const RandomStateHeader header = {
+    kRandomStateMagic,
+    kRandomStateVersion,
+    engineSignature<Engine>(),
+    sizeof(Engine)
+  };
+  data->resize(sizeof(header) + sizeof(Engine));
+  std::memcpy(data->data(), &header, sizeof(header));
+  std::memcpy(data->data() + sizeof(header), &engine, sizeof(Engine));
+}
+
+template <class Engine>
+inline void saveEngine(const Engine& engine,
+                       std::vector<std::uint8_t> *data, std::false_type) {
+  std::ostringstream stream;
+  stream << engine;
+  const auto text = stream.str();
+  const RandomStateHeader header = {
+    kRandomStateMagic,
+    kRandomStateVersion,
+    engineSignature<Engine>(),
+    text.size()
+  };
+  data->resize(sizeof(header) + text.size());
+  std::memcpy(data->data(), &header, sizeof(header));
+  std::memcpy(data->data() + sizeof(header), text.data(), text.size());
+}
+
+template <class Engine>
+inline bool loadEngine(Engine *engine, const std::uint8_t *data,
+                       std::size_t size, std::true_type) {
+  std::memcpy(engine, data, size);
+  return true;
+}
+
+template <class Engine>
+inline bool loadEngine(Engine *engine, const std::uint8_t *data,
+                       std::size_t size, std::false_type) {
+  std::istringstream stream(std::string(data, data + size));
+  Engine result;
+  if (!(stream >> result)) {
+    return false;
+  }
+  *engine = result;
+  return true;
+}
+
+template <class Engine>
+inline bool loadEngine(Engine *engine, const std::uint8_t *data,
+                       std::size_t size) {
+  using Trivial = std::is_trivially_copyable<Engine>;
+  RandomStateHeader header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kRandomStateMagic ||
+      header.version != kRandomStateVersion ||
+      header.engine != engineSignature<Engine>() ||
+      header.size != size - sizeof(header) ||
+      (Trivial::value && header.size != sizeof(Engine))) {
+    return false;
+  }
+  return loadEngine(engine, data + sizeof(header), header.size, Trivial());
+}
+
+template <class T>
+inline T uniformBound(T min, T max, std::true_type) {
+  return max;
+}
+
+template <class T>
+inline T uniformBound(T min, T max, std::false_type) {
+  return std::nextafter(max, min);
+}
+
+template <class Engine, class T>
+inline void fillUniform(Engine *engine, T *values, std::size_t size,
+                        T min, T max) {
+  using Integral = std::is_integral<T>;
+  using Distribution = typename std::conditional<
+      Integral::value,
+      std::uniform_int_distribution<T>,
+      std::uniform_real_distribution<T>>::type;
+  Distribution distribution(min, max);
+  // uniform_real_distribution may return max when generate_canonical rounds
+  // up to one, so real values are clamped below max
+  const auto bound = uniformBound(min, max, Integral());
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = std::min(distribution(*engine), bound);
+  }
+}
+
+template <class Engine>
+inline void fillUniform(Engine *engine, float *values, std::size_t size,
+                        float min, float max) {
+  if (!randomBits<Engine>()) {
+    fillUniform<Engine, float>(engine, values, size, min, max);
+    return;
+  }
+  // The upper 24 bits of each word fit in the significand exactly, giving a
+  // canonical value in [0, 1). Scaling it by the range can still round up to
+  // max when min is not zero, so the result is clamped below max.
+  const auto range = max - min;
+  const auto bound = std::nextafter(max, min);
+  std::uint32_t words[kRandomBlock];
+  for (std::size_t first = 0; first < size; first += kRandomBlock) {
+    const auto count = std::min(kRandomBlock, size - first);
+    fillWords(engine, words, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto bits = static_cast<std::int32_t>(words[i] >> 8);
+      const auto canonical = bits * (1.f / 16777216);
+      values[first + i] = std::min(min + canonical * range, bound);
+    }
+  }
+}
+
+template <class Engine>
+inline void fillUniform(Engine *engine, double *values, std::size_t size,
+                        double min, double max) {
+  if (!randomBits<Engine>()) {
+    fillUniform<Engine, double>(engine, values, size, min, max);
+    return;
+  }
+  // Combines 27 and 26 bits of two words into 53 bits as in genrand_res53,
+  // converting from signed 32-bit integers so that the loop vectorizes. The
+  // result is clamped below max as in the single-precision version.
+  const auto range = max - min;
+  const auto bound = std::nextafter(max, min);
+  std::uint32_t words[kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += kRandomBlock) {
+    const auto count = std::min(kRandomBlock, size - first);
+    fillWords(engine, words, count * 2);
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto high = static_cast<std::int32_t>(words[2 * i] >> 5);
+      const auto low = static_cast<std::int32_t>(words[2 * i + 1] >> 6);
+      const auto canonical =
+          (high * 67108864.0 + low) * (1.0 / 9007199254740992.0);
+      values[first + i] = std::min(min + canonical * range, bound);
+    }
+  }
+}
+
+}  // namespace detail
+
 template <class Engine>
 inline Random<Engine>::Random() : engine_(std::random_device()()) {}
 
 template <class Engine>
 inline Random<Engine>::Random(Type seed) : engine_(seed) {}
 
+template <class Engine>
+inline Random<Engine>::Random(const Engine& engine) : engine_(engine) {}
+
 // MARK: Shared instance
 
 template <class Engine>
@@ -154,6 +558,58 @@ inline void Random<Engine>::deleteShared() {
   shared_deleted_ = true;
 }
 
+// MARK: Thread-local instance
+
+template <class Engine>
+inline Random<Engine>& Random<Engine>::local() {
+  auto& local = localInstance();
+  if (local.generation != local_generation_.load(std::memory_order_acquire)) {
+    reseedLocal(&local);
+  }
+  return local.random;
+}
+
+template <class Engine>
+inline void Random<Engine>::seedLocal(Type value) {
+  auto& local = localInstance();
+  std::lock_guard<std::mutex> lock(local_mutex_);
+  local_seed_ = value;
+  local_count_ = 1;
+  local.random.seed(localSeed(value, 0));
+  local.generation = local_generation_.load(std::memory_order_relaxed) + 1;
+  local_generation_.store(local.generation, std::memory_order_release);
+}
+
+template <class Engine>
+inline void Random<Engine>::seedLocal(Type value, std::uint64_t index) {
+  auto& local = localInstance();
+  local.random.seed(localSeed(value, index));
+  local.generation = local_generation_.load(std::memory_order_acquire);
+}
+
+template <class Engine>
+inline typename Random<Engine>::Local& Random<Engine>::localInstance() {
+  thread_local Local local;
+  return local;
+}
+
+template <class Engine>
+inline void Random<Engine>::reseedLocal(Local *local) {
+  std::lock_guard<std::mutex> lock(local_mutex_);
+  local->generation = local_generation_.load(std::memory_order_relaxed);
+  if (local->generation) {
+    local->random.seed(localSeed(local_seed_, local_count_++));
+  } else {
+    local->random.randomize();
+  }
+}
+
+template <class Engine>
+inline typename Random<Engine>::Type Random<Engine>::localSeed(
+    Type value, std::uint64_t index) {
+  return static_cast<Type>(hash(value, index));
+}
+
 // MARK: Random generation
 
 template <class Engine>
@@ -171,6 +627,45 @@ inline typename Random<Engine>::Type Random<Engine>::next() {
   return engine_();
 }
 
+// MARK: Splitting
+
+template <class Engine>
+inline Random<Engine> Random<Engine>::split() {
+  return Random(detail::splitEngine(&engine_));
+}
+
+template <class Engine>
+inline std::vector<Random<Engine>> Random<Engine>::spawn(std::size_t count) {
+  std::vector<Random> children;
+  children.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    children.emplace_back(split());
+  }
+  return children;
+}
+
+// MARK: State
+
+template <class Engine>
+inline std::vector<std::uint8_t> Random<Engine>::saveState() const {
+  std::vector<std::uint8_t> data;
+  saveState(&data);
+  return data;
+}
+
+template <class Engine>
+inline void Random<Engine>::saveState(std::vector<std::uint8_t> *data) const {
+  assert(data);
+  detail::saveEngine(engine_, data, std::is_trivially_copyable<Engine>());
+}
+
+template <class Engine>
+inline bool Random<Engine>::loadState(const std::uint8_t *data,
+                                      std::size_t size) {
+  assert(data || !size);
+  return detail::loadEngine(&engine_, data, size);
+}
+
 // MARK: Distribution
 
 template <class Engine>
@@ -198,60 +693,213 @@ inline T Random<Engine>::uniform(T min, T max) {
 
 template <class Engine>
 template <class T>
-inline T Random<Engine>::gaussian() {
-  return std::normal_distribution<Promote<T>>()(engine_);
+inline T Random<Engine>::gaussian(Sampling sampling) {
+  return gaussian<T>(0, 1, sampling);
 }
 
 template <class Engine>
 template <class T>
-inline T Random<Engine>::gaussian(Promote<T> mean, Promote<T> stddev) {
+inline T Random<Engine>::gaussian(Promote<T> mean, Promote<T> stddev,
+                                  Sampling sampling) {
+  if (sampling == Sampling::ZIGGURAT) {
+    const auto value = zigguratNormal([this] {
+      return detail::randomWord(&engine_);
+    });
+    return static_cast<T>(mean + stddev * value);
+  }
   return std::normal_distribution<Promote<T>>(mean, stddev)(engine_);
 }
 
+template <class Engine>
+template <class T>
+inline T Random<Engine>::exponential(Promote<T> lambda, Sampling sampling) {
+  if (sampling == Sampling::ZIGGURAT) {
+    const auto value = zigguratExponential([this] {
+      return detail::randomWord(&engine_);
+    });
+    return static_cast<T>(value / lambda);
+  }
+  return std::exponential_distribution<Promote<T>>(lambda)(engine_);
+}
+
+// MARK: Bulk distribution
+
+template <class Engine>
+template <class T>
+inline void Random<Engine>::fillUniform(T *values, std::size_t size,
+                                        T min, T max) {
+  assert(values || !size);
+  detail::fillUniform(&engine_, values, size, min, max);
+}
+
+template <class Engine>
+template <class T>
+inline void Random<Engine>::fillGaussian(T *values, std::size_t size,
+                                         Promote<T> mean, Promote<T> stddev,
+                                         Sampling sampling) {
+  assert(values || !size);
+  if (sampling == Sampling::ZIGGURAT) {
+    const auto generator = [this] { return detail::randomWord(&engine_); };
+    for (std::size_t i = 0; i < size; ++i) {
+      values[i] = static_cast<T>(mean + stddev * zigguratNormal(generator));
+    }
+    return;
+  }
+  using Real = Promote<T>;
+  Real uniforms[detail::kRandomBlock];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    const auto pairs = (count + 1) / 2;
+    fillUniform<Real>(uniforms, pairs * 2, 0, 1);
+    for (std::size_t i = 0; i < pairs; ++i) {
+      // Uniforms are in [0, 1), and the logarithm needs (0, 1]
+      const auto radius = stddev * std::sqrt(-2 * std::log(1 - uniforms[i]));
+      const auto angle = two_pi<Real>() * uniforms[pairs + i];
+      values[first + 2 * i] = static_cast<T>(mean + radius * std::cos(angle));
+      if (2 * i + 1 < count) {
+        values[first + 2 * i + 1] = static_cast<T>(
+            mean + radius * std::sin(angle));
+      }
+    }
+  }
+}
+
+template <class Engine>
+template <class T>
+inline void Random<Engine>::fillExponential(T *values, std::size_t size,
+                                            Promote<T> lambda,
+                                            Sampling sampling) {
+  assert(values || !size);
+  if (sampling == Sampling::ZIGGURAT) {
+    const auto generator = [this] { return detail::randomWord(&engine_); };
+    for (std::size_t i = 0; i < size; ++i) {
+      values[i] = static_cast<T>(zigguratExponential(generator) / lambda);
+    }
+    return;
+  }
+  using Real = Promote<T>;
+  Real uniforms[detail::kRandomBlock];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    fillUniform<Real>(uniforms, count, 0, 1);
+    for (std::size_t i = 0; i < count; ++i) {
+      values[first + i] = static_cast<T>(-std::log(1 - uniforms[i]) / lambda);
+    }
+  }
+}
+
+// MARK: Discrete distribution
+
+template <class Engine>
+inline std::size_t Random<Engine>::discrete(const AliasTable& table) {
+  return table(detail::randomWord(&engine_));
+}
+
+template <class Engine>
+inline void Random<Engine>::fillDiscrete(const AliasTable& table,
+                                         std::size_t *indices,
+                                         std::size_t size) {
+  assert(indices || !size);
+  if (detail::randomBits<Engine>() != 32) {
+    for (std::size_t i = 0; i < size; ++i) {
+      indices[i] = table(detail::randomWord(&engine_));
+    }
+    return;
+  }
+  // Drawing words a block ahead lets the table lookups overlap
+  std::uint32_t words[detail::kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    detail::fillWords(&engine_, words, count * 2);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::uint64_t high = words[2 * i];
+      indices[first + i] = table(high << 32 | words[2 * i + 1]);
+    }
+  }
+}
+
 namespace random {
 
 // MARK: Random generation
 
 template <class Engine>
 inline void seed(typename Random<Engine>::Type value) {
-  Random<Engine>::shared().seed(value);
+  Random<Engine>::seedLocal(value);
 }
 
 template <class Engine>
 inline void randomize() {
-  Random<Engine>::shared().randomize();
+  Random<Engine>::local().randomize();
 }
 
 template <class Engine>
 inline typename Random<Engine>::Type next() {
-  return Random<Engine>::shared().next();
+  return Random<Engine>::local().next();
 }
 
 // MARK: Distribution
 
 template <class T, class Engine>
 inline T uniform() {
-  return Random<Engine>::shared().uniform();
+  return Random<Engine>::local().template uniform<T>();
 }
 
 template <class T, class Engine>
 inline T uniform(T max) {
-  return Random<Engine>::shared().uniform(max);
+  return Random<Engine>::local().template uniform<T>(max);
 }
 
 template <class T, class Engine>
 inline T uniform(T min, T max) {
-  return Random<Engine>::shared().uniform(min, max);
+  return Random<Engine>::local().template uniform<T>(min, max);
 }
 
 template <class T, class Engine>
-inline T gaussian() {
-  return Random<Engine>::shared().gaussian();
+inline T gaussian(Sampling sampling) {
+  return Random<Engine>::local().template gaussian<T>(sampling);
 }
 
 template <class T, class Engine>
-inline T gaussian(Promote<T> mean, Promote<T> stddev) {
-  return Random<Engine>::shared().gaussian(mean, stddev);
+inline T gaussian(Promote<T> mean, Promote<T> stddev, Sampling sampling) {
+  return Random<Engine>::local().template gaussian<T>(mean, stddev, sampling);
+}
+
+template <class T, class Engine>
+inline T exponential(Promote<T> lambda, Sampling sampling) {
+  return Random<Engine>::local().template exponential<T>(lambda, sampling);
+}
+
+// MARK: Bulk distribution
+
+template <class T, class Engine>
+inline void fillUniform(T *values, std::size_t size, T min, T max) {
+  Random<Engine>::local().fillUniform(values, size, min, max);
+}
+
+template <class T, class Engine>
+inline void fillGaussian(T *values, std::size_t size,
+                         Promote<T> mean, Promote<T> stddev,
+                         Sampling sampling) {
+  Random<Engine>::local().fillGaussian(values, size, mean, stddev, sampling);
+}
+
+template <class T, class Engine>
+inline void fillExponential(T *values, std::size_t size, Promote<T> lambda,
+                            Sampling sampling) {
+  Random<Engine>::local().fillExponential(values, size, lambda, sampling);
+}
+
+// MARK: Discrete distribution
+
+template <class Engine>
+inline std::size_t discrete(const AliasTable& table) {
+  return Random<Engine>::local().discrete(table);
+}
+
+template <class Engine>
+inline void fillDiscrete(const AliasTable& table, std::size_t *indices,
+                         std::size_t size) {
+  Random<Engine>::local().fillDiscrete(table, indices, size);
 }
 
 }  // namespace random
@@ -261,6 +909,7 @@ inline T gaussian(Promote<T> mean, Promote<T> stddev) {
 namespace random = math::random;
 
 using math::Random;
+using math::Sampling;
 
 }  // namespace shotamatsuda
 
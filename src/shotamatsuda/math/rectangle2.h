@@ -53,8 +53,10 @@
 #endif  // SHOTAMATSUDA_HAS_COREGRAPHICS
 
 #include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/random.h"
 #include "shotamatsuda/math/size.h"
 #include "shotamatsuda/math/vector.h"
 
@@ -73,18 +75,18 @@ class Rect<T, 2> final {
   using Type = T;
 
  public:
-  Rect();
-  explicit Rect(const Vec2<T>& origin);
-  explicit Rect(const Size2<T>& size);
-  Rect(T x, T y, T width, T height);
-  Rect(T x, T y, const Size2<T>& size);
-  Rect(const Vec2<T>& origin, T width, T height);
-  Rect(const Vec2<T>& origin, const Size2<T>& size);
-  Rect(const Vec2<T>& p1, const Vec2<T>& p2);
+  constexpr Rect();
+  explicit constexpr Rect(const Vec2<T>& origin);
+  explicit constexpr Rect(const Size2<T>& size);
+  constexpr Rect(T x, T y, T width, T height);
+  constexpr Rect(T x, T y, const Size2<T>& size);
+  constexpr Rect(const Vec2<T>& origin, T width, T height);
+  constexpr Rect(const Vec2<T>& origin, const Size2<T>& size);
+  constexpr Rect(const Vec2<T>& p1, const Vec2<T>& p2);
 
   // Implicit conversion
   template <class U>
-  Rect(const Rect2<U>& other);
+  constexpr Rect(const Rect2<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -113,14 +115,14 @@ class Rect<T, 2> final {
   Rect& operator=(const Rect&) = default;
 
   // Mutators
-  void set(const Vec2<T>& origin);
-  void set(const Size2<T>& size);
-  void set(T x, T y, T width, T height);
-  void set(const Vec2<T>& origin, const Size2<T>& size);
-  void set(T x, T y, const Size2<T>& size);
-  void set(const Vec2<T>& origin, T width, T height);
-  void set(const Vec2<T>& p1, const Vec2<T>& p2);
-  void reset();
+  constexpr void set(const Vec2<T>& origin);
+  constexpr void set(const Size2<T>& size);
+  constexpr void set(T x, T y, T width, T height);
+  constexpr void set(const Vec2<T>& origin, const Size2<T>& size);
+  constexpr void set(T x, T y, const Size2<T>& size);
+  constexpr void set(const Vec2<T>& origin, T width, T height);
+  constexpr void set(const Vec2<T>& p1, const Vec2<T>& p2);
+  constexpr void reset();
 
   // Comparison
   template <class V, class U = T>
@@ -134,6 +136,15 @@ class Rect<T, 2> final {
   Promote<T> perimeter() const;
   Vec2<Promote<T>> centroid() const;
 
+  // Sampling of uniformly distributed points inside the rectangle
+  Vec2<Promote<T>> randomPoint() const;
+  template <class Random>
+  Vec2<Promote<T>> randomPoint(Random *random) const;
+  void randomPoints(Vec2<Promote<T>> *points, std::size_t size) const;
+  template <class Random>
+  void randomPoints(Vec2<Promote<T>> *points, std::size_t size,
+                    Random *random) const;
+
   // Coordinates
   T minX() const;
   Promote<T> midX() const;
@@ -167,31 +178,31 @@ class Rect<T, 2> final {
 
   // Translation
   template <class U>
-  Rect& translate(U offset);
+  constexpr Rect& translate(U offset);
   template <class U>
-  Rect& translate(U dx, U dy);
+  constexpr Rect& translate(U dx, U dy);
   template <class U = T>
-  Rect& translate(const Vec2<U>& offset);
+  constexpr Rect& translate(const Vec2<U>& offset);
   template <class U>
-  Rect2<Promote<T, U>> translated(U offset) const;
+  constexpr Rect2<Promote<T, U>> translated(U offset) const;
   template <class U>
-  Rect2<Promote<T, U>> translated(U dx, U dy) const;
+  constexpr Rect2<Promote<T, U>> translated(U dx, U dy) const;
   template <class U = T>
-  Rect2<Promote<T, U>> translated(const Vec2<U>& offset) const;
+  constexpr Rect2<Promote<T, U>> translated(const Vec2<U>& offset) const;
 
   // Scaling
   template <class U>
-  Rect& scale(U scale);
+  constexpr Rect& scale(U scale);
   template <class U>
-  Rect& scale(U sx, U sy);
+  constexpr Rect& scale(U sx, U sy);
   template <class U>
-  Rect& scale(const Vec2<U>& scale);
+  constexpr Rect& scale(const Vec2<U>& scale);
   template <class U>
-  Rect2<Promote<T, U>> scaled(U scale) const;
+  constexpr Rect2<Promote<T, U>> scaled(U scale) const;
   template <class U>
-  Rect2<Promote<T, U>> scaled(U sx, U sy) const;
+  constexpr Rect2<Promote<T, U>> scaled(U sx, U sy) const;
   template <class U = T>
-  Rect2<Promote<T, U>> scaled(const Vec2<U>& scale) const;
+  constexpr Rect2<Promote<T, U>> scaled(const Vec2<U>& scale) const;
 
   // Containment
   template <class U = T>
@@ -222,17 +233,17 @@ class Rect<T, 2> final {
 
 // Comparison
 template <class T, class U>
-bool operator==(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator==(const Rect2<T>& lhs, const Rect2<U>& rhs);
 template <class T, class U>
-bool operator!=(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator!=(const Rect2<T>& lhs, const Rect2<U>& rhs);
 template <class T, class U>
-bool operator<(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator<(const Rect2<T>& lhs, const Rect2<U>& rhs);
 template <class T, class U>
-bool operator>(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator>(const Rect2<T>& lhs, const Rect2<U>& rhs);
 template <class T, class U>
-bool operator<=(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator<=(const Rect2<T>& lhs, const Rect2<U>& rhs);
 template <class T, class U>
-bool operator>=(const Rect2<T>& lhs, const Rect2<U>& rhs);
+constexpr bool operator>=(const Rect2<T>& lhs, const Rect2<U>& rhs);
 
 using Rect2i = Rect2<int>;
 using Rect2f = Rect2<float>;
@@ -249,36 +260,40 @@ using Rectangle2d = Rect2d;
 // MARK: -
 
 template <class T>
-inline Rect<T, 2>::Rect() : origin(), size() {}
+inline constexpr Rect<T, 2>::Rect() : origin(), size() {}
 
 template <class T>
-inline Rect<T, 2>::Rect(const Vec2<T>& origin) : origin(origin), size() {}
+inline constexpr Rect<T, 2>::Rect(const Vec2<T>& origin)
+    : origin(origin),
+      size() {}
 
 template <class T>
-inline Rect<T, 2>::Rect(const Size2<T>& size) : origin(), size(size) {}
+inline constexpr Rect<T, 2>::Rect(const Size2<T>& size)
+    : origin(),
+      size(size) {}
 
 template <class T>
-inline Rect<T, 2>::Rect(T x, T y, T width, T height)
+inline constexpr Rect<T, 2>::Rect(T x, T y, T width, T height)
     : origin(x, y),
       size(width, height) {}
 
 template <class T>
-inline Rect<T, 2>::Rect(T x, T y, const Size2<T>& size)
+inline constexpr Rect<T, 2>::Rect(T x, T y, const Size2<T>& size)
     : origin(x, y),
       size(size) {}
 
 template <class T>
-inline Rect<T, 2>::Rect(const Vec2<T>& origin, T width, T height)
+inline constexpr Rect<T, 2>::Rect(const Vec2<T>& origin, T width, T height)
     : origin(origin),
       size(width, height) {}
 
 template <class T>
-inline Rect<T, 2>::Rect(const Vec2<T>& origin, const Size2<T>& size)
+inline constexpr Rect<T, 2>::Rect(const Vec2<T>& origin, const Size2<T>& size)
     : origin(origin),
       size(size) {}
 
 template <class T>
-inline Rect<T, 2>::Rect(const Vec2<T>& p1, const Vec2<T>& p2)
+inline constexpr Rect<T, 2>::Rect(const Vec2<T>& p1, const Vec2<T>& p2)
     : origin(std::min(p1.x, p2.x), std::min(p1.y, p2.y)),
       size(std::max(p1.x, p2.x) - origin.x, std::max(p1.y, p2.y) - origin.y) {}
 
@@ -286,7 +301,7 @@ inline Rect<T, 2>::Rect(const Vec2<T>& p1, const Vec2<T>& p2)
 
 template <class T>
 template <class U>
-inline Rect<T, 2>::Rect(const Rect2<U>& other)
+inline constexpr Rect<T, 2>::Rect(const Rect2<U>& other)
     : origin(other.origin),
       size(other.size) {}
 
@@ -351,81 +366,84 @@ inline Rect<T, 2>::operator ci::RectT<T>() const {
 // MARK: Mutators
 
 template <class T>
-inline void Rect<T, 2>::set(const Vec2<T>& origin) {
+inline constexpr void Rect<T, 2>::set(const Vec2<T>& origin) {
   this->origin = origin;
 }
 
 template <class T>
-inline void Rect<T, 2>::set(const Size2<T>& size) {
+inline constexpr void Rect<T, 2>::set(const Size2<T>& size) {
   this->size = size;
 }
 
 template <class T>
-inline void Rect<T, 2>::set(T x, T y, T width, T height) {
+inline constexpr void Rect<T, 2>::set(T x, T y, T width, T height) {
   origin.set(x, y);
   size.set(width, height);
 }
 
 template <class T>
-inline void Rect<T, 2>::set(const Vec2<T>& origin, const Size2<T>& size) {
+inline constexpr void Rect<T, 2>::set(const Vec2<T>& origin,
+                                      const Size2<T>& size) {
   this->origin = origin;
   this->size = size;
 }
 
 template <class T>
-inline void Rect<T, 2>::set(T x, T y, const Size2<T>& size) {
+inline constexpr void Rect<T, 2>::set(T x, T y, const Size2<T>& size) {
   origin.set(x, y);
   this->size = size;
 }
 
 template <class T>
-inline void Rect<T, 2>::set(const Vec2<T>& origin, T width, T height) {
+inline constexpr void Rect<T, 2>::set(const Vec2<T>& origin,
+                                      T width,
+                                      T height) {
   this->origin = origin;
   size.set(width, height);
 }
 
 template <class T>
-inline void Rect<T, 2>::set(const Vec2<T>& p1, const Vec2<T>& p2) {
+inline constexpr void Rect<T, 2>::set(const Vec2<T>& p1, const Vec2<T>& p2) {
   origin.set(std::min(p1.x, p2.x), std::min(p1.y, p2.y));
   size.set(std::max(p1.x, p2.x) - origin.x, std::max(p1.y, p2.y) - origin.y);
 }
 
 template <class T>
-inline void Rect<T, 2>::reset() {
+inline constexpr void Rect<T, 2>::reset() {
   *this = Rect();
 }
 
 // MARK: Comparison
 
 template <class T, class U>
-inline bool operator==(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator==(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return lhs.origin == rhs.origin && lhs.size == rhs.size;
 }
 
 template <class T, class U>
-inline bool operator!=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator!=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return !(lhs == rhs);
 }
 
 template <class T, class U>
-inline bool operator<(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator<(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return lhs.origin < rhs.origin ||
         (lhs.origin == rhs.origin && lhs.size < rhs.size);
 }
 
 template <class T, class U>
-inline bool operator>(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator>(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return lhs.origin > rhs.origin ||
         (lhs.origin == rhs.origin && lhs.size > rhs.size);
 }
 
 template <class T, class U>
-inline bool operator<=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator<=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return lhs < rhs || lhs == rhs;
 }
 
 template <class T, class U>
-inline bool operator>=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
+inline constexpr bool operator>=(const Rect2<T>& lhs, const Rect2<U>& rhs) {
   return lhs > rhs || lhs == rhs;
 }
 
@@ -463,6 +481,48 @@ inline Vec2<Promote<T>> Rect<T, 2>::centroid() const {
   return origin + size / 2;
 }
 
+// MARK: Sampling
+
+template <class T>
+inline Vec2<Promote<T>> Rect<T, 2>::randomPoint() const {
+  return randomPoint(&Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline Vec2<Promote<T>> Rect<T, 2>::randomPoint(Random *random) const {
+  assert(random);
+  using Real = Promote<T>;
+  const auto s = random->template uniform<Real>(0, 1);
+  const auto t = random->template uniform<Real>(0, 1);
+  return Vec2<Real>(x + width * s, y + height * t);
+}
+
+template <class T>
+inline void Rect<T, 2>::randomPoints(Vec2<Promote<T>> *points,
+                                     std::size_t size) const {
+  randomPoints(points, size, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Rect<T, 2>::randomPoints(Vec2<Promote<T>> *points,
+                                     std::size_t size,
+                                     Random *random) const {
+  assert(points || !size);
+  assert(random);
+  using Real = Promote<T>;
+  Real uniforms[detail::kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    random->fillUniform(uniforms, count * 2, Real(0), Real(1));
+    for (std::size_t i = 0; i < count; ++i) {
+      points[first + i].x = x + width * uniforms[i];
+      points[first + i].y = y + height * uniforms[count + i];
+    }
+  }
+}
+
 // MARK: Coordinates
 
 template <class T>
@@ -577,41 +637,41 @@ inline Rect2<Promote<T>> Rect<T, 2>::canonicalized() const {
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::translate(U offset) {
+inline constexpr Rect2<T>& Rect<T, 2>::translate(U offset) {
   origin += offset;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::translate(U dx, U dy) {
-  x += dx;
-  y += dy;
+inline constexpr Rect2<T>& Rect<T, 2>::translate(U dx, U dy) {
+  origin.x += dx;
+  origin.y += dy;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::translate(const Vec2<U>& offset) {
+inline constexpr Rect2<T>& Rect<T, 2>::translate(const Vec2<U>& offset) {
   origin += offset;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::translated(U offset) const {
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::translated(U offset) const {
   return Rect2<Promote<T, U>>(*this).translate(offset);
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::translated(U dx, U dy) const {
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::translated(U dx, U dy) const {
   return Rect2<Promote<T, U>>(*this).translate(dx, dy);
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::translated(
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::translated(
     const Vec2<U>& offset) const {
   return Rect2<Promote<T, U>>(*this).translate(offset);
 }
@@ -620,41 +680,42 @@ inline Rect2<Promote<T, U>> Rect<T, 2>::translated(
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::scale(U scale) {
+inline constexpr Rect2<T>& Rect<T, 2>::scale(U scale) {
   size *= scale;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::scale(U sx, U sy) {
-  width *= sx;
-  height *= sy;
+inline constexpr Rect2<T>& Rect<T, 2>::scale(U sx, U sy) {
+  size.vector.x *= sx;
+  size.vector.y *= sy;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<T>& Rect<T, 2>::scale(const Vec2<U>& scale) {
+inline constexpr Rect2<T>& Rect<T, 2>::scale(const Vec2<U>& scale) {
   size *= scale;
   return *this;
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::scaled(U scale) const {
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::scaled(U scale) const {
   return Rect2<Promote<T, U>>(*this).scale(scale);
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::scaled(U sx, U sy) const {
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::scaled(U sx, U sy) const {
   return Rect2<Promote<T, U>>(*this).scale(sx, sy);
 }
 
 template <class T>
 template <class U>
-inline Rect2<Promote<T, U>> Rect<T, 2>::scaled(const Vec2<U>& scale) const {
+inline constexpr Rect2<Promote<T, U>> Rect<T, 2>::scaled(
+    const Vec2<U>& scale) const {
   return Rect2<Promote<T, U>>(*this).scale(scale);
 }
 
@@ -750,8 +811,7 @@ using math::Rectangle2d;
 template <class T>
 struct std::hash<shotamatsuda::math::Rectangle2<T>> {
   std::size_t operator()(const shotamatsuda::math::Rectangle2<T>& value) const {
-    return ((std::hash<shotamatsuda::math::Vec2<T>>()(value.origin) << 0) ^
-            (std::hash<shotamatsuda::math::Size2<T>>()(value.size) << 1));
+    return shotamatsuda::math::hash(value.origin, value.size);
   }
 };
 
@@ -0,0 +1,269 @@
+//
+//  shotamatsuda/math/reduction.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_REDUCTION_H_
+#define SHOTAMATSUDA_MATH_REDUCTION_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/rectangle2.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+enum class Summation {
+  NAIVE,
+  COMPENSATED
+};
+
+// Reductions over contiguous ranges of vectors. Each thread keeps several
+// independent accumulators per component so that the inner loops vectorize
+// without reassociating floating-point arithmetic; results are deterministic
+// for a given concurrency. Compensated summation uses Neumaier's algorithm,
+// and does not survive -ffast-math. A concurrency of 0 uses all hardware
+// threads. minimum() and maximum() require a non-empty range.
+template <class T, int D>
+Vec<Promote<T>, D> sum(const Vec<T, D> *values, std::size_t size,
+                       Summation summation = Summation::NAIVE,
+                       int concurrency = 1);
+template <class T, int D>
+Vec<T, D> minimum(const Vec<T, D> *values, std::size_t size,
+                  int concurrency = 1);
+template <class T, int D>
+Vec<T, D> maximum(const Vec<T, D> *values, std::size_t size,
+                  int concurrency = 1);
+template <class T, int D>
+Vec<Promote<T>, D> centroid(const Vec<T, D> *values, std::size_t size,
+                            Summation summation = Summation::NAIVE,
+                            int concurrency = 1);
+template <class T>
+Rect2<T> bounds(const Vec2<T> *values, std::size_t size,
+                int concurrency = 1);
+
+// MARK: -
+
+namespace detail {
+
+constexpr int kReductionLanes = 4;
+constexpr std::size_t kReductionGrain = 1 << 16;
+
+template <class T>
+inline void addCompensated(T value, T *sum, T *compensation) {
+  const T total = *sum + value;
+  *compensation += (std::abs(*sum) >= std::abs(value) ?
+                    (*sum - total) + value : (value - total) + *sum);
+  *sum = total;
+}
+
+template <int D, class T, class V>
+inline void accumulate(const T *values, std::size_t size, V *sum) {
+  constexpr int lanes = D * kReductionLanes;
+  V partial[lanes] = {};
+  const std::size_t count = size * D;
+  std::size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    for (int j = 0; j < lanes; ++j) {
+      partial[j] += values[i + j];
+    }
+  }
+  for (; i < count; ++i) {
+    partial[i % lanes] += values[i];
+  }
+  for (int j = 0; j < lanes; ++j) {
+    sum[j % D] += partial[j];
+  }
+}
+
+template <int D, class T, class V>
+inline void accumulateCompensated(const T *values, std::size_t size,
+                                  V *sum, V *compensation) {
+  constexpr int lanes = D * kReductionLanes;
+  V partial[lanes] = {};
+  V error[lanes] = {};
+  const std::size_t count = size * D;
+  std::size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    for (int j = 0; j < lanes; ++j) {
+      addCompensated<V>(values[i + j], &partial[j], &error[j]);
+    }
+  }
+  for (; i < count; ++i) {
+    addCompensated<V>(values[i], &partial[i % lanes], &error[i % lanes]);
+  }
+  for (int j = 0; j < lanes; ++j) {
+    addCompensated(partial[j], &sum[j % D], &compensation[j % D]);
+    compensation[j % D] += error[j];
+  }
+}
+
+template <int D, class T>
+inline void extrema(const T *values, std::size_t size, T *min, T *max) {
+  assert(size);
+  constexpr int lanes = D * kReductionLanes;
+  T lower[lanes];
+  T upper[lanes];
+  for (int j = 0; j < lanes; ++j) {
+    lower[j] = upper[j] = values[j % D];
+  }
+  const std::size_t count = size * D;
+  std::size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    for (int j = 0; j < lanes; ++j) {
+      const T value = values[i + j];
+      lower[j] = value < lower[j] ? value : lower[j];
+      upper[j] = upper[j] < value ? value : upper[j];
+    }
+  }
+  for (; i < count; ++i) {
+    const T value = values[i];
+    lower[i % lanes] = value < lower[i % lanes] ? value : lower[i % lanes];
+    upper[i % lanes] = upper[i % lanes] < value ? value : upper[i % lanes];
+  }
+  for (int j = 0; j < D; ++j) {
+    min[j] = lower[j];
+    max[j] = upper[j];
+  }
+  for (int j = D; j < lanes; ++j) {
+    min[j % D] = lower[j] < min[j % D] ? lower[j] : min[j % D];
+    max[j % D] = max[j % D] < upper[j] ? upper[j] : max[j % D];
+  }
+}
+
+template <class T, int D>
+inline const T * components(const Vec<T, D> *values) {
+  static_assert(sizeof(Vec<T, D>) == D * sizeof(T),
+                "Vectors must be tightly packed");
+  return reinterpret_cast<const T *>(values);
+}
+
+template <class T, int D>
+inline void extrema(const Vec<T, D> *values, std::size_t size,
+                    int concurrency, Vec<T, D> *min, Vec<T, D> *max) {
+  assert(values && size);
+  const int chunks = chunkCount(size, concurrency, kReductionGrain);
+  std::vector<Vec<T, D>> lower(chunks);
+  std::vector<Vec<T, D>> upper(chunks);
+  parallelFor(size, chunks, [&](std::size_t first, std::size_t last,
+                                int chunk) {
+    extrema<D>(components(values + first), last - first,
+               &lower[chunk].x, &upper[chunk].x);
+  });
+  *min = lower.front();
+  *max = upper.front();
+  for (int chunk = 1; chunk < chunks; ++chunk) {
+    for (int j = 0; j < D; ++j) {
+      if (lower[chunk][j] < (*min)[j]) (*min)[j] = lower[chunk][j];
+      if ((*max)[j] < upper[chunk][j]) (*max)[j] = upper[chunk][j];
+    }
+  }
+}
+
+}  // namespace detail
+
+template <class T, int D>
+inline Vec<Promote<T>, D> sum(const Vec<T, D> *values, std::size_t size,
+                              Summation summation, int concurrency) {
+  assert(values || !size);
+  using V = Promote<T>;
+  const int chunks = chunkCount(size, concurrency, detail::kReductionGrain);
+  std::vector<Vec<V, D>> sums(chunks);
+  std::vector<Vec<V, D>> compensations(chunks);
+  parallelFor(size, chunks, [&](std::size_t first, std::size_t last,
+                                int chunk) {
+    const T * const components = detail::components(values + first);
+    switch (summation) {
+      case Summation::NAIVE:
+        detail::accumulate<D>(components, last - first, &sums[chunk].x);
+        break;
+      case Summation::COMPENSATED:
+        detail::accumulateCompensated<D>(components, last - first,
+                                         &sums[chunk].x,
+                                         &compensations[chunk].x);
+        break;
+    }
+  });
+  Vec<V, D> result;
+  Vec<V, D> compensation;
+  for (int chunk = 0; chunk < chunks; ++chunk) {
+    for (int j = 0; j < D; ++j) {
+      detail::addCompensated(sums[chunk][j], &result[j], &compensation[j]);
+      compensation[j] += compensations[chunk][j];
+    }
+  }
+  return summation == Summation::COMPENSATED ? result + compensation : result;
+}
+
+template <class T, int D>
+inline Vec<T, D> minimum(const Vec<T, D> *values, std::size_t size,
+                         int concurrency) {
+  Vec<T, D> min;
+  Vec<T, D> max;
+  detail::extrema(values, size, concurrency, &min, &max);
+  return min;
+}
+
+template <class T, int D>
+inline Vec<T, D> maximum(const Vec<T, D> *values, std::size_t size,
+                         int concurrency) {
+  Vec<T, D> min;
+  Vec<T, D> max;
+  detail::extrema(values, size, concurrency, &min, &max);
+  return max;
+}
+
+template <class T, int D>
+inline Vec<Promote<T>, D> centroid(const Vec<T, D> *values, std::size_t size,
+                                   Summation summation, int concurrency) {
+  if (!size) {
+    return Vec<Promote<T>, D>();
+  }
+  using V = Promote<T>;
+  return sum(values, size, summation, concurrency) / static_cast<V>(size);
+}
+
+template <class T>
+inline Rect2<T> bounds(const Vec2<T> *values, std::size_t size,
+                       int concurrency) {
+  if (!size) {
+    return Rect2<T>();
+  }
+  Vec2<T> min;
+  Vec2<T> max;
+  detail::extrema(values, size, concurrency, &min, &max);
+  return Rect2<T>(min, max);
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_REDUCTION_H_
@@ -0,0 +1,133 @@
+//
+//  shotamatsuda/math/rsqrt.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_RSQRT_H_
+#define SHOTAMATSUDA_MATH_RSQRT_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "shotamatsuda/math/simd.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Approximates 1 / sqrt(value) for positive normal values. The hardware or
+// bit-level estimate is refined with Newton-Raphson steps, which keeps the
+// relative error below 5e-6. The result is unspecified for zero, negative
+// and denormal inputs.
+float rsqrt(float value);
+double rsqrt(double value);
+long double rsqrt(long double value);
+
+// Writes the approximations of 1 / sqrt(values[i]) to results, with the same
+// error bounds as above. The float overload processes four values at a time
+// when SSE is available.
+void rsqrt(const float *values, int size, float *results);
+template <class T>
+void rsqrt(const T *values, int size, T *results);
+
+// MARK: -
+
+inline float rsqrt(float value) {
+#if SHOTAMATSUDA_HAS_SSE
+  // The estimate is accurate to 1.5 * 2^-12, and one step squares that
+  float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+  estimate *= 1.5f - 0.5f * value * estimate * estimate;
+#else
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = 0x5f375a86 - (bits >> 1);
+  float estimate;
+  std::memcpy(&estimate, &bits, sizeof(estimate));
+  for (int i = 0; i < 2; ++i) {
+    estimate *= 1.5f - 0.5f * value * estimate * estimate;
+  }
+#endif  // SHOTAMATSUDA_HAS_SSE
+  return estimate;
+}
+
+inline double rsqrt(double value) {
+#if SHOTAMATSUDA_HAS_SSE2
+  if (value >= std::numeric_limits<float>::min() &&
+      value <= std::numeric_limits<float>::max()) {
+    const __m128 single = _mm_cvtsd_ss(_mm_setzero_ps(), _mm_set_sd(value));
+    double estimate = _mm_cvtss_f32(_mm_rsqrt_ss(single));
+    estimate *= 1.5 - 0.5 * value * estimate * estimate;
+    return estimate;
+  }
+#endif  // SHOTAMATSUDA_HAS_SSE2
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = 0x5fe6eb50c7b537a9 - (bits >> 1);
+  double estimate;
+  std::memcpy(&estimate, &bits, sizeof(estimate));
+  for (int i = 0; i < 3; ++i) {
+    estimate *= 1.5 - 0.5 * value * estimate * estimate;
+  }
+  return estimate;
+}
+
+inline long double rsqrt(long double value) {
+  return 1 / std::sqrt(value);
+}
+
+inline void rsqrt(const float *values, int size, float *results) {
+  assert((values && results) || !size);
+  int i = 0;
+#if SHOTAMATSUDA_HAS_SSE
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 three_halves = _mm_set1_ps(1.5f);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 value = _mm_loadu_ps(values + i);
+    const __m128 estimate = _mm_rsqrt_ps(value);
+    const __m128 product = _mm_mul_ps(_mm_mul_ps(half, value),
+                                      _mm_mul_ps(estimate, estimate));
+    _mm_storeu_ps(results + i,
+                  _mm_mul_ps(estimate, _mm_sub_ps(three_halves, product)));
+  }
+#endif  // SHOTAMATSUDA_HAS_SSE
+  for (; i < size; ++i) {
+    results[i] = rsqrt(values[i]);
+  }
+}
+
+template <class T>
+inline void rsqrt(const T *values, int size, T *results) {
+  assert((values && results) || !size);
+  for (int i = 0; i < size; ++i) {
+    results[i] = rsqrt(values[i]);
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_RSQRT_H_
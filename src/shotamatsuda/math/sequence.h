@@ -0,0 +1,405 @@
+//
+//  shotamatsuda/math/sequence.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_SEQUENCE_H_
+#define SHOTAMATSUDA_MATH_SEQUENCE_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "shotamatsuda/math/hash.h"
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/vector_buffer.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Low-discrepancy sequences in [0, 1)^D for D of 2 or 3. Every point is
+// computed directly from its index, so at() is random access, and fill()
+// writes the points [first, first + size) into vectors or a structure of
+// arrays, split across threads like the reductions. A concurrency of 0 uses
+// all hardware threads.
+
+// Halton sequence in bases 2, 3 and 5.
+template <class T, int D>
+class HaltonSequence final {
+ public:
+  Vec<T, D> at(std::uint64_t index) const;
+  Vec<T, D> operator[](std::uint64_t index) const { return at(index); }
+  void fill(std::uint64_t first, Vec<T, D> *values, std::size_t size,
+            int concurrency = 1) const;
+  void fill(std::uint64_t first, VecBuffer<T, D> *buffer,
+            int concurrency = 1) const;
+};
+
+// Sobol sequence with the direction numbers of Joe and Kuo. Given a seed, the
+// points are Owen-scrambled and shuffled with the hash-based permutation of
+// Burley, "Practical Hash-based Owen Scrambling", which keeps the
+// stratification of every power-of-two prefix. Indices wrap at 2^32.
+template <class T, int D>
+class SobolSequence final {
+ public:
+  SobolSequence();
+  explicit SobolSequence(std::uint32_t seed);
+
+  Vec<T, D> at(std::uint64_t index) const;
+  Vec<T, D> operator[](std::uint64_t index) const { return at(index); }
+  void fill(std::uint64_t first, Vec<T, D> *values, std::size_t size,
+            int concurrency = 1) const;
+  void fill(std::uint64_t first, VecBuffer<T, D> *buffer,
+            int concurrency = 1) const;
+
+ private:
+  bool scrambled_;
+  std::uint32_t seeds_[D + 1];
+};
+
+// Additive recurrence of Roberts, known as R2 and R3, whose generators are the
+// powers of the inverse of the generalized golden ratio. Points are computed
+// in 64-bit fixed point, so precision does not degrade with the index.
+template <class T, int D>
+class RobertsSequence final {
+ public:
+  RobertsSequence() : RobertsSequence(0.5) {}
+  explicit RobertsSequence(double offset);
+
+  Vec<T, D> at(std::uint64_t index) const;
+  Vec<T, D> operator[](std::uint64_t index) const { return at(index); }
+  void fill(std::uint64_t first, Vec<T, D> *values, std::size_t size,
+            int concurrency = 1) const;
+  void fill(std::uint64_t first, VecBuffer<T, D> *buffer,
+            int concurrency = 1) const;
+
+ private:
+  std::uint64_t offset_;
+};
+
+template <class T>
+using Halton2 = HaltonSequence<T, 2>;
+template <class T>
+using Halton3 = HaltonSequence<T, 3>;
+template <class T>
+using Sobol2 = SobolSequence<T, 2>;
+template <class T>
+using Sobol3 = SobolSequence<T, 3>;
+template <class T>
+using R2 = RobertsSequence<T, 2>;
+template <class T>
+using R3 = RobertsSequence<T, 3>;
+
+// MARK: -
+
+namespace detail {
+
+constexpr std::size_t kSequenceGrain = 1 << 14;
+
+// Converts a 32-bit fraction to [0, 1), dropping the bits that do not fit in
+// the significand so that float values do not round up to 1.
+template <class T>
+inline T fraction32(std::uint32_t value) {
+  return (std::is_same<T, float>::value ?
+          static_cast<T>(value >> 8) * static_cast<T>(1.0 / (1 << 24)) :
+          static_cast<T>(value * (1.0 / 4294967296.0)));
+}
+
+template <class T>
+inline T fraction64(std::uint64_t value) {
+  return (std::is_same<T, float>::value ?
+          static_cast<T>(value >> 40) * static_cast<T>(1.0 / (1 << 24)) :
+          static_cast<T>((value >> 11) * (1.0 / 9007199254740992.0)));
+}
+
+inline std::uint32_t reverseBits(std::uint32_t value) {
+  value = (value << 16) | (value >> 16);
+  value = ((value & 0x00ff00ff) << 8) | ((value & 0xff00ff00) >> 8);
+  value = ((value & 0x0f0f0f0f) << 4) | ((value & 0xf0f0f0f0) >> 4);
+  value = ((value & 0x33333333) << 2) | ((value & 0xcccccccc) >> 2);
+  value = ((value & 0x55555555) << 1) | ((value & 0xaaaaaaaa) >> 1);
+  return value;
+}
+
+// Takes the base as a template argument so that the divisions compile to
+// multiplications. Base 2 reduces to reversing the bits.
+template <class T, std::uint64_t Base>
+inline T radicalInverse(std::uint64_t index) {
+  if (Base == 2) {
+    return fraction64<T>(
+        static_cast<std::uint64_t>(reverseBits(
+            static_cast<std::uint32_t>(index))) << 32 |
+        reverseBits(static_cast<std::uint32_t>(index >> 32)));
+  }
+  const double inverse = 1.0 / Base;
+  double factor = inverse;
+  double result = 0;
+  for (; index; index /= Base, factor *= inverse) {
+    result += (index % Base) * factor;
+  }
+  // The sum can round up to 1 in float when the index has many digits
+  const auto value = static_cast<T>(result);
+  return value < 1 ? value : std::nextafter(static_cast<T>(1), T());
+}
+
+inline std::uint32_t owenScramble(std::uint32_t value, std::uint32_t seed) {
+  // Laine-Karras style permutation applied to the reversed bits, so that
+  // each bit only depends on the bits above it
+  value = reverseBits(value);
+  value += seed;
+  value ^= value * 0x6c50b47c;
+  value ^= value * 0xb82f1e52;
+  value ^= value * 0xc7afe638;
+  value ^= value * 0x8d22f6e6;
+  return reverseBits(value);
+}
+
+inline std::uint32_t sobol(std::uint32_t index, int dimension) {
+  // Direction numbers of the first three dimensions of Joe and Kuo, whose
+  // primitive polynomials are 1, x + 1 and x^2 + x + 1, expanded into the
+  // exclusive-or of every byte value at each of the four byte positions
+  static const auto tables = [] {
+    std::uint32_t directions[3][32];
+    for (int bit = 0; bit < 32; ++bit) {
+      directions[0][bit] = std::uint32_t(1) << (31 - bit);
+    }
+    directions[1][0] = std::uint32_t(1) << 31;
+    for (int bit = 1; bit < 32; ++bit) {
+      const auto previous = directions[1][bit - 1];
+      directions[1][bit] = previous ^ (previous >> 1);
+    }
+    directions[2][0] = std::uint32_t(1) << 31;
+    directions[2][1] = std::uint32_t(3) << 30;
+    for (int bit = 2; bit < 32; ++bit) {
+      const auto previous = directions[2][bit - 2];
+      directions[2][bit] = previous ^ (previous >> 2) ^ directions[2][bit - 1];
+    }
+    struct {
+      std::uint32_t values[3][4][256];
+    } result;
+    for (int i = 0; i < 3; ++i) {
+      for (int byte = 0; byte < 4; ++byte) {
+        for (int value = 0; value < 256; ++value) {
+          std::uint32_t sum = 0;
+          for (int bit = 0; bit < 8; ++bit) {
+            if (value & (1 << bit)) {
+              sum ^= directions[i][byte * 8 + bit];
+            }
+          }
+          result.values[i][byte][value] = sum;
+        }
+      }
+    }
+    return result;
+  }();
+  const auto& table = tables.values[dimension];
+  return (table[0][index & 0xff] ^
+          table[1][index >> 8 & 0xff] ^
+          table[2][index >> 16 & 0xff] ^
+          table[3][index >> 24]);
+}
+
+template <class Sequence, class T, int D>
+inline void fillSequence(const Sequence& sequence, std::uint64_t first,
+                         Vec<T, D> *values, std::size_t size,
+                         int concurrency) {
+  assert(values || !size);
+  const int chunks = chunkCount(size, concurrency, kSequenceGrain);
+  parallelFor(size, chunks, [&](std::size_t begin, std::size_t end, int) {
+    for (auto i = begin; i < end; ++i) {
+      values[i] = sequence.at(first + i);
+    }
+  });
+}
+
+template <class Sequence, class T>
+inline void fillSequence(const Sequence& sequence, std::uint64_t first,
+                         Vec2Buffer<T> *buffer, int concurrency) {
+  assert(buffer);
+  T * const x = buffer->x.data();
+  T * const y = buffer->y.data();
+  const auto size = buffer->size();
+  const int chunks = chunkCount(size, concurrency, kSequenceGrain);
+  parallelFor(size, chunks, [&](std::size_t begin, std::size_t end, int) {
+    for (auto i = begin; i < end; ++i) {
+      const auto value = sequence.at(first + i);
+      x[i] = value.x;
+      y[i] = value.y;
+    }
+  });
+}
+
+template <class Sequence, class T>
+inline void fillSequence(const Sequence& sequence, std::uint64_t first,
+                         Vec3Buffer<T> *buffer, int concurrency) {
+  assert(buffer);
+  T * const x = buffer->x.data();
+  T * const y = buffer->y.data();
+  T * const z = buffer->z.data();
+  const auto size = buffer->size();
+  const int chunks = chunkCount(size, concurrency, kSequenceGrain);
+  parallelFor(size, chunks, [&](std::size_t begin, std::size_t end, int) {
+    for (auto i = begin; i < end; ++i) {
+      const auto value = sequence.at(first + i);
+      x[i] = value.x;
+      y[i] = value.y;
+      z[i] = value.z;
+    }
+  });
+}
+
+}  // namespace detail
+
+// MARK: Halton sequence
+
+template <class T, int D>
+inline Vec<T, D> HaltonSequence<T, D>::at(std::uint64_t index) const {
+  static_assert(D == 2 || D == 3, "Sequences are 2 or 3 dimensional");
+  Vec<T, D> result;
+  result[0] = detail::radicalInverse<T, 2>(index);
+  result[1] = detail::radicalInverse<T, 3>(index);
+  if (D > 2) {
+    result[D - 1] = detail::radicalInverse<T, 5>(index);
+  }
+  return result;
+}
+
+template <class T, int D>
+inline void HaltonSequence<T, D>::fill(std::uint64_t first,
+                                       Vec<T, D> *values, std::size_t size,
+                                       int concurrency) const {
+  detail::fillSequence(*this, first, values, size, concurrency);
+}
+
+template <class T, int D>
+inline void HaltonSequence<T, D>::fill(std::uint64_t first,
+                                       VecBuffer<T, D> *buffer,
+                                       int concurrency) const {
+  detail::fillSequence(*this, first, buffer, concurrency);
+}
+
+// MARK: Sobol sequence
+
+template <class T, int D>
+inline SobolSequence<T, D>::SobolSequence() : scrambled_(false), seeds_() {}
+
+template <class T, int D>
+inline SobolSequence<T, D>::SobolSequence(std::uint32_t seed)
+    : scrambled_(true) {
+  // Independent seeds for shuffling the indices and for each dimension
+  for (int i = 0; i <= D; ++i) {
+    seeds_[i] = static_cast<std::uint32_t>(hash(seed, i));
+  }
+}
+
+template <class T, int D>
+inline Vec<T, D> SobolSequence<T, D>::at(std::uint64_t index) const {
+  static_assert(D == 2 || D == 3, "Sequences are 2 or 3 dimensional");
+  auto position = static_cast<std::uint32_t>(index);
+  if (scrambled_) {
+    position = detail::owenScramble(position, seeds_[D]);
+  }
+  Vec<T, D> result;
+  for (int i = 0; i < D; ++i) {
+    auto value = detail::sobol(position, i);
+    if (scrambled_) {
+      value = detail::owenScramble(value, seeds_[i]);
+    }
+    result[i] = detail::fraction32<T>(value);
+  }
+  return result;
+}
+
+template <class T, int D>
+inline void SobolSequence<T, D>::fill(std::uint64_t first,
+                                      Vec<T, D> *values, std::size_t size,
+                                      int concurrency) const {
+  detail::fillSequence(*this, first, values, size, concurrency);
+}
+
+template <class T, int D>
+inline void SobolSequence<T, D>::fill(std::uint64_t first,
+                                      VecBuffer<T, D> *buffer,
+                                      int concurrency) const {
+  detail::fillSequence(*this, first, buffer, concurrency);
+}
+
+// MARK: Roberts sequence
+
+template <class T, int D>
+inline RobertsSequence<T, D>::RobertsSequence(double offset) {
+  assert(0 <= offset && offset < 1);
+  offset_ = static_cast<std::uint64_t>(offset * 18446744073709551616.0);
+}
+
+template <class T, int D>
+inline Vec<T, D> RobertsSequence<T, D>::at(std::uint64_t index) const {
+  static_assert(D == 2 || D == 3, "Sequences are 2 or 3 dimensional");
+  // Powers of the inverse of the plastic number and of the root of
+  // x^4 = x + 1, as 64-bit fractions
+  static const std::uint64_t generators[2][3] = {
+    {0xc13fa9a902a6328f, 0x91e10da5c79e7b1c, 0},
+    {0xd1b54a32d192ed03, 0xabc98388fb8fac02, 0x8cb92ba72f3d8dd7}
+  };
+  Vec<T, D> result;
+  for (int i = 0; i < D; ++i) {
+    // Unsigned arithmetic wraps modulo 2^64, which takes the fractional part
+    result[i] = detail::fraction64<T>(offset_ + index * generators[D - 2][i]);
+  }
+  return result;
+}
+
+template <class T, int D>
+inline void RobertsSequence<T, D>::fill(std::uint64_t first,
+                                        Vec<T, D> *values, std::size_t size,
+                                        int concurrency) const {
+  detail::fillSequence(*this, first, values, size, concurrency);
+}
+
+template <class T, int D>
+inline void RobertsSequence<T, D>::fill(std::uint64_t first,
+                                        VecBuffer<T, D> *buffer,
+                                        int concurrency) const {
+  detail::fillSequence(*this, first, buffer, concurrency);
+}
+
+}  // namespace math
+
+using math::HaltonSequence;
+using math::SobolSequence;
+using math::RobertsSequence;
+using math::Halton2;
+using math::Halton3;
+using math::Sobol2;
+using math::Sobol3;
+using math::R2;
+using math::R3;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_SEQUENCE_H_
@@ -0,0 +1,84 @@
+//
+//  shotamatsuda/math/simd.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_SIMD_H_
+#define SHOTAMATSUDA_MATH_SIMD_H_
+
+// Instruction sets are detected from the compiler flags. Define any of these
+// to 0 before including to force the scalar code path.
+
+#ifndef SHOTAMATSUDA_HAS_SSE
+#if defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SHOTAMATSUDA_HAS_SSE 1
+#else
+#define SHOTAMATSUDA_HAS_SSE 0
+#endif
+#endif  // SHOTAMATSUDA_HAS_SSE
+
+#ifndef SHOTAMATSUDA_HAS_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHOTAMATSUDA_HAS_SSE2 SHOTAMATSUDA_HAS_SSE
+#else
+#define SHOTAMATSUDA_HAS_SSE2 0
+#endif
+#endif  // SHOTAMATSUDA_HAS_SSE2
+
+#ifndef SHOTAMATSUDA_HAS_SSE3
+#if defined(__SSE3__)
+#define SHOTAMATSUDA_HAS_SSE3 SHOTAMATSUDA_HAS_SSE2
+#else
+#define SHOTAMATSUDA_HAS_SSE3 0
+#endif
+#endif  // SHOTAMATSUDA_HAS_SSE3
+
+#ifndef SHOTAMATSUDA_HAS_SSE4_1
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define SHOTAMATSUDA_HAS_SSE4_1 SHOTAMATSUDA_HAS_SSE3
+#else
+#define SHOTAMATSUDA_HAS_SSE4_1 0
+#endif
+#endif  // SHOTAMATSUDA_HAS_SSE4_1
+
+#if SHOTAMATSUDA_HAS_SSE
+#include <xmmintrin.h>
+#endif  // SHOTAMATSUDA_HAS_SSE
+
+#if SHOTAMATSUDA_HAS_SSE2
+#include <emmintrin.h>
+#endif  // SHOTAMATSUDA_HAS_SSE2
+
+#if SHOTAMATSUDA_HAS_SSE3
+#include <pmmintrin.h>
+#endif  // SHOTAMATSUDA_HAS_SSE3
+
+#if SHOTAMATSUDA_HAS_SSE4_1
+#include <smmintrin.h>
+#endif  // SHOTAMATSUDA_HAS_SSE4_1
+
+#endif  // SHOTAMATSUDA_MATH_SIMD_H_
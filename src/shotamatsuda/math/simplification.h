@@ -0,0 +1,397 @@
+//
+//  shotamatsuda/math/simplification.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_SIMPLIFICATION_H_
+#define SHOTAMATSUDA_MATH_SIMPLIFICATION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/polyline.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Douglas-Peucker keeps the points farther than the tolerance from the lines
+// between the points kept around them. Visvalingam-Whyatt removes the points
+// whose triangles with their neighbors have areas less than the tolerance,
+// smallest first. Both keep the ends of polylines.
+enum class Simplification : int {
+  DOUGLAS_PEUCKER = 0,
+  VISVALINGAM = 1
+};
+
+inline std::ostream& operator<<(std::ostream& os, Simplification method) {
+  switch (method) {
+    case Simplification::DOUGLAS_PEUCKER: os << "douglas-peucker"; break;
+    case Simplification::VISVALINGAM: os << "visvalingam"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+// Simplifies a polyline without recursion, and replaces the result with the
+// points kept in order
+template <class T>
+void simplify(const Vec2<T> *points, std::size_t size,
+              Simplification method, Promote<T> tolerance,
+              std::vector<Vec2<T>> *result);
+template <class T>
+Polyline2<T> simplify(const Polyline2<T>& polyline,
+                      Simplification method, Promote<T> tolerance);
+
+// Simplifies independent polylines divided among at most concurrency
+// threads, where 0 means all of the hardware threads
+template <class T>
+void simplify(const Polyline2<T> *polylines, std::size_t size,
+              Simplification method, Promote<T> tolerance,
+              Polyline2<T> *results, int concurrency = 1);
+
+namespace detail {
+
+template <class T>
+struct SimplificationWorkspace {
+  // The indices of the points kept in ascending order
+  std::vector<std::size_t> indices;
+  std::vector<std::uint8_t> kept;
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  std::vector<std::size_t> previous;
+  std::vector<std::size_t> next;
+  std::vector<T> areas;
+  std::vector<std::pair<T, std::size_t>> heap;
+};
+
+}  // namespace detail
+
+// Simplifies a polyline whose points arrive in chunks, holding at most the
+// capacity of them at once. Each window of points is simplified on its own,
+// and the points after the next to last one kept are carried over to the
+// next window, unless that would leave less than half of it consumed. The
+// result meets the tolerance as with simplify(), but differs from
+// simplifying the polyline at once near the boundaries of the windows.
+template <class T>
+class Simplifier final {
+ public:
+  using Type = T;
+  using Real = Promote<T>;
+
+ public:
+  Simplifier(Simplification method, Real tolerance,
+             std::size_t capacity = 4096);
+
+  // Copy semantics
+  Simplifier(const Simplifier&) = default;
+  Simplifier& operator=(const Simplifier&) = default;
+
+  // Attributes
+  Simplification method() const { return method_; }
+  Real tolerance() const { return tolerance_; }
+  std::size_t capacity() const { return capacity_; }
+
+  // Consumes the points, and appends the points kept that are final to the
+  // result, which the caller may clear between chunks
+  void push(const Vec2<T> *points, std::size_t size,
+            std::vector<Vec2<T>> *result);
+
+  // Appends the rest of the points kept, and starts a new polyline
+  void finish(std::vector<Vec2<T>> *result);
+
+ private:
+  void flush(bool last, std::vector<Vec2<T>> *result);
+
+ private:
+  Simplification method_;
+  Real tolerance_;
+  std::size_t capacity_;
+  std::vector<Vec2<T>> buffer_;
+  detail::SimplificationWorkspace<Real> workspace_;
+};
+
+// MARK: -
+
+namespace detail {
+
+template <class T>
+inline void douglasPeucker(const Vec2<T> *points, std::size_t size,
+                           Promote<T> tolerance,
+                           SimplificationWorkspace<Promote<T>> *workspace) {
+  using Real = Promote<T>;
+  auto& kept = workspace->kept;
+  auto& ranges = workspace->ranges;
+  kept.assign(size, false);
+  kept.front() = kept.back() = true;
+  ranges.clear();
+  ranges.emplace_back(0, size - 1);
+  const auto threshold = tolerance * tolerance;
+  while (!ranges.empty()) {
+    const auto range = ranges.back();
+    ranges.pop_back();
+    const Line2<Real> line(points[range.first], points[range.second]);
+    auto farthest = range.first;
+    auto distance = threshold;
+    for (auto index = range.first + 1; index < range.second; ++index) {
+      const Vec2<Real> point(points[index]);
+      const auto candidate = point.distanceSquared(line.project(point));
+      if (candidate > distance) {
+        farthest = index;
+        distance = candidate;
+      }
+    }
+    if (farthest != range.first) {
+      kept[farthest] = true;
+      ranges.emplace_back(range.first, farthest);
+      ranges.emplace_back(farthest, range.second);
+    }
+  }
+}
+
+template <class T>
+inline Promote<T> visvalingamArea(const Vec2<T>& a, const Vec2<T>& b,
+                                  const Vec2<T>& c) {
+  using Real = Promote<T>;
+  return std::abs((Vec2<Real>(b) - Vec2<Real>(a)).cross(
+      Vec2<Real>(c) - Vec2<Real>(a))) / 2;
+}
+
+template <class T>
+inline void visvalingam(const Vec2<T> *points, std::size_t size,
+                        Promote<T> tolerance,
+                        SimplificationWorkspace<Promote<T>> *workspace) {
+  auto& kept = workspace->kept;
+  auto& previous = workspace->previous;
+  auto& next = workspace->next;
+  auto& areas = workspace->areas;
+  auto& heap = workspace->heap;
+  kept.assign(size, true);
+  previous.resize(size);
+  next.resize(size);
+  areas.resize(size);
+  heap.clear();
+  for (std::size_t index = 1; index + 1 < size; ++index) {
+    previous[index] = index - 1;
+    next[index] = index + 1;
+    areas[index] = visvalingamArea(points[index - 1], points[index],
+                                   points[index + 1]);
+    heap.emplace_back(areas[index], index);
+  }
+  const std::greater<std::pair<Promote<T>, std::size_t>> compare;
+  std::make_heap(heap.begin(), heap.end(), compare);
+  while (!heap.empty() && heap.front().first < tolerance) {
+    const auto area = heap.front().first;
+    const auto index = heap.front().second;
+    std::pop_heap(heap.begin(), heap.end(), compare);
+    heap.pop_back();
+    // Entries of removed points and stale areas remain in the heap
+    if (!kept[index] || area != areas[index]) {
+      continue;
+    }
+    kept[index] = false;
+    const auto before = previous[index];
+    const auto after = next[index];
+    next[before] = after;
+    previous[after] = before;
+    // Areas never decrease below that of the point removed, so that points
+    // are removed in the order of their areas
+    for (const auto neighbor : {before, after}) {
+      if (neighbor && neighbor + 1 < size) {
+        areas[neighbor] = std::max(area, visvalingamArea(
+            points[previous[neighbor]], points[neighbor],
+            points[next[neighbor]]));
+        heap.emplace_back(areas[neighbor], neighbor);
+        std::push_heap(heap.begin(), heap.end(), compare);
+      }
+    }
+  }
+}
+
+// Fills the indices of the workspace with the points kept
+template <class T>
+inline void simplify(const Vec2<T> *points, std::size_t size,
+                     Simplification method, Promote<T> tolerance,
+                     SimplificationWorkspace<Promote<T>> *workspace) {
+  auto& indices = workspace->indices;
+  indices.clear();
+  if (size < 3) {
+    for (std::size_t index = 0; index < size; ++index) {
+      indices.push_back(index);
+    }
+    return;
+  }
+  switch (method) {
+    case Simplification::DOUGLAS_PEUCKER:
+      douglasPeucker(points, size, tolerance, workspace);
+      break;
+    case Simplification::VISVALINGAM:
+      visvalingam(points, size, tolerance, workspace);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+  for (std::size_t index = 0; index < size; ++index) {
+    if (workspace->kept[index]) {
+      indices.push_back(index);
+    }
+  }
+}
+
+template <class T>
+inline void simplify(const Vec2<T> *points, std::size_t size,
+                     Simplification method, Promote<T> tolerance,
+                     SimplificationWorkspace<Promote<T>> *workspace,
+                     std::vector<Vec2<T>> *result) {
+  simplify(points, size, method, tolerance, workspace);
+  result->clear();
+  result->reserve(workspace->indices.size());
+  for (const auto index : workspace->indices) {
+    result->push_back(points[index]);
+  }
+}
+
+}  // namespace detail
+
+template <class T>
+inline void simplify(const Vec2<T> *points, std::size_t size,
+                     Simplification method, Promote<T> tolerance,
+                     std::vector<Vec2<T>> *result) {
+  assert(points || !size);
+  assert(result);
+  detail::SimplificationWorkspace<Promote<T>> workspace;
+  detail::simplify(points, size, method, tolerance, &workspace, result);
+}
+
+template <class T>
+inline Polyline2<T> simplify(const Polyline2<T>& polyline,
+                             Simplification method, Promote<T> tolerance) {
+  std::vector<Vec2<T>> result;
+  simplify(polyline.data(), polyline.size(), method, tolerance, &result);
+  return Polyline2<T>(std::move(result));
+}
+
+template <class T>
+inline void simplify(const Polyline2<T> *polylines, std::size_t size,
+                     Simplification method, Promote<T> tolerance,
+                     Polyline2<T> *results, int concurrency) {
+  assert(polylines || !size);
+  assert(results || !size);
+  const int chunks = chunkCount(size, concurrency, 16);
+  parallelFor(size, chunks, [&](std::size_t first, std::size_t last, int) {
+    detail::SimplificationWorkspace<Promote<T>> workspace;
+    for (auto index = first; index < last; ++index) {
+      std::vector<Vec2<T>> result;
+      detail::simplify(polylines[index].data(), polylines[index].size(),
+                       method, tolerance, &workspace, &result);
+      results[index] = Polyline2<T>(std::move(result));
+    }
+  });
+}
+
+// MARK: Simplifier
+
+template <class T>
+inline Simplifier<T>::Simplifier(Simplification method, Real tolerance,
+                                 std::size_t capacity)
+    : method_(method),
+      tolerance_(tolerance),
+      capacity_(capacity) {
+  assert(capacity >= 3);
+  buffer_.reserve(capacity);
+}
+
+template <class T>
+inline void Simplifier<T>::push(const Vec2<T> *points, std::size_t size,
+                                std::vector<Vec2<T>> *result) {
+  assert(points || !size);
+  assert(result);
+  while (size) {
+    const auto count = std::min(size, capacity_ - buffer_.size());
+    buffer_.insert(buffer_.end(), points, points + count);
+    points += count;
+    size -= count;
+    if (buffer_.size() == capacity_) {
+      flush(false, result);
+    }
+  }
+}
+
+template <class T>
+inline void Simplifier<T>::finish(std::vector<Vec2<T>> *result) {
+  assert(result);
+  flush(true, result);
+  buffer_.clear();
+}
+
+template <class T>
+inline void Simplifier<T>::flush(bool last, std::vector<Vec2<T>> *result) {
+  detail::simplify(buffer_.data(), buffer_.size(), method_, tolerance_,
+                   &workspace_);
+  const auto& indices = workspace_.indices;
+  auto end = indices.size();
+  std::size_t carried = 0;
+  if (!last) {
+    // The next to last point kept may move once the points after the window
+    // are known, unless carrying the points after it would leave the window
+    // less than half consumed
+    carried = indices[indices.size() - 2];
+    if (indices.size() > 2 && carried >= buffer_.size() / 2) {
+      end -= 2;
+    } else {
+      carried = indices.back();
+      end -= 1;
+    }
+  }
+  // The first point in the buffer is either the first of the polyline or
+  // one carried over, and has not been appended yet
+  for (std::size_t index = 0; index < end; ++index) {
+    result->push_back(buffer_[indices[index]]);
+  }
+  buffer_.erase(buffer_.begin(), buffer_.begin() + carried);
+}
+
+}  // namespace math
+
+using math::Simplification;
+using math::Simplifier;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_SIMPLIFICATION_H_
@@ -54,6 +54,7 @@
 
 #include "shotamatsuda/math/axis.h"
 #include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/vector.h"
 
@@ -79,17 +80,17 @@ class Size<T, 2> final {
   static constexpr const auto dimensions = Vec2<T>::dimensions;
 
  public:
-  Size();
-  explicit Size(T value);
-  Size(T width, T height);
-  explicit Size(const T *values, int size = 2);
+  constexpr Size();
+  explicit constexpr Size(T value);
+  constexpr Size(T width, T height);
+  explicit constexpr Size(const T *values, int size = 2);
   template <class... Args>
   Size(const std::tuple<Args...>& tuple);
-  Size(std::initializer_list<T> list);
+  constexpr Size(std::initializer_list<T> list);
 
   // Implicit conversion
   template <class U>
-  Size(const Size2<U>& other);
+  constexpr Size(const Size2<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -104,10 +105,10 @@ class Size<T, 2> final {
 
   // Explicit conversion
   template <class U>
-  explicit Size(const Size3<U>& other);
-  explicit Size(const Vec2<T>& other);
-  explicit Size(const Vec3<T>& other);
-  explicit Size(const Vec4<T>& other);
+  explicit constexpr Size(const Size3<U>& other);
+  explicit constexpr Size(const Vec2<T>& other);
+  explicit constexpr Size(const Vec3<T>& other);
+  explicit constexpr Size(const Vec4<T>& other);
 
 #if SHOTAMATSUDA_HAS_OPENFRAMEWORKS
   explicit Size(const ofVec2f& other);
@@ -125,8 +126,8 @@ class Size<T, 2> final {
   Size& operator=(const Size&) = default;
 
   // Factory
-  static Size min();
-  static Size max();
+  static constexpr Size min();
+  static constexpr Size max();
   static Size random();
   static Size random(T max);
   static Size random(T min, T max);
@@ -138,50 +139,50 @@ class Size<T, 2> final {
   static Size random(T min, T max, Random *random);
 
   // Mutators
-  void set(T value);
-  void set(T width, T height);
-  void set(const T *values, int size = 2);
+  constexpr void set(T value);
+  constexpr void set(T width, T height);
+  constexpr void set(const T *values, int size = 2);
   template <class... Args>
   void set(const std::tuple<Args...>& tuple);
-  void set(std::initializer_list<T> list);
-  void reset();
+  constexpr void set(std::initializer_list<T> list);
+  constexpr void reset();
 
   // Element access
-  T& operator[](int index) { return at(index); }
-  const T& operator[](int index) const { return at(index); }
-  T& operator[](Axis axis) { return at(axis); }
-  const T& operator[](Axis axis) const { return at(axis); }
-  T& at(int index);
-  const T& at(int index) const;
-  T& at(Axis axis);
-  const T& at(Axis axis) const;
-  T& front() { return vector.front(); }
-  const T& front() const { return vector.front(); }
-  T& back() { return vector.back(); }
-  const T& back() const { return vector.back(); }
+  constexpr T& operator[](int index) { return at(index); }
+  constexpr const T& operator[](int index) const { return at(index); }
+  constexpr T& operator[](Axis axis) { return at(axis); }
+  constexpr const T& operator[](Axis axis) const { return at(axis); }
+  constexpr T& at(int index);
+  constexpr const T& at(int index) const;
+  constexpr T& at(Axis axis);
+  constexpr const T& at(Axis axis) const;
+  constexpr T& front() { return vector.front(); }
+  constexpr const T& front() const { return vector.front(); }
+  constexpr T& back() { return vector.back(); }
+  constexpr const T& back() const { return vector.back(); }
 
   // Comparison
   template <class V, class U = T>
   bool equals(const Size2<U>& other, V tolerance) const;
 
   // Arithmetic
-  Size& operator+=(const Size& other);
-  Size& operator-=(const Size& other);
-  Size& operator*=(const Size& other);
-  Size& operator/=(const Size& other);
-  Size2<Promote<T>> operator-() const;
+  constexpr Size& operator+=(const Size& other);
+  constexpr Size& operator-=(const Size& other);
+  constexpr Size& operator*=(const Size& other);
+  constexpr Size& operator/=(const Size& other);
+  constexpr Size2<Promote<T>> operator-() const;
 
   // Scalar arithmetic
-  Size& operator+=(T scalar);
-  Size& operator-=(T scalar);
-  Size& operator*=(T scalar);
-  Size& operator/=(T scalar);
+  constexpr Size& operator+=(T scalar);
+  constexpr Size& operator-=(T scalar);
+  constexpr Size& operator*=(T scalar);
+  constexpr Size& operator/=(T scalar);
 
   // Vector arithmetic
-  Size& operator+=(const Vec2<T>& other);
-  Size& operator-=(const Vec2<T>& other);
-  Size& operator*=(const Vec2<T>& other);
-  Size& operator/=(const Vec2<T>& other);
+  constexpr Size& operator+=(const Vec2<T>& other);
+  constexpr Size& operator-=(const Vec2<T>& other);
+  constexpr Size& operator*=(const Vec2<T>& other);
+  constexpr Size& operator/=(const Vec2<T>& other);
 
   // Attributes
   bool empty() const { return !width && !height; }
@@ -219,63 +220,75 @@ class Size<T, 2> final {
 
 // Comparison
 template <class T, class U>
-bool operator==(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator==(const Size2<T>& lhs, const Size2<U>& rhs);
 template <class T, class U>
-bool operator!=(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator!=(const Size2<T>& lhs, const Size2<U>& rhs);
 template <class T, class U>
-bool operator<(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator<(const Size2<T>& lhs, const Size2<U>& rhs);
 template <class T, class U>
-bool operator>(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator>(const Size2<T>& lhs, const Size2<U>& rhs);
 template <class T, class U>
-bool operator<=(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator<=(const Size2<T>& lhs, const Size2<U>& rhs);
 template <class T, class U>
-bool operator>=(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr bool operator>=(const Size2<T>& lhs, const Size2<U>& rhs);
 
 // Arithmetic
 template <class T, class U>
-Size2<Promote<T, U>> operator+(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs,
+                                         const Size2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator-(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs,
+                                         const Size2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator*(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs,
+                                         const Size2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator/(const Size2<T>& lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs,
+                                         const Size2<U>& rhs);
 
 // Scalar arithmetic
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Size2<Promote<T, U>> operator+(const Size2<T>& lhs, U rhs);
+constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Size2<Promote<T, U>> operator-(const Size2<T>& lhs, U rhs);
+constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Size2<Promote<T, U>> operator*(const Size2<T>& lhs, U rhs);
+constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Size2<Promote<T, U>> operator/(const Size2<T>& lhs, U rhs);
+constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Size2<Promote<T, U>> operator+(T lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator+(T lhs, const Size2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Size2<Promote<T, U>> operator-(T lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator-(T lhs, const Size2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Size2<Promote<T, U>> operator*(T lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator*(T lhs, const Size2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Size2<Promote<T, U>> operator/(T lhs, const Size2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator/(T lhs, const Size2<U>& rhs);
 
 // Vector arithmetic
 template <class T, class U>
-Size2<Promote<T, U>> operator+(const Size2<T>& lhs, const Vec2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs,
+                                         const Vec2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator-(const Size2<T>& lhs, const Vec2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs,
+                                         const Vec2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator*(const Size2<T>& lhs, const Vec2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs,
+                                         const Vec2<U>& rhs);
 template <class T, class U>
-Size2<Promote<T, U>> operator/(const Size2<T>& lhs, const Vec2<U>& rhs);
+constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs,
+                                         const Vec2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, const Size2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs,
+                                        const Size2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, const Size2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs,
+                                        const Size2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, const Size2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs,
+                                        const Size2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Size2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs,
+                                        const Size2<U>& rhs);
 
 using Size2i = Size2<int>;
 using Size2f = Size2<float>;
@@ -284,29 +297,32 @@ using Size2d = Size2<double>;
 // MARK: -
 
 template <class T>
-inline Size<T, 2>::Size() : vector() {}
+inline constexpr Size<T, 2>::Size() : vector() {}
 
 template <class T>
-inline Size<T, 2>::Size(T value) : vector(value) {}
+inline constexpr Size<T, 2>::Size(T value) : vector(value) {}
 
 template <class T>
-inline Size<T, 2>::Size(T width, T height) : vector(width, height) {}
+inline constexpr Size<T, 2>::Size(T width, T height) : vector(width, height) {}
 
 template <class T>
-inline Size<T, 2>::Size(const T *values, int size) : vector(values, size) {}
+inline constexpr Size<T, 2>::Size(const T *values, int size)
+    : vector(values, size) {}
 
 template <class T>
 template <class... Args>
 inline Size<T, 2>::Size(const std::tuple<Args...>& tuple) : vector(tuple) {}
 
 template <class T>
-inline Size<T, 2>::Size(std::initializer_list<T> list) : vector(list) {}
+inline constexpr Size<T, 2>::Size(std::initializer_list<T> list)
+    : vector(list) {}
 
 // MARK: Implicit conversion
 
 template <class T>
 template <class U>
-inline Size<T, 2>::Size(const Size2<U>& other) : vector(other.vector) {}
+inline constexpr Size<T, 2>::Size(const Size2<U>& other)
+    : vector(other.vector) {}
 
 #if SHOTAMATSUDA_HAS_OPENCV
 
@@ -339,16 +355,17 @@ inline Size<T, 2>::operator CGSize() const {
 
 template <class T>
 template <class U>
-inline Size<T, 2>::Size(const Size3<U>& other) : vector(other.vector) {}
+inline constexpr Size<T, 2>::Size(const Size3<U>& other)
+    : vector(other.vector) {}
 
 template <class T>
-inline Size<T, 2>::Size(const Vec2<T>& other) : vector(other) {}
+inline constexpr Size<T, 2>::Size(const Vec2<T>& other) : vector(other) {}
 
 template <class T>
-inline Size<T, 2>::Size(const Vec3<T>& other) : vector(other) {}
+inline constexpr Size<T, 2>::Size(const Vec3<T>& other) : vector(other) {}
 
 template <class T>
-inline Size<T, 2>::Size(const Vec4<T>& other) : vector(other) {}
+inline constexpr Size<T, 2>::Size(const Vec4<T>& other) : vector(other) {}
 
 #if SHOTAMATSUDA_HAS_OPENFRAMEWORKS
 
@@ -378,28 +395,28 @@ inline Size<T, 2>::operator ci::Vec2<T>() const {
 // MARK: Factory
 
 template <class T>
-inline Size2<T> Size<T, 2>::min() {
+inline constexpr Size2<T> Size<T, 2>::min() {
   return Size(Vec2<T>::min());
 }
 
 template <class T>
-inline Size2<T> Size<T, 2>::max() {
+inline constexpr Size2<T> Size<T, 2>::max() {
   return Size(Vec2<T>::max());
 }
 
 template <class T>
 inline Size2<T> Size<T, 2>::random() {
-  return random(&Random<>::shared());
+  return random(&Random<>::local());
 }
 
 template <class T>
 inline Size2<T> Size<T, 2>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &Random<>::local());
 }
 
 template <class T>
 inline Size2<T> Size<T, 2>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &Random<>::local());
 }
 
 template <class T>
@@ -423,17 +440,17 @@ inline Size2<T> Size<T, 2>::random(T min, T max, Random *random) {
 // MARK: Mutators
 
 template <class T>
-inline void Size<T, 2>::set(T value) {
+inline constexpr void Size<T, 2>::set(T value) {
   vector.set(value);
 }
 
 template <class T>
-inline void Size<T, 2>::set(T width, T height) {
+inline constexpr void Size<T, 2>::set(T width, T height) {
   vector.set(width, height);
 }
 
 template <class T>
-inline void Size<T, 2>::set(const T *values, int size) {
+inline constexpr void Size<T, 2>::set(const T *values, int size) {
   vector.set(values, size);
 }
 
@@ -444,66 +461,66 @@ inline void Size<T, 2>::set(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline void Size<T, 2>::set(std::initializer_list<T> list) {
+inline constexpr void Size<T, 2>::set(std::initializer_list<T> list) {
   vector.set(list);
 }
 
 template <class T>
-inline void Size<T, 2>::reset() {
+inline constexpr void Size<T, 2>::reset() {
   vector.reset();
 }
 
 // MARK: Element access
 
 template <class T>
-inline T& Size<T, 2>::at(int index) {
+inline constexpr T& Size<T, 2>::at(int index) {
   return vector.at(index);
 }
 
 template <class T>
-inline const T& Size<T, 2>::at(int index) const {
+inline constexpr const T& Size<T, 2>::at(int index) const {
   return vector.at(index);
 }
 
 template <class T>
-inline T& Size<T, 2>::at(Axis axis) {
+inline constexpr T& Size<T, 2>::at(Axis axis) {
   return at(static_cast<int>(axis));
 }
 
 template <class T>
-inline const T& Size<T, 2>::at(Axis axis) const {
+inline constexpr const T& Size<T, 2>::at(Axis axis) const {
   return at(static_cast<int>(axis));
 }
 
 // MARK: Comparison
 
 template <class T, class U>
-inline bool operator==(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator==(const Size2<T>& lhs, const Size2<U>& rhs) {
   return lhs.vector == rhs.vector;
 }
 
 template <class T, class U>
-inline bool operator!=(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator!=(const Size2<T>& lhs, const Size2<U>& rhs) {
   return lhs.vector != rhs.vector;
 }
 
 template <class T, class U>
-inline bool operator<(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator<(const Size2<T>& lhs, const Size2<U>& rhs) {
   return operator<(lhs.vector, rhs.vector);
 }
 
 template <class T, class U>
-inline bool operator>(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator>(const Size2<T>& lhs, const Size2<U>& rhs) {
   return operator>(lhs.vector, rhs.vector);
 }
 
 template <class T, class U>
-inline bool operator<=(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator<=(const Size2<T>& lhs, const Size2<U>& rhs) {
   return lhs.vector <= rhs.vector;
 }
 
 template <class T, class U>
-inline bool operator>=(const Size2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr bool operator>=(const Size2<T>& lhs, const Size2<U>& rhs) {
   return lhs.vector >= rhs.vector;
 }
 
@@ -516,187 +533,195 @@ inline bool Size<T, 2>::equals(const Size2<U>& other, V tolerance) const {
 // MARK: Arithmetic
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator+=(const Size& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator+=(const Size& other) {
   vector += other.vector;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator-=(const Size& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator-=(const Size& other) {
   vector -= other.vector;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator*=(const Size& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator*=(const Size& other) {
   vector *= other.vector;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator/=(const Size& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator/=(const Size& other) {
   vector /= other.vector;
   return *this;
 }
 
 template <class T>
-inline Size2<Promote<T>> Size<T, 2>::operator-() const {
+inline constexpr Size2<Promote<T>> Size<T, 2>::operator-() const {
   return Size2<Promote<T>>(-vector);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator+(const Size2<T>& lhs,
-                                      const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs,
+                                                const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector + rhs.vector);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator-(const Size2<T>& lhs,
-                                      const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs,
+                                                const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector - rhs.vector);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator*(const Size2<T>& lhs,
-                                      const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs,
+                                                const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector * rhs.vector);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator/(const Size2<T>& lhs,
-                                      const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs,
+                                                const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector / rhs.vector);
 }
 
 // MARK: Scalar arithmetic
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator+=(T scalar) {
+inline constexpr Size2<T>& Size<T, 2>::operator+=(T scalar) {
   vector += scalar;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator-=(T scalar) {
+inline constexpr Size2<T>& Size<T, 2>::operator-=(T scalar) {
   vector -= scalar;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator*=(T scalar) {
+inline constexpr Size2<T>& Size<T, 2>::operator*=(T scalar) {
   vector *= scalar;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator/=(T scalar) {
+inline constexpr Size2<T>& Size<T, 2>::operator/=(T scalar) {
   vector /= scalar;
   return *this;
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Size2<Promote<T, U>> operator+(const Size2<T>& lhs, U rhs) {
+inline constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs, U rhs) {
   return Size2<Promote<T, U>>(lhs.vector + rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Size2<Promote<T, U>> operator-(const Size2<T>& lhs, U rhs) {
+inline constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs, U rhs) {
   return Size2<Promote<T, U>>(lhs.vector - rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Size2<Promote<T, U>> operator*(const Size2<T>& lhs, U rhs) {
+inline constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs, U rhs) {
   return Size2<Promote<T, U>>(lhs.vector * rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Size2<Promote<T, U>> operator/(const Size2<T>& lhs, U rhs) {
+inline constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs, U rhs) {
   return Size2<Promote<T, U>>(lhs.vector / rhs);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Size2<Promote<T, U>> operator+(T lhs, const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator+(T lhs, const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs + rhs.vector);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Size2<Promote<T, U>> operator-(T lhs, const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator-(T lhs, const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs - rhs.vector);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Size2<Promote<T, U>> operator*(T lhs, const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator*(T lhs, const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs * rhs.vector);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Size2<Promote<T, U>> operator/(T lhs, const Size2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator/(T lhs, const Size2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs / rhs.vector);
 }
 
 // MARK: Vector arithmetic
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator+=(const Vec2<T>& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator+=(const Vec2<T>& other) {
   vector += other;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator-=(const Vec2<T>& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator-=(const Vec2<T>& other) {
   vector -= other;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator*=(const Vec2<T>& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator*=(const Vec2<T>& other) {
   vector *= other;
   return *this;
 }
 
 template <class T>
-inline Size2<T>& Size<T, 2>::operator/=(const Vec2<T>& other) {
+inline constexpr Size2<T>& Size<T, 2>::operator/=(const Vec2<T>& other) {
   vector /= other;
   return *this;
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator+(const Size2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator+(const Size2<T>& lhs,
+                                                const Vec2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector + rhs);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator-(const Size2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator-(const Size2<T>& lhs,
+                                                const Vec2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector - rhs);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator*(const Size2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator*(const Size2<T>& lhs,
+                                                const Vec2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector * rhs);
 }
 
 template <class T, class U>
-inline Size2<Promote<T, U>> operator/(const Size2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Size2<Promote<T, U>> operator/(const Size2<T>& lhs,
+                                                const Vec2<U>& rhs) {
   return Size2<Promote<T, U>>(lhs.vector / rhs);
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs,
+                                               const Size2<U>& rhs) {
   return lhs + rhs.vector;
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs,
+                                               const Size2<U>& rhs) {
   return lhs - rhs.vector;
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs,
+                                               const Size2<U>& rhs) {
   return lhs * rhs.vector;
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Size2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs,
+                                               const Size2<U>& rhs) {
   return lhs / rhs.vector;
 }
 
@@ -737,8 +762,7 @@ using math::Size2d;
 template <class T>
 struct std::hash<shotamatsuda::math::Size2<T>> {
   std::size_t operator()(const shotamatsuda::math::Size2<T>& value) const {
-    std::hash<T> hash;
-    return (hash(value.w) << 0) ^ (hash(value.h) << 1);
+    return shotamatsuda::math::hash(value.w, value.h);
   }
 };
 
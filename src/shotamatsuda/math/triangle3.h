@@ -28,6 +28,7 @@
 #ifndef SHOTAMATSUDA_MATH_TRIANGLE3_H_
 #define SHOTAMATSUDA_MATH_TRIANGLE3_H_
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -36,6 +37,8 @@
 #include <iterator>
 #include <ostream>
 
+#include "shotamatsuda/math/hash.h"
+#include "shotamatsuda/math/random.h"
 #include "shotamatsuda/math/vector.h"
 
 namespace shotamatsuda {
@@ -105,6 +108,15 @@ class Triangle<T, 3> final {
   Promote<T> perimeter() const;
   Vec3<Promote<T>> centroid() const;
 
+  // Sampling of uniformly distributed points on the triangle
+  Vec3<Promote<T>> randomPoint() const;
+  template <class Random>
+  Vec3<Promote<T>> randomPoint(Random *random) const;
+  void randomPoints(Vec3<Promote<T>> *points, std::size_t size) const;
+  template <class Random>
+  void randomPoints(Vec3<Promote<T>> *points, std::size_t size,
+                    Random *random) const;
+
   // Iterator
   Iterator begin() { return &a; }
   ConstIterator begin() const { return &a; }
@@ -323,6 +335,61 @@ inline Vec3<Promote<T>> Triangle<T, 3>::centroid() const {
   return (a + b + c) / 3;
 }
 
+// MARK: Sampling
+
+template <class T>
+inline Vec3<Promote<T>> Triangle<T, 3>::randomPoint() const {
+  return randomPoint(&Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline Vec3<Promote<T>> Triangle<T, 3>::randomPoint(Random *random) const {
+  assert(random);
+  using Real = Promote<T>;
+  auto s = random->template uniform<Real>(0, 1);
+  auto t = random->template uniform<Real>(0, 1);
+  // Reflects the other half of the parallelogram onto the triangle
+  if (s + t > 1) {
+    s = 1 - s;
+    t = 1 - t;
+  }
+  return Vec3<Real>(x1 + (x2 - x1) * s + (x3 - x1) * t,
+                    y1 + (y2 - y1) * s + (y3 - y1) * t,
+                    z1 + (z2 - z1) * s + (z3 - z1) * t);
+}
+
+template <class T>
+inline void Triangle<T, 3>::randomPoints(Vec3<Promote<T>> *points,
+                                         std::size_t size) const {
+  randomPoints(points, size, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Triangle<T, 3>::randomPoints(Vec3<Promote<T>> *points,
+                                         std::size_t size,
+                                         Random *random) const {
+  assert(points || !size);
+  assert(random);
+  using Real = Promote<T>;
+  const Vec3<Real> u(x2 - x1, y2 - y1, z2 - z1);
+  const Vec3<Real> v(x3 - x1, y3 - y1, z3 - z1);
+  Real uniforms[detail::kRandomBlock * 2];
+  for (std::size_t first = 0; first < size; first += detail::kRandomBlock) {
+    const auto count = std::min(detail::kRandomBlock, size - first);
+    random->fillUniform(uniforms, count * 2, Real(0), Real(1));
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto reflect = uniforms[i] + uniforms[count + i] > 1;
+      const auto s = reflect ? 1 - uniforms[i] : uniforms[i];
+      const auto t = reflect ? 1 - uniforms[count + i] : uniforms[count + i];
+      points[first + i].x = x1 + u.x * s + v.x * t;
+      points[first + i].y = y1 + u.y * s + v.y * t;
+      points[first + i].z = z1 + u.z * s + v.z * t;
+    }
+  }
+}
+
 // MARK: Stream
 
 template <class T>
@@ -343,8 +410,7 @@ using math::Triangle3d;
 template <class T>
 struct std::hash<shotamatsuda::math::Triangle3<T>> {
   std::size_t operator()(const shotamatsuda::math::Triangle3<T>& value) const {
-    std::hash<shotamatsuda::math::Vec3<T>> hash;
-    return (hash(value.a) << 0) ^ (hash(value.b) << 1) ^ (hash(value.c) << 1);
+    return shotamatsuda::math::hash(value.a, value.b, value.c);
   }
 };
 
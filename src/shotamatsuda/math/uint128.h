@@ -0,0 +1,76 @@
+//
+//  shotamatsuda/math/uint128.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_UINT128_H_
+#define SHOTAMATSUDA_MATH_UINT128_H_
+
+#include <cstdint>
+
+namespace shotamatsuda {
+namespace math {
+namespace detail {
+
+// Unsigned 128-bit integer in two words with wrapping arithmetic, which does
+// not depend on unsigned __int128
+struct UInt128 {
+  std::uint64_t high;
+  std::uint64_t low;
+};
+
+inline UInt128 add(const UInt128& lhs, const UInt128& rhs) {
+  const auto low = lhs.low + rhs.low;
+  return {lhs.high + rhs.high + (low < lhs.low), low};
+}
+
+// High 64 bits of the 128-bit product
+inline std::uint64_t multiplyHigh(std::uint64_t lhs, std::uint64_t rhs) {
+#if defined(__SIZEOF_INT128__)
+  return static_cast<std::uint64_t>(
+      static_cast<unsigned __int128>(lhs) * rhs >> 64);
+#else
+  const auto lhs_low = lhs & 0xffffffff;
+  const auto lhs_high = lhs >> 32;
+  const auto rhs_low = rhs & 0xffffffff;
+  const auto rhs_high = rhs >> 32;
+  const auto low = lhs_low * rhs_low;
+  const auto middle1 = lhs_high * rhs_low + (low >> 32);
+  const auto middle2 = lhs_low * rhs_high + (middle1 & 0xffffffff);
+  return lhs_high * rhs_high + (middle1 >> 32) + (middle2 >> 32);
+#endif  // defined(__SIZEOF_INT128__)
+}
+
+inline UInt128 multiply(const UInt128& lhs, const UInt128& rhs) {
+  return {multiplyHigh(lhs.low, rhs.low) +
+          lhs.high * rhs.low + lhs.low * rhs.high,
+          lhs.low * rhs.low};
+}
+
+}  // namespace detail
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_UINT128_H_
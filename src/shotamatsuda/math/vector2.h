@@ -56,8 +56,10 @@
 
 #include "shotamatsuda/math/axis.h"
 #include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rsqrt.h"
 
 namespace shotamatsuda {
 namespace math {
@@ -83,17 +85,17 @@ class Vec<T, 2> final {
   static constexpr const int dimensions = 2;
 
  public:
-  Vec();
-  explicit Vec(T value);
-  Vec(T x, T y);
-  explicit Vec(const T *values, int size = 2);
+  constexpr Vec();
+  explicit constexpr Vec(T value);
+  constexpr Vec(T x, T y);
+  explicit constexpr Vec(const T *values, int size = 2);
   template <class... Args>
   Vec(const std::tuple<Args...>& tuple);
-  Vec(std::initializer_list<T> list);
+  constexpr Vec(std::initializer_list<T> list);
 
   // Implicit conversion
   template <class U>
-  Vec(const Vec2<U>& other);
+  constexpr Vec(const Vec2<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -121,9 +123,9 @@ class Vec<T, 2> final {
 
   // Explicit conversion
   template <class U>
-  explicit Vec(const Vec3<U>& other);
+  explicit constexpr Vec(const Vec3<U>& other);
   template <class U>
-  explicit Vec(const Vec4<U>& other);
+  explicit constexpr Vec(const Vec4<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -137,8 +139,8 @@ class Vec<T, 2> final {
   Vec& operator=(const Vec&) = default;
 
   // Factory
-  static Vec min();
-  static Vec max();
+  static constexpr Vec min();
+  static constexpr Vec max();
   static Vec heading(Promote<T> angle);
   static Vec random();
   static Vec random(T max);
@@ -149,46 +151,50 @@ class Vec<T, 2> final {
   static Vec random(T max, Random *random);
   template <class Random>
   static Vec random(T min, T max, Random *random);
+  static void random(Vec *values, std::size_t size, T min, T max);
+  template <class Random>
+  static void random(Vec *values, std::size_t size, T min, T max,
+                     Random *random);
 
   // Mutators
-  void set(T value);
-  void set(T x, T y);
-  void set(const T *values, int size = 2);
+  constexpr void set(T value);
+  constexpr void set(T x, T y);
+  constexpr void set(const T *values, int size = 2);
   template <class... Args>
   void set(const std::tuple<Args...>& tuple);
-  void set(std::initializer_list<T> list);
-  void reset();
+  constexpr void set(std::initializer_list<T> list);
+  constexpr void reset();
 
   // Element access
-  T& operator[](int index) { return at(index); }
-  const T& operator[](int index) const { return at(index); }
-  T& operator[](Axis axis) { return at(axis); }
-  const T& operator[](Axis axis) const { return at(axis); }
-  T& at(int index);
-  const T& at(int index) const;
-  T& at(Axis axis);
-  const T& at(Axis axis) const;
-  T& front() { return x; }
-  const T& front() const { return x; }
-  T& back() { return y; }
-  const T& back() const { return y; }
+  constexpr T& operator[](int index) { return at(index); }
+  constexpr const T& operator[](int index) const { return at(index); }
+  constexpr T& operator[](Axis axis) { return at(axis); }
+  constexpr const T& operator[](Axis axis) const { return at(axis); }
+  constexpr T& at(int index);
+  constexpr const T& at(int index) const;
+  constexpr T& at(Axis axis);
+  constexpr const T& at(Axis axis) const;
+  constexpr T& front() { return x; }
+  constexpr const T& front() const { return x; }
+  constexpr T& back() { return y; }
+  constexpr const T& back() const { return y; }
 
   // Comparison
   template <class V, class U = T>
   bool equals(const Vec2<U>& other, V tolerance) const;
 
   // Arithmetic
-  Vec& operator+=(const Vec& other);
-  Vec& operator-=(const Vec& other);
-  Vec& operator*=(const Vec& other);
-  Vec& operator/=(const Vec& other);
-  Vec2<Promote<T>> operator-() const;
+  constexpr Vec& operator+=(const Vec& other);
+  constexpr Vec& operator-=(const Vec& other);
+  constexpr Vec& operator*=(const Vec& other);
+  constexpr Vec& operator/=(const Vec& other);
+  constexpr Vec2<Promote<T>> operator-() const;
 
   // Scalar arithmetic
-  Vec& operator+=(T scalar);
-  Vec& operator-=(T scalar);
-  Vec& operator*=(T scalar);
-  Vec& operator/=(T scalar);
+  constexpr Vec& operator+=(T scalar);
+  constexpr Vec& operator-=(T scalar);
+  constexpr Vec& operator*=(T scalar);
+  constexpr Vec& operator/=(T scalar);
 
   // Attributes
   bool empty() const { return !x && !y; }
@@ -210,6 +216,8 @@ class Vec<T, 2> final {
   bool normal() const { return magnitude() == 1; }
   Vec& normalize();
   Vec2<Promote<T>> normalized() const;
+  Vec& normalizeFast();
+  Vec2<Promote<T>> normalizedFast() const;
 
   // Inversion
   Vec& invert();
@@ -266,45 +274,45 @@ class Vec<T, 2> final {
 
 // Comparison
 template <class T, class U>
-bool operator==(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator==(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-bool operator!=(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator!=(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-bool operator<(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator<(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-bool operator>(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator>(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-bool operator<=(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator<=(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-bool operator>=(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr bool operator>=(const Vec2<T>& lhs, const Vec2<U>& rhs);
 
 // Arithmetic
 template <class T, class U>
-Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, const Vec2<U>& rhs);
 template <class T, class U>
-Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Vec2<U>& rhs);
 
 // Scalar arithmetic
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, U rhs);
+constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, U rhs);
+constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, U rhs);
+constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, U rhs);
+constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec2<Promote<T, U>> operator+(T lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator+(T lhs, const Vec2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec2<Promote<T, U>> operator-(T lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator-(T lhs, const Vec2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec2<Promote<T, U>> operator*(T lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator*(T lhs, const Vec2<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec2<Promote<T, U>> operator/(T lhs, const Vec2<U>& rhs);
+constexpr Vec2<Promote<T, U>> operator/(T lhs, const Vec2<U>& rhs);
 
 using Vec2i = Vec2<int>;
 using Vec2f = Vec2<float>;
@@ -321,13 +329,13 @@ using Vector2d = Vec2d;
 // MARK: -
 
 template <class T>
-inline Vec<T, 2>::Vec() : x(), y() {}
+inline constexpr Vec<T, 2>::Vec() : x(), y() {}
 
 template <class T>
-inline Vec<T, 2>::Vec(T value) : x(value), y(value) {}
+inline constexpr Vec<T, 2>::Vec(T value) : x(value), y(value) {}
 
 template <class T>
-inline Vec<T, 2>::Vec(T x, T y) : x(x), y(y) {}
+inline constexpr Vec<T, 2>::Vec(T x, T y) : x(x), y(y) {}
 
 template <class T>
 template <class... Args>
@@ -336,12 +344,12 @@ inline Vec<T, 2>::Vec(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline Vec<T, 2>::Vec(const T *values, int size) {
+inline constexpr Vec<T, 2>::Vec(const T *values, int size) : x(), y() {
   set(values, size);
 }
 
 template <class T>
-inline Vec<T, 2>::Vec(std::initializer_list<T> list) {
+inline constexpr Vec<T, 2>::Vec(std::initializer_list<T> list) : x(), y() {
   set(list);
 }
 
@@ -349,7 +357,9 @@ inline Vec<T, 2>::Vec(std::initializer_list<T> list) {
 
 template <class T>
 template <class U>
-inline Vec<T, 2>::Vec(const Vec2<U>& other) : x(other.x), y(other.y) {}
+inline constexpr Vec<T, 2>::Vec(const Vec2<U>& other)
+    : x(other.x),
+      y(other.y) {}
 
 #if SHOTAMATSUDA_HAS_OPENCV
 
@@ -407,11 +417,15 @@ inline Vec<T, 2>::operator CGPoint() const {
 
 template <class T>
 template <class U>
-inline Vec<T, 2>::Vec(const Vec3<U>& other) : x(other.x), y(other.y) {}
+inline constexpr Vec<T, 2>::Vec(const Vec3<U>& other)
+    : x(other.x),
+      y(other.y) {}
 
 template <class T>
 template <class U>
-inline Vec<T, 2>::Vec(const Vec4<U>& other) : x(other.x), y(other.y) {}
+inline constexpr Vec<T, 2>::Vec(const Vec4<U>& other)
+    : x(other.x),
+      y(other.y) {}
 
 #if SHOTAMATSUDA_HAS_OPENCV
 
@@ -430,12 +444,12 @@ inline Vec<T, 2>::operator cv::Vec<U, 2>() const {
 // MARK: Factory
 
 template <class T>
-inline Vec2<T> Vec<T, 2>::min() {
+inline constexpr Vec2<T> Vec<T, 2>::min() {
   return Vec(std::numeric_limits<T>::min(), std::numeric_limits<T>::min());
 }
 
 template <class T>
-inline Vec2<T> Vec<T, 2>::max() {
+inline constexpr Vec2<T> Vec<T, 2>::max() {
   return Vec(std::numeric_limits<T>::max(), std::numeric_limits<T>::max());
 }
 
@@ -446,17 +460,17 @@ inline Vec2<T> Vec<T, 2>::heading(Promote<T> angle) {
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random() {
-  return random(&Random<>::shared());
+  return random(&Random<>::local());
 }
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &Random<>::local());
 }
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &Random<>::local());
 }
 
 template <class T>
@@ -481,21 +495,36 @@ inline Vec2<T> Vec<T, 2>::random(T min, T max, Random *random) {
              random->template uniform<T>(min, max));
 }
 
+template <class T>
+inline void Vec<T, 2>::random(Vec *values, std::size_t size, T min, T max) {
+  random(values, size, min, max, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Vec<T, 2>::random(Vec *values, std::size_t size, T min, T max,
+                              Random *random) {
+  static_assert(sizeof(Vec) == 2 * sizeof(T),
+                "Vectors must be tightly packed");
+  assert(random);
+  random->fillUniform(reinterpret_cast<T *>(values), size * 2, min, max);
+}
+
 // MARK: Mutators
 
 template <class T>
-inline void Vec<T, 2>::set(T value) {
+inline constexpr void Vec<T, 2>::set(T value) {
   x = y = value;
 }
 
 template <class T>
-inline void Vec<T, 2>::set(T x, T y) {
+inline constexpr void Vec<T, 2>::set(T x, T y) {
   this->x = x;
   this->y = y;
 }
 
 template <class T>
-inline void Vec<T, 2>::set(const T *values, int size) {
+inline constexpr void Vec<T, 2>::set(const T *values, int size) {
   reset();
   const auto end = values + size;
   if (values == end) return;
@@ -511,7 +540,7 @@ inline void Vec<T, 2>::set(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline void Vec<T, 2>::set(std::initializer_list<T> list) {
+inline constexpr void Vec<T, 2>::set(std::initializer_list<T> list) {
   reset();
   auto itr = std::begin(list);
   if (itr == std::end(list)) return;
@@ -521,14 +550,14 @@ inline void Vec<T, 2>::set(std::initializer_list<T> list) {
 }
 
 template <class T>
-inline void Vec<T, 2>::reset() {
+inline constexpr void Vec<T, 2>::reset() {
   *this = Vec();
 }
 
 // MARK: Element access
 
 template <class T>
-inline T& Vec<T, 2>::at(int index) {
+inline constexpr T& Vec<T, 2>::at(int index) {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -540,7 +569,7 @@ inline T& Vec<T, 2>::at(int index) {
 }
 
 template <class T>
-inline const T& Vec<T, 2>::at(int index) const {
+inline constexpr const T& Vec<T, 2>::at(int index) const {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -552,44 +581,44 @@ inline const T& Vec<T, 2>::at(int index) const {
 }
 
 template <class T>
-inline T& Vec<T, 2>::at(Axis axis) {
+inline constexpr T& Vec<T, 2>::at(Axis axis) {
   return at(static_cast<int>(axis));
 }
 
 template <class T>
-inline const T& Vec<T, 2>::at(Axis axis) const {
+inline constexpr const T& Vec<T, 2>::at(Axis axis) const {
   return at(static_cast<int>(axis));
 }
 
 // MARK: Comparison
 
 template <class T, class U>
-inline bool operator==(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator==(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return lhs.x == rhs.x && lhs.y == rhs.y;
 }
 
 template <class T, class U>
-inline bool operator!=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator!=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return !(lhs == rhs);
 }
 
 template <class T, class U>
-inline bool operator<(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator<(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
 }
 
 template <class T, class U>
-inline bool operator>(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator>(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return lhs.x > rhs.x || (lhs.x == rhs.x && lhs.y > rhs.y);
 }
 
 template <class T, class U>
-inline bool operator<=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator<=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return lhs < rhs || lhs == rhs;
 }
 
 template <class T, class U>
-inline bool operator>=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr bool operator>=(const Vec2<T>& lhs, const Vec2<U>& rhs) {
   return lhs > rhs || lhs == rhs;
 }
 
@@ -603,59 +632,63 @@ inline bool Vec<T, 2>::equals(const Vec2<U>& other, V tolerance) const {
 // MARK: Arithmetic
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator+=(const Vec& other) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator+=(const Vec& other) {
   x += other.x;
   y += other.y;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator-=(const Vec& other) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator-=(const Vec& other) {
   x -= other.x;
   y -= other.y;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator*=(const Vec& other) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator*=(const Vec& other) {
   x *= other.x;
   y *= other.y;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator/=(const Vec& other) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator/=(const Vec& other) {
   x /= other.x;
   y /= other.y;
   return *this;
 }
 
 template <class T>
-inline Vec2<Promote<T>> Vec<T, 2>::operator-() const {
+inline constexpr Vec2<Promote<T>> Vec<T, 2>::operator-() const {
   using V = Promote<T>;
   return Vec2<V>(-static_cast<V>(x), -static_cast<V>(y));
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs,
+                                               const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) + rhs.x, static_cast<V>(lhs.y) + rhs.y);
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs,
+                                               const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) - rhs.x, static_cast<V>(lhs.y) - rhs.y);
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs,
+                                               const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) * rhs.x, static_cast<V>(lhs.y) * rhs.y);
 }
 
 template <class T, class U>
-inline Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs,
+                                               const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) / rhs.x, static_cast<V>(lhs.y) / rhs.y);
 }
@@ -663,77 +696,77 @@ inline Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, const Vec2<U>& rhs) {
 // MARK: Scalar arithmetic
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator+=(T scalar) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator+=(T scalar) {
   x += scalar;
   y += scalar;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator-=(T scalar) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator-=(T scalar) {
   x -= scalar;
   y -= scalar;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator*=(T scalar) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator*=(T scalar) {
   x *= scalar;
   y *= scalar;
   return *this;
 }
 
 template <class T>
-inline Vec2<T>& Vec<T, 2>::operator/=(T scalar) {
+inline constexpr Vec2<T>& Vec<T, 2>::operator/=(T scalar) {
   x /= scalar;
   y /= scalar;
   return *this;
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, U rhs) {
+inline constexpr Vec2<Promote<T, U>> operator+(const Vec2<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) + rhs, static_cast<V>(lhs.y) + rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, U rhs) {
+inline constexpr Vec2<Promote<T, U>> operator-(const Vec2<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) - rhs, static_cast<V>(lhs.y) - rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, U rhs) {
+inline constexpr Vec2<Promote<T, U>> operator*(const Vec2<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) * rhs, static_cast<V>(lhs.y) * rhs);
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, U rhs) {
+inline constexpr Vec2<Promote<T, U>> operator/(const Vec2<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs.x) / rhs, static_cast<V>(lhs.y) / rhs);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec2<Promote<T, U>> operator+(T lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator+(T lhs, const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs) + rhs.x, static_cast<V>(lhs) + rhs.y);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec2<Promote<T, U>> operator-(T lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator-(T lhs, const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs) - rhs.x, static_cast<V>(lhs) - rhs.y);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec2<Promote<T, U>> operator*(T lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator*(T lhs, const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs) * rhs.x, static_cast<V>(lhs) * rhs.y);
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec2<Promote<T, U>> operator/(T lhs, const Vec2<U>& rhs) {
+inline constexpr Vec2<Promote<T, U>> operator/(T lhs, const Vec2<U>& rhs) {
   using V = Promote<T, U>;
   return Vec2<V>(static_cast<V>(lhs) / rhs.x, static_cast<V>(lhs) / rhs.y);
 }
@@ -797,6 +830,20 @@ inline Vec2<Promote<T>> Vec<T, 2>::normalized() const {
   return Vec2<Promote<T>>(*this).normalize();
 }
 
+template <class T>
+inline Vec2<T>& Vec<T, 2>::normalizeFast() {
+  const auto squared = magnitudeSquared();
+  if (squared) {
+    *this *= rsqrt(squared);
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec2<Promote<T>> Vec<T, 2>::normalizedFast() const {
+  return Vec2<Promote<T>>(*this).normalizeFast();
+}
+
 // MARK: Inversion
 
 template <class T>
@@ -854,7 +901,7 @@ inline Vec2<Promote<T, U>> Vec<T, 2>::lerp(const Vec2<U>& other,
 template <class T>
 template <class U>
 inline Vec2<T>& Vec<T, 2>::jitter(const Vec2<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &Random<>::local());
 }
 
 template <class T>
@@ -922,8 +969,7 @@ using math::Vector2d;
 template <class T>
 struct std::hash<shotamatsuda::math::Vec2<T>> {
   std::size_t operator()(const shotamatsuda::math::Vec2<T>& value) const {
-    std::hash<T> hash;
-    return (hash(value.x) << 0) ^ (hash(value.y) << 1);
+    return shotamatsuda::math::hash(value.x, value.y);
   }
 };
 
@@ -0,0 +1,555 @@
+//
+//  shotamatsuda/math/vector2_buffer.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_VECTOR2_BUFFER_H_
+#define SHOTAMATSUDA_MATH_VECTOR2_BUFFER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/rsqrt.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T, int D>
+class VecBuffer;
+
+template <class T>
+using Vec2Buffer = VecBuffer<T, 2>;
+
+// Stores vectors as a structure of arrays so that batch arithmetic runs over
+// contiguous scalars. Arithmetic stays in T instead of promoting, to keep the
+// loops free of conversions.
+template <class T>
+class VecBuffer<T, 2> final {
+ public:
+  using Type = T;
+  using Container = std::vector<T>;
+  static constexpr const int dimensions = 2;
+
+ public:
+  VecBuffer() = default;
+  explicit VecBuffer(std::size_t size);
+  VecBuffer(std::size_t size, const Vec2<T>& value);
+  VecBuffer(const Vec2<T> *values, std::size_t size);
+  template <class Iterator>
+  VecBuffer(Iterator first, Iterator last);
+  VecBuffer(std::initializer_list<Vec2<T>> list);
+
+  // Copy semantics
+  VecBuffer(const VecBuffer&) = default;
+  VecBuffer& operator=(const VecBuffer&) = default;
+
+  // Move semantics
+  VecBuffer(VecBuffer&&) = default;
+  VecBuffer& operator=(VecBuffer&&) = default;
+
+  // Mutators
+  void set(std::size_t index, const Vec2<T>& value);
+  void set(const Vec2<T> *values, std::size_t size);
+  template <class Iterator>
+  void set(Iterator first, Iterator last);
+  void set(std::initializer_list<Vec2<T>> list);
+  void push(const Vec2<T>& value);
+  void resize(std::size_t size);
+  void reserve(std::size_t size);
+  void reset();
+
+  // Element access
+  Vec2<T> operator[](std::size_t index) const { return at(index); }
+  Vec2<T> at(std::size_t index) const;
+  Vec2<T> front() const { return at(0); }
+  Vec2<T> back() const { return at(size() - 1); }
+
+  // Conversion
+  template <class Iterator>
+  Iterator copy(Iterator result) const;
+  std::vector<Vec2<T>> vectors() const;
+
+  // Attributes
+  bool empty() const { return x.empty(); }
+  std::size_t size() const { return x.size(); }
+
+  // Arithmetic
+  VecBuffer& operator+=(const VecBuffer& other);
+  VecBuffer& operator-=(const VecBuffer& other);
+  VecBuffer& operator*=(const VecBuffer& other);
+  VecBuffer& operator/=(const VecBuffer& other);
+
+  // Vector arithmetic
+  VecBuffer& operator+=(const Vec2<T>& vector);
+  VecBuffer& operator-=(const Vec2<T>& vector);
+  VecBuffer& operator*=(const Vec2<T>& vector);
+  VecBuffer& operator/=(const Vec2<T>& vector);
+
+  // Scalar arithmetic
+  VecBuffer& operator+=(T scalar);
+  VecBuffer& operator-=(T scalar);
+  VecBuffer& operator*=(T scalar);
+  VecBuffer& operator/=(T scalar);
+
+  // Magnitude
+  void magnitude(Promote<T> *result) const;
+  void magnitudeSquared(Promote<T> *result) const;
+
+  // Normalization
+  VecBuffer& normalize();
+  VecBuffer normalized() const;
+  VecBuffer& normalizeFast();
+  VecBuffer normalizedFast() const;
+
+  // Products
+  void dot(const VecBuffer& other, Promote<T> *result) const;
+
+ private:
+  template <class Operation>
+  static void apply(const T *values, Container *result, Operation operation);
+  template <class Operation>
+  static void apply(T value, Container *result, Operation operation);
+
+ public:
+  Container x;
+  Container y;
+};
+
+// Arithmetic
+template <class T>
+Vec2Buffer<T> operator+(const Vec2Buffer<T>& lhs, const Vec2Buffer<T>& rhs);
+template <class T>
+Vec2Buffer<T> operator-(const Vec2Buffer<T>& lhs, const Vec2Buffer<T>& rhs);
+template <class T>
+Vec2Buffer<T> operator*(const Vec2Buffer<T>& lhs, const Vec2Buffer<T>& rhs);
+template <class T>
+Vec2Buffer<T> operator/(const Vec2Buffer<T>& lhs, const Vec2Buffer<T>& rhs);
+
+// Scalar arithmetic
+template <class T>
+Vec2Buffer<T> operator+(const Vec2Buffer<T>& lhs, T rhs);
+template <class T>
+Vec2Buffer<T> operator-(const Vec2Buffer<T>& lhs, T rhs);
+template <class T>
+Vec2Buffer<T> operator*(const Vec2Buffer<T>& lhs, T rhs);
+template <class T>
+Vec2Buffer<T> operator/(const Vec2Buffer<T>& lhs, T rhs);
+
+using Vec2iBuffer = Vec2Buffer<int>;
+using Vec2fBuffer = Vec2Buffer<float>;
+using Vec2dBuffer = Vec2Buffer<double>;
+
+// MARK: -
+
+template <class T>
+inline VecBuffer<T, 2>::VecBuffer(std::size_t size)
+    : x(size),
+      y(size) {}
+
+template <class T>
+inline VecBuffer<T, 2>::VecBuffer(std::size_t size, const Vec2<T>& value)
+    : x(size, value.x),
+      y(size, value.y) {}
+
+template <class T>
+inline VecBuffer<T, 2>::VecBuffer(const Vec2<T> *values, std::size_t size) {
+  set(values, size);
+}
+
+template <class T>
+template <class Iterator>
+inline VecBuffer<T, 2>::VecBuffer(Iterator first, Iterator last) {
+  set(first, last);
+}
+
+template <class T>
+inline VecBuffer<T, 2>::VecBuffer(std::initializer_list<Vec2<T>> list) {
+  set(list);
+}
+
+// MARK: Mutators
+
+template <class T>
+inline void VecBuffer<T, 2>::set(std::size_t index, const Vec2<T>& value) {
+  assert(index < size());
+  x[index] = value.x;
+  y[index] = value.y;
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::set(const Vec2<T> *values, std::size_t size) {
+  assert(values || !size);
+  resize(size);
+  T * const vx = x.data();
+  T * const vy = y.data();
+  for (std::size_t i = 0; i < size; ++i) {
+    vx[i] = values[i].x;
+    vy[i] = values[i].y;
+  }
+}
+
+template <class T>
+template <class Iterator>
+inline void VecBuffer<T, 2>::set(Iterator first, Iterator last) {
+  reset();
+  reserve(std::distance(first, last));
+  for (auto itr = first; itr != last; ++itr) {
+    push(*itr);
+  }
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::set(std::initializer_list<Vec2<T>> list) {
+  set(std::begin(list), std::end(list));
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::push(const Vec2<T>& value) {
+  x.push_back(value.x);
+  y.push_back(value.y);
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::resize(std::size_t size) {
+  x.resize(size);
+  y.resize(size);
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::reserve(std::size_t size) {
+  x.reserve(size);
+  y.reserve(size);
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::reset() {
+  x.clear();
+  y.clear();
+}
+
+// MARK: Element access
+
+template <class T>
+inline Vec2<T> VecBuffer<T, 2>::at(std::size_t index) const {
+  assert(index < size());
+  return Vec2<T>(x[index], y[index]);
+}
+
+// MARK: Conversion
+
+template <class T>
+template <class Iterator>
+inline Iterator VecBuffer<T, 2>::copy(Iterator result) const {
+  const auto size = this->size();
+  for (std::size_t i = 0; i < size; ++i, ++result) {
+    *result = Vec2<T>(x[i], y[i]);
+  }
+  return result;
+}
+
+template <class T>
+inline std::vector<Vec2<T>> VecBuffer<T, 2>::vectors() const {
+  std::vector<Vec2<T>> result(size());
+  copy(result.begin());
+  return result;
+}
+
+// MARK: Arithmetic
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator+=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::plus<T>());
+  apply(other.y.data(), &y, std::plus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator-=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::minus<T>());
+  apply(other.y.data(), &y, std::minus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator*=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::multiplies<T>());
+  apply(other.y.data(), &y, std::multiplies<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator/=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::divides<T>());
+  apply(other.y.data(), &y, std::divides<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator+(const Vec2Buffer<T>& lhs,
+                               const Vec2Buffer<T>& rhs) {
+  return Vec2Buffer<T>(lhs) += rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator-(const Vec2Buffer<T>& lhs,
+                               const Vec2Buffer<T>& rhs) {
+  return Vec2Buffer<T>(lhs) -= rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator*(const Vec2Buffer<T>& lhs,
+                               const Vec2Buffer<T>& rhs) {
+  return Vec2Buffer<T>(lhs) *= rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator/(const Vec2Buffer<T>& lhs,
+                               const Vec2Buffer<T>& rhs) {
+  return Vec2Buffer<T>(lhs) /= rhs;
+}
+
+// MARK: Vector arithmetic
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator+=(const Vec2<T>& vector) {
+  apply(vector.x, &x, std::plus<T>());
+  apply(vector.y, &y, std::plus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator-=(const Vec2<T>& vector) {
+  apply(vector.x, &x, std::minus<T>());
+  apply(vector.y, &y, std::minus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator*=(const Vec2<T>& vector) {
+  apply(vector.x, &x, std::multiplies<T>());
+  apply(vector.y, &y, std::multiplies<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator/=(const Vec2<T>& vector) {
+  apply(vector.x, &x, std::divides<T>());
+  apply(vector.y, &y, std::divides<T>());
+  return *this;
+}
+
+// MARK: Scalar arithmetic
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator+=(T scalar) {
+  return *this += Vec2<T>(scalar);
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator-=(T scalar) {
+  return *this -= Vec2<T>(scalar);
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator*=(T scalar) {
+  return *this *= Vec2<T>(scalar);
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::operator/=(T scalar) {
+  return *this /= Vec2<T>(scalar);
+}
+
+template <class T>
+inline Vec2Buffer<T> operator+(const Vec2Buffer<T>& lhs, T rhs) {
+  return Vec2Buffer<T>(lhs) += rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator-(const Vec2Buffer<T>& lhs, T rhs) {
+  return Vec2Buffer<T>(lhs) -= rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator*(const Vec2Buffer<T>& lhs, T rhs) {
+  return Vec2Buffer<T>(lhs) *= rhs;
+}
+
+template <class T>
+inline Vec2Buffer<T> operator/(const Vec2Buffer<T>& lhs, T rhs) {
+  return Vec2Buffer<T>(lhs) /= rhs;
+}
+
+// MARK: Element-wise operation
+
+template <class T>
+template <class Operation>
+inline void VecBuffer<T, 2>::apply(const T *values,
+                                   Container *result,
+                                   Operation operation) {
+  const auto size = result->size();
+  T * const data = result->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = operation(data[i], values[i]);
+  }
+}
+
+template <class T>
+template <class Operation>
+inline void VecBuffer<T, 2>::apply(T value,
+                                   Container *result,
+                                   Operation operation) {
+  const auto size = result->size();
+  T * const data = result->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = operation(data[i], value);
+  }
+}
+
+// MARK: Magnitude
+
+template <class T>
+inline void VecBuffer<T, 2>::magnitude(Promote<T> *result) const {
+  assert(result || empty());
+  magnitudeSquared(result);
+  const auto size = this->size();
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = std::sqrt(result[i]);
+  }
+}
+
+template <class T>
+inline void VecBuffer<T, 2>::magnitudeSquared(Promote<T> *result) const {
+  assert(result || empty());
+  using V = Promote<T>;
+  const auto size = this->size();
+  const T * const ax = x.data();
+  const T * const ay = y.data();
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = static_cast<V>(ax[i]) * ax[i] +
+                static_cast<V>(ay[i]) * ay[i];
+  }
+}
+
+// MARK: Normalization
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::normalize() {
+  using V = Promote<T>;
+  const auto size = this->size();
+  T * const ax = x.data();
+  T * const ay = y.data();
+  for (std::size_t i = 0; i < size; ++i) {
+    const V magnitude = std::sqrt(static_cast<V>(ax[i]) * ax[i] +
+                                  static_cast<V>(ay[i]) * ay[i]);
+    // Zero vectors stay zero, as in Vec::normalize()
+    const V denominator = magnitude ? magnitude : 1;
+    ax[i] /= denominator;
+    ay[i] /= denominator;
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T> VecBuffer<T, 2>::normalized() const {
+  return VecBuffer(*this).normalize();
+}
+
+template <class T>
+inline Vec2Buffer<T>& VecBuffer<T, 2>::normalizeFast() {
+  using V = Promote<T>;
+  // Squared magnitudes are converted in blocks that stay in the L1 cache
+  constexpr std::size_t block = 256;
+  V squared[block];
+  V factors[block];
+  const auto size = this->size();
+  T * const ax = x.data();
+  T * const ay = y.data();
+  for (std::size_t first = 0; first < size; first += block) {
+    const auto count = std::min(block, size - first);
+    const T * const bx = ax + first;
+    const T * const by = ay + first;
+    for (std::size_t i = 0; i < count; ++i) {
+      squared[i] = (static_cast<V>(bx[i]) * bx[i] +
+                    static_cast<V>(by[i]) * by[i]);
+    }
+    rsqrt(squared, static_cast<int>(count), factors);
+    for (std::size_t i = 0; i < count; ++i) {
+      // Zero vectors stay zero, as in Vec::normalizeFast()
+      const V factor = squared[i] ? factors[i] : 0;
+      ax[first + i] *= factor;
+      ay[first + i] *= factor;
+    }
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec2Buffer<T> VecBuffer<T, 2>::normalizedFast() const {
+  return VecBuffer(*this).normalizeFast();
+}
+
+// MARK: Products
+
+template <class T>
+inline void VecBuffer<T, 2>::dot(const VecBuffer& other,
+                                 Promote<T> *result) const {
+  assert(other.size() == size());
+  assert(result || empty());
+  using V = Promote<T>;
+  const auto size = this->size();
+  const T * const ax = x.data();
+  const T * const ay = y.data();
+  const T * const bx = other.x.data();
+  const T * const by = other.y.data();
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = static_cast<V>(ax[i]) * bx[i] +
+                static_cast<V>(ay[i]) * by[i];
+  }
+}
+
+}  // namespace math
+
+using math::VecBuffer;
+using math::Vec2Buffer;
+using math::Vec2iBuffer;
+using math::Vec2fBuffer;
+using math::Vec2dBuffer;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_VECTOR2_BUFFER_H_
@@ -52,8 +52,10 @@
 
 #include "shotamatsuda/math/axis.h"
 #include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rsqrt.h"
 
 namespace shotamatsuda {
 namespace math {
@@ -79,17 +81,17 @@ class Vec<T, 3> final {
   static constexpr const int dimensions = 3;
 
  public:
-  Vec();
-  explicit Vec(T value);
-  Vec(T x, T y, T z = T());
-  explicit Vec(const T *values, int size = 3);
+  constexpr Vec();
+  explicit constexpr Vec(T value);
+  constexpr Vec(T x, T y, T z = T());
+  explicit constexpr Vec(const T *values, int size = 3);
   template <class... Args>
   Vec(const std::tuple<Args...>& tuple);
-  Vec(std::initializer_list<T> list);
+  constexpr Vec(std::initializer_list<T> list);
 
   // Implicit conversion
   template <class U>
-  Vec(const Vec3<U>& other);
+  constexpr Vec(const Vec3<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -112,9 +114,9 @@ class Vec<T, 3> final {
 
   // Explicit conversion
   template <class U>
-  explicit Vec(const Vec2<U>& other);
+  explicit constexpr Vec(const Vec2<U>& other);
   template <class U>
-  explicit Vec(const Vec4<U>& other);
+  explicit constexpr Vec(const Vec4<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -128,8 +130,8 @@ class Vec<T, 3> final {
   Vec& operator=(const Vec&) = default;
 
   // Factory
-  static Vec min();
-  static Vec max();
+  static constexpr Vec min();
+  static constexpr Vec max();
   static Vec headingXY(Promote<T> angle);
   static Vec headingYZ(Promote<T> angle);
   static Vec headingZX(Promote<T> angle);
@@ -142,46 +144,50 @@ class Vec<T, 3> final {
   static Vec random(T max, Random *random);
   template <class Random>
   static Vec random(T min, T max, Random *random);
+  static void random(Vec *values, std::size_t size, T min, T max);
+  template <class Random>
+  static void random(Vec *values, std::size_t size, T min, T max,
+                     Random *random);
 
   // Mutators
-  void set(T value);
-  void set(T x, T y, T z = T());
-  void set(const T *values, int size = dimensions);
+  constexpr void set(T value);
+  constexpr void set(T x, T y, T z = T());
+  constexpr void set(const T *values, int size = dimensions);
   template <class... Args>
   void set(const std::tuple<Args...>& tuple);
-  void set(std::initializer_list<T> list);
-  void reset();
+  constexpr void set(std::initializer_list<T> list);
+  constexpr void reset();
 
   // Element access
-  T& operator[](int index) { return at(index); }
-  const T& operator[](int index) const { return at(index); }
-  T& operator[](Axis axis) { return at(axis); }
-  const T& operator[](Axis axis) const { return at(axis); }
-  T& at(int index);
-  const T& at(int index) const;
-  T& at(Axis axis);
-  const T& at(Axis axis) const;
-  T& front() { return x; }
-  const T& front() const { return x; }
-  T& back() { return z; }
-  const T& back() const { return z; }
+  constexpr T& operator[](int index) { return at(index); }
+  constexpr const T& operator[](int index) const { return at(index); }
+  constexpr T& operator[](Axis axis) { return at(axis); }
+  constexpr const T& operator[](Axis axis) const { return at(axis); }
+  constexpr T& at(int index);
+  constexpr const T& at(int index) const;
+  constexpr T& at(Axis axis);
+  constexpr const T& at(Axis axis) const;
+  constexpr T& front() { return x; }
+  constexpr const T& front() const { return x; }
+  constexpr T& back() { return z; }
+  constexpr const T& back() const { return z; }
 
   // Comparison
   template <class V, class U = T>
   bool equals(const Vec3<U>& other, V tolerance) const;
 
   // Arithmetic
-  Vec& operator+=(const Vec& other);
-  Vec& operator-=(const Vec& other);
-  Vec& operator*=(const Vec& other);
-  Vec& operator/=(const Vec& other);
-  Vec3<Promote<T>> operator-() const;
+  constexpr Vec& operator+=(const Vec& other);
+  constexpr Vec& operator-=(const Vec& other);
+  constexpr Vec& operator*=(const Vec& other);
+  constexpr Vec& operator/=(const Vec& other);
+  constexpr Vec3<Promote<T>> operator-() const;
 
   // Scalar arithmetic
-  Vec& operator+=(T scalar);
-  Vec& operator-=(T scalar);
-  Vec& operator*=(T scalar);
-  Vec& operator/=(T scalar);
+  constexpr Vec& operator+=(T scalar);
+  constexpr Vec& operator-=(T scalar);
+  constexpr Vec& operator*=(T scalar);
+  constexpr Vec& operator/=(T scalar);
 
   // Attributes
   bool empty() const { return !x && !y && !z; }
@@ -205,6 +211,8 @@ class Vec<T, 3> final {
   bool normal() const { return magnitude() == 1; }
   Vec& normalize();
   Vec3<Promote<T>> normalized() const;
+  Vec& normalizeFast();
+  Vec3<Promote<T>> normalizedFast() const;
 
   // Inversion
   Vec& invert();
@@ -262,45 +270,45 @@ class Vec<T, 3> final {
 
 // Comparison
 template <class T, class U>
-bool operator==(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator==(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-bool operator!=(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator!=(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-bool operator<(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator<(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-bool operator>(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator>(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-bool operator<=(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator<=(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-bool operator>=(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr bool operator>=(const Vec3<T>& lhs, const Vec3<U>& rhs);
 
 // Arithmetic
 template <class T, class U>
-Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, const Vec3<U>& rhs);
 template <class T, class U>
-Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, const Vec3<U>& rhs);
 
 // Scalar arithmetic
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, U rhs);
+constexpr Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, U rhs);
+constexpr Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, U rhs);
+constexpr Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, U rhs);
+constexpr Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec3<Promote<T, U>> operator+(T lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator+(T lhs, const Vec3<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec3<Promote<T, U>> operator-(T lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator-(T lhs, const Vec3<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec3<Promote<T, U>> operator*(T lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator*(T lhs, const Vec3<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec3<Promote<T, U>> operator/(T lhs, const Vec3<U>& rhs);
+constexpr Vec3<Promote<T, U>> operator/(T lhs, const Vec3<U>& rhs);
 
 using Vec3i = Vec3<int>;
 using Vec3f = Vec3<float>;
@@ -317,16 +325,16 @@ using Vector3d = Vec3d;
 // MARK: -
 
 template <class T>
-inline Vec<T, 3>::Vec() : x(), y(), z() {}
+inline constexpr Vec<T, 3>::Vec() : x(), y(), z() {}
 
 template <class T>
-inline Vec<T, 3>::Vec(T value) : x(value), y(value), z(value) {}
+inline constexpr Vec<T, 3>::Vec(T value) : x(value), y(value), z(value) {}
 
 template <class T>
-inline Vec<T, 3>::Vec(T x, T y, T z) : x(x), y(y), z(z) {}
+inline constexpr Vec<T, 3>::Vec(T x, T y, T z) : x(x), y(y), z(z) {}
 
 template <class T>
-inline Vec<T, 3>::Vec(const T *values, int size) {
+inline constexpr Vec<T, 3>::Vec(const T *values, int size) : x(), y(), z() {
   set(values, size);
 }
 
@@ -337,7 +345,7 @@ inline Vec<T, 3>::Vec(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline Vec<T, 3>::Vec(std::initializer_list<T> list) {
+inline constexpr Vec<T, 3>::Vec(std::initializer_list<T> list) : x(), y(), z() {
   set(list);
 }
 
@@ -345,7 +353,7 @@ inline Vec<T, 3>::Vec(std::initializer_list<T> list) {
 
 template <class T>
 template <class U>
-inline Vec<T, 3>::Vec(const Vec3<U>& other)
+inline constexpr Vec<T, 3>::Vec(const Vec3<U>& other)
     : x(other.x),
       y(other.y),
       z(other.z) {}
@@ -403,14 +411,14 @@ inline Vec<T, 3>::operator ci::Vec3<U>() const {
 
 template <class T>
 template <class U>
-inline Vec<T, 3>::Vec(const Vec2<U>& other)
+inline constexpr Vec<T, 3>::Vec(const Vec2<U>& other)
     : x(other.x),
       y(other.y),
       z() {}
 
 template <class T>
 template <class U>
-inline Vec<T, 3>::Vec(const Vec4<U>& other)
+inline constexpr Vec<T, 3>::Vec(const Vec4<U>& other)
     : x(other.x),
       y(other.y),
       z(other.z) {}
@@ -432,14 +440,14 @@ inline Vec<T, 3>::operator cv::Vec<U, 3>() const {
 // MARK: Factory
 
 template <class T>
-inline Vec3<T> Vec<T, 3>::min() {
+inline constexpr Vec3<T> Vec<T, 3>::min() {
   return Vec(std::numeric_limits<T>::min(),
              std::numeric_limits<T>::min(),
              std::numeric_limits<T>::min());
 }
 
 template <class T>
-inline Vec3<T> Vec<T, 3>::max() {
+inline constexpr Vec3<T> Vec<T, 3>::max() {
   return Vec(std::numeric_limits<T>::max(),
              std::numeric_limits<T>::max(),
              std::numeric_limits<T>::max());
@@ -462,17 +470,17 @@ inline Vec3<T> Vec<T, 3>::headingZX(Promote<T> angle) {
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random() {
-  return random(&Random<>::shared());
+  return random(&Random<>::local());
 }
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &Random<>::local());
 }
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &Random<>::local());
 }
 
 template <class T>
@@ -498,22 +506,37 @@ inline Vec3<T> Vec<T, 3>::random(T min, T max, Random *random) {
              random->template uniform<T>(min, max));
 }
 
+template <class T>
+inline void Vec<T, 3>::random(Vec *values, std::size_t size, T min, T max) {
+  random(values, size, min, max, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Vec<T, 3>::random(Vec *values, std::size_t size, T min, T max,
+                              Random *random) {
+  static_assert(sizeof(Vec) == 3 * sizeof(T),
+                "Vectors must be tightly packed");
+  assert(random);
+  random->fillUniform(reinterpret_cast<T *>(values), size * 3, min, max);
+}
+
 // MARK: Mutators
 
 template <class T>
-inline void Vec<T, 3>::set(T value) {
+inline constexpr void Vec<T, 3>::set(T value) {
   x = y = z = value;
 }
 
 template <class T>
-inline void Vec<T, 3>::set(T x, T y, T z) {
+inline constexpr void Vec<T, 3>::set(T x, T y, T z) {
   this->x = x;
   this->y = y;
   this->z = z;
 }
 
 template <class T>
-inline void Vec<T, 3>::set(const T *values, int size) {
+inline constexpr void Vec<T, 3>::set(const T *values, int size) {
   reset();
   const auto end = values + size;
   if (values == end) return;
@@ -531,7 +554,7 @@ inline void Vec<T, 3>::set(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline void Vec<T, 3>::set(std::initializer_list<T> list) {
+inline constexpr void Vec<T, 3>::set(std::initializer_list<T> list) {
   reset();
   auto itr = std::begin(list);
   if (itr == std::end(list)) return;
@@ -543,14 +566,14 @@ inline void Vec<T, 3>::set(std::initializer_list<T> list) {
 }
 
 template <class T>
-inline void Vec<T, 3>::reset() {
+inline constexpr void Vec<T, 3>::reset() {
   *this = Vec();
 }
 
 // MARK: Element access
 
 template <class T>
-inline T& Vec<T, 3>::at(int index) {
+inline constexpr T& Vec<T, 3>::at(int index) {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -563,7 +586,7 @@ inline T& Vec<T, 3>::at(int index) {
 }
 
 template <class T>
-inline const T& Vec<T, 3>::at(int index) const {
+inline constexpr const T& Vec<T, 3>::at(int index) const {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -576,46 +599,46 @@ inline const T& Vec<T, 3>::at(int index) const {
 }
 
 template <class T>
-inline T& Vec<T, 3>::at(Axis axis) {
+inline constexpr T& Vec<T, 3>::at(Axis axis) {
   return at(static_cast<int>(axis));
 }
 
 template <class T>
-inline const T& Vec<T, 3>::at(Axis axis) const {
+inline constexpr const T& Vec<T, 3>::at(Axis axis) const {
   return at(static_cast<int>(axis));
 }
 
 // MARK: Comparison
 
 template <class T, class U>
-inline bool operator==(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator==(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
 }
 
 template <class T, class U>
-inline bool operator!=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator!=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return !(lhs == rhs);
 }
 
 template <class T, class U>
-inline bool operator<(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator<(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return lhs.x < rhs.x || (lhs.x == rhs.x &&
         (lhs.y < rhs.y || (lhs.y == rhs.y && lhs.z < rhs.z)));
 }
 
 template <class T, class U>
-inline bool operator>(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator>(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return lhs.x > rhs.x || (lhs.x == rhs.x &&
         (lhs.y > rhs.y || (lhs.y == rhs.y && lhs.z > rhs.z)));
 }
 
 template <class T, class U>
-inline bool operator<=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator<=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return lhs < rhs || lhs == rhs;
 }
 
 template <class T, class U>
-inline bool operator>=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr bool operator>=(const Vec3<T>& lhs, const Vec3<U>& rhs) {
   return lhs > rhs || lhs == rhs;
 }
 
@@ -630,7 +653,7 @@ inline bool Vec<T, 3>::equals(const Vec3<U>& other, V tolerance) const {
 // MARK: Arithmetic
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator+=(const Vec& other) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator+=(const Vec& other) {
   x += other.x;
   y += other.y;
   z += other.z;
@@ -638,7 +661,7 @@ inline Vec3<T>& Vec<T, 3>::operator+=(const Vec& other) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator-=(const Vec& other) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator-=(const Vec& other) {
   x -= other.x;
   y -= other.y;
   z -= other.z;
@@ -646,7 +669,7 @@ inline Vec3<T>& Vec<T, 3>::operator-=(const Vec& other) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator*=(const Vec& other) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator*=(const Vec& other) {
   x *= other.x;
   y *= other.y;
   z *= other.z;
@@ -654,7 +677,7 @@ inline Vec3<T>& Vec<T, 3>::operator*=(const Vec& other) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator/=(const Vec& other) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator/=(const Vec& other) {
   x /= other.x;
   y /= other.y;
   z /= other.z;
@@ -662,13 +685,14 @@ inline Vec3<T>& Vec<T, 3>::operator/=(const Vec& other) {
 }
 
 template <class T>
-inline Vec3<Promote<T>> Vec<T, 3>::operator-() const {
+inline constexpr Vec3<Promote<T>> Vec<T, 3>::operator-() const {
   using V = Promote<T>;
   return Vec3<V>(-static_cast<V>(x), -static_cast<V>(y), -static_cast<V>(z));
 }
 
 template <class T, class U>
-inline Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs,
+                                               const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) + rhs.x,
                  static_cast<V>(lhs.y) + rhs.y,
@@ -676,7 +700,8 @@ inline Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs,
+                                               const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) - rhs.x,
                  static_cast<V>(lhs.y) - rhs.y,
@@ -684,7 +709,8 @@ inline Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs,
+                                               const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) * rhs.x,
                  static_cast<V>(lhs.y) * rhs.y,
@@ -692,7 +718,8 @@ inline Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs,
+                                               const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<Promote<T, U>>(lhs.x) / rhs.x,
                  static_cast<Promote<T, U>>(lhs.y) / rhs.y,
@@ -702,7 +729,7 @@ inline Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, const Vec3<U>& rhs) {
 // MARK: Scalar arithmetic
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator+=(T scalar) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator+=(T scalar) {
   x += scalar;
   y += scalar;
   z += scalar;
@@ -710,7 +737,7 @@ inline Vec3<T>& Vec<T, 3>::operator+=(T scalar) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator-=(T scalar) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator-=(T scalar) {
   x -= scalar;
   y -= scalar;
   z -= scalar;
@@ -718,7 +745,7 @@ inline Vec3<T>& Vec<T, 3>::operator-=(T scalar) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator*=(T scalar) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator*=(T scalar) {
   x *= scalar;
   y *= scalar;
   z *= scalar;
@@ -726,7 +753,7 @@ inline Vec3<T>& Vec<T, 3>::operator*=(T scalar) {
 }
 
 template <class T>
-inline Vec3<T>& Vec<T, 3>::operator/=(T scalar) {
+inline constexpr Vec3<T>& Vec<T, 3>::operator/=(T scalar) {
   x /= scalar;
   y /= scalar;
   z /= scalar;
@@ -734,7 +761,7 @@ inline Vec3<T>& Vec<T, 3>::operator/=(T scalar) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, U rhs) {
+inline constexpr Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) + rhs,
                  static_cast<V>(lhs.y) + rhs,
@@ -742,7 +769,7 @@ inline Vec3<Promote<T, U>> operator+(const Vec3<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, U rhs) {
+inline constexpr Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) - rhs,
                  static_cast<V>(lhs.y) - rhs,
@@ -750,7 +777,7 @@ inline Vec3<Promote<T, U>> operator-(const Vec3<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, U rhs) {
+inline constexpr Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) * rhs,
                  static_cast<V>(lhs.y) * rhs,
@@ -758,7 +785,7 @@ inline Vec3<Promote<T, U>> operator*(const Vec3<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, U rhs) {
+inline constexpr Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs.x) / rhs,
                  static_cast<V>(lhs.y) / rhs,
@@ -766,7 +793,7 @@ inline Vec3<Promote<T, U>> operator/(const Vec3<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec3<Promote<T, U>> operator+(T lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator+(T lhs, const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs) + rhs.x,
                  static_cast<V>(lhs) + rhs.y,
@@ -774,7 +801,7 @@ inline Vec3<Promote<T, U>> operator+(T lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec3<Promote<T, U>> operator-(T lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator-(T lhs, const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs) - rhs.x,
                  static_cast<V>(lhs) - rhs.y,
@@ -782,7 +809,7 @@ inline Vec3<Promote<T, U>> operator-(T lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec3<Promote<T, U>> operator*(T lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator*(T lhs, const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs) * rhs.x,
                  static_cast<V>(lhs) * rhs.y,
@@ -790,7 +817,7 @@ inline Vec3<Promote<T, U>> operator*(T lhs, const Vec3<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec3<Promote<T, U>> operator/(T lhs, const Vec3<U>& rhs) {
+inline constexpr Vec3<Promote<T, U>> operator/(T lhs, const Vec3<U>& rhs) {
   using V = Promote<T, U>;
   return Vec3<V>(static_cast<V>(lhs) / rhs.x,
                  static_cast<V>(lhs) * rhs.y,
@@ -864,6 +891,20 @@ inline Vec3<Promote<T>> Vec<T, 3>::normalized() const {
   return Vec3<Promote<T>>(*this).normalize();
 }
 
+template <class T>
+inline Vec3<T>& Vec<T, 3>::normalizeFast() {
+  const auto squared = magnitudeSquared();
+  if (squared) {
+    *this *= rsqrt(squared);
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec3<Promote<T>> Vec<T, 3>::normalizedFast() const {
+  return Vec3<Promote<T>>(*this).normalizeFast();
+}
+
 // MARK: Inversion
 
 template <class T>
@@ -926,7 +967,7 @@ inline Vec3<Promote<T, U>> Vec<T, 3>::lerp(const Vec3<U>& other,
 template <class T>
 template <class U>
 inline Vec3<T>& Vec<T, 3>::jitter(const Vec3<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &Random<>::local());
 }
 
 template <class T>
@@ -981,8 +1022,7 @@ using math::Vector3d;
 template <class T>
 struct std::hash<shotamatsuda::math::Vec3<T>> {
   std::size_t operator()(const shotamatsuda::math::Vec3<T>& value) const {
-    std::hash<T> hash;
-    return (hash(value.x) << 0) ^ (hash(value.y) << 1) ^ (hash(value.z) << 2);
+    return shotamatsuda::math::hash(value.x, value.y, value.z);
   }
 };
 
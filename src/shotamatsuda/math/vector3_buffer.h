@@ -0,0 +1,869 @@
+//
+//  shotamatsuda/math/vector3_buffer.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_VECTOR3_BUFFER_H_
+#define SHOTAMATSUDA_MATH_VECTOR3_BUFFER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/rsqrt.h"
+#include "shotamatsuda/math/simd.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T, int D>
+class VecBuffer;
+
+template <class T>
+using Vec3Buffer = VecBuffer<T, 3>;
+
+// Stores vectors as a structure of arrays so that batch arithmetic runs over
+// contiguous scalars. Arithmetic stays in T instead of promoting, to keep the
+// loops free of conversions.
+template <class T>
+class VecBuffer<T, 3> final {
+ public:
+  using Type = T;
+  using Container = std::vector<T>;
+  static constexpr const int dimensions = 3;
+
+ public:
+  VecBuffer() = default;
+  explicit VecBuffer(std::size_t size);
+  VecBuffer(std::size_t size, const Vec3<T>& value);
+  VecBuffer(const Vec3<T> *values, std::size_t size);
+  template <class Iterator>
+  VecBuffer(Iterator first, Iterator last);
+  VecBuffer(std::initializer_list<Vec3<T>> list);
+
+  // Copy semantics
+  VecBuffer(const VecBuffer&) = default;
+  VecBuffer& operator=(const VecBuffer&) = default;
+
+  // Move semantics
+  VecBuffer(VecBuffer&&) = default;
+  VecBuffer& operator=(VecBuffer&&) = default;
+
+  // Mutators
+  void set(std::size_t index, const Vec3<T>& value);
+  void set(const Vec3<T> *values, std::size_t size);
+  template <class Iterator>
+  void set(Iterator first, Iterator last);
+  void set(std::initializer_list<Vec3<T>> list);
+  void push(const Vec3<T>& value);
+  void resize(std::size_t size);
+  void reserve(std::size_t size);
+  void reset();
+
+  // Element access
+  Vec3<T> operator[](std::size_t index) const { return at(index); }
+  Vec3<T> at(std::size_t index) const;
+  Vec3<T> front() const { return at(0); }
+  Vec3<T> back() const { return at(size() - 1); }
+
+  // Conversion
+  template <class Iterator>
+  Iterator copy(Iterator result) const;
+  std::vector<Vec3<T>> vectors() const;
+
+  // Attributes
+  bool empty() const { return x.empty(); }
+  std::size_t size() const { return x.size(); }
+
+  // Arithmetic
+  VecBuffer& operator+=(const VecBuffer& other);
+  VecBuffer& operator-=(const VecBuffer& other);
+  VecBuffer& operator*=(const VecBuffer& other);
+  VecBuffer& operator/=(const VecBuffer& other);
+
+  // Vector arithmetic
+  VecBuffer& operator+=(const Vec3<T>& vector);
+  VecBuffer& operator-=(const Vec3<T>& vector);
+  VecBuffer& operator*=(const Vec3<T>& vector);
+  VecBuffer& operator/=(const Vec3<T>& vector);
+
+  // Scalar arithmetic
+  VecBuffer& operator+=(T scalar);
+  VecBuffer& operator-=(T scalar);
+  VecBuffer& operator*=(T scalar);
+  VecBuffer& operator/=(T scalar);
+
+  // Magnitude
+  void magnitude(Promote<T> *result) const;
+  void magnitudeSquared(Promote<T> *result) const;
+
+  // Normalization
+  VecBuffer& normalize();
+  VecBuffer normalized() const;
+  VecBuffer& normalizeFast();
+  VecBuffer normalizedFast() const;
+
+  // Products
+  void dot(const VecBuffer& other, Promote<T> *result) const;
+  void cross(const VecBuffer& other, VecBuffer *result) const;
+  VecBuffer cross(const VecBuffer& other) const;
+
+ private:
+  template <class Operation>
+  static void apply(const T *values, Container *result, Operation operation);
+  template <class Operation>
+  static void apply(T value, Container *result, Operation operation);
+  void magnitudeSquared(Promote<T> *result, std::size_t first) const;
+
+ public:
+  Container x;
+  Container y;
+  Container z;
+};
+
+// Arithmetic
+template <class T>
+Vec3Buffer<T> operator+(const Vec3Buffer<T>& lhs, const Vec3Buffer<T>& rhs);
+template <class T>
+Vec3Buffer<T> operator-(const Vec3Buffer<T>& lhs, const Vec3Buffer<T>& rhs);
+template <class T>
+Vec3Buffer<T> operator*(const Vec3Buffer<T>& lhs, const Vec3Buffer<T>& rhs);
+template <class T>
+Vec3Buffer<T> operator/(const Vec3Buffer<T>& lhs, const Vec3Buffer<T>& rhs);
+
+// Scalar arithmetic
+template <class T>
+Vec3Buffer<T> operator+(const Vec3Buffer<T>& lhs, T rhs);
+template <class T>
+Vec3Buffer<T> operator-(const Vec3Buffer<T>& lhs, T rhs);
+template <class T>
+Vec3Buffer<T> operator*(const Vec3Buffer<T>& lhs, T rhs);
+template <class T>
+Vec3Buffer<T> operator/(const Vec3Buffer<T>& lhs, T rhs);
+
+using Vec3iBuffer = Vec3Buffer<int>;
+using Vec3fBuffer = Vec3Buffer<float>;
+using Vec3dBuffer = Vec3Buffer<double>;
+
+// MARK: -
+
+namespace detail {
+
+// Packed registers of the types that have SSE instructions. The kernels
+// below evaluate the same operations in the same order as the scalar loops,
+// so that both produce identical results.
+template <class T>
+struct HasPacked : std::false_type {};
+
+template <class T>
+struct Packed;
+
+#if SHOTAMATSUDA_HAS_SSE
+
+template <>
+struct HasPacked<float> : std::true_type {};
+
+template <>
+struct Packed<float> {
+  using Type = __m128;
+  static constexpr std::size_t size = 4;
+  static Type load(const float *values) { return _mm_loadu_ps(values); }
+  static void store(float *values, Type a) { _mm_storeu_ps(values, a); }
+  static Type set(float value) { return _mm_set1_ps(value); }
+  static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+  static Type subtract(Type a, Type b) { return _mm_sub_ps(a, b); }
+  static Type multiply(Type a, Type b) { return _mm_mul_ps(a, b); }
+  static Type divide(Type a, Type b) { return _mm_div_ps(a, b); }
+  static Type sqrt(Type a) { return _mm_sqrt_ps(a); }
+  static Type equal(Type a, Type b) { return _mm_cmpeq_ps(a, b); }
+  static Type select(Type mask, Type a, Type b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+};
+
+#endif  // SHOTAMATSUDA_HAS_SSE
+
+#if SHOTAMATSUDA_HAS_SSE2
+
+template <>
+struct HasPacked<double> : std::true_type {};
+
+template <>
+struct Packed<double> {
+  using Type = __m128d;
+  static constexpr std::size_t size = 2;
+  static Type load(const double *values) { return _mm_loadu_pd(values); }
+  static void store(double *values, Type a) { _mm_storeu_pd(values, a); }
+  static Type set(double value) { return _mm_set1_pd(value); }
+  static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+  static Type subtract(Type a, Type b) { return _mm_sub_pd(a, b); }
+  static Type multiply(Type a, Type b) { return _mm_mul_pd(a, b); }
+  static Type divide(Type a, Type b) { return _mm_div_pd(a, b); }
+  static Type sqrt(Type a) { return _mm_sqrt_pd(a); }
+  static Type equal(Type a, Type b) { return _mm_cmpeq_pd(a, b); }
+  static Type select(Type mask, Type a, Type b) {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+  }
+};
+
+#endif  // SHOTAMATSUDA_HAS_SSE2
+
+template <class T, class Type>
+inline Type applyPacked(std::plus<T>, Type a, Type b) {
+  return Packed<T>::add(a, b);
+}
+
+template <class T, class Type>
+inline Type applyPacked(std::minus<T>, Type a, Type b) {
+  return Packed<T>::subtract(a, b);
+}
+
+template <class T, class Type>
+inline Type applyPacked(std::multiplies<T>, Type a, Type b) {
+  return Packed<T>::multiply(a, b);
+}
+
+template <class T, class Type>
+inline Type applyPacked(std::divides<T>, Type a, Type b) {
+  return Packed<T>::divide(a, b);
+}
+
+// Each kernel processes the leading elements that fill whole registers, and
+// returns the number of them for the scalar loops to continue from
+
+template <class T, class Operation>
+inline std::size_t applyPacked(const T *, T *, std::size_t, Operation,
+                               std::false_type) {
+  return 0;
+}
+
+template <class T, class Operation>
+inline std::size_t applyPacked(const T *values, T *data, std::size_t size,
+                               Operation operation, std::true_type) {
+  using P = Packed<T>;
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    P::store(data + i, applyPacked(operation, P::load(data + i),
+                                   P::load(values + i)));
+  }
+  return i;
+}
+
+template <class T, class Operation>
+inline std::size_t applyPacked(T, T *, std::size_t, Operation,
+                               std::false_type) {
+  return 0;
+}
+
+template <class T, class Operation>
+inline std::size_t applyPacked(T value, T *data, std::size_t size,
+                               Operation operation, std::true_type) {
+  using P = Packed<T>;
+  const auto packed = P::set(value);
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    P::store(data + i, applyPacked(operation, P::load(data + i), packed));
+  }
+  return i;
+}
+
+template <class T, class U>
+inline std::size_t dotPacked(const T *, const T *, const T *, const T *,
+                             const T *, const T *, std::size_t, U *,
+                             std::false_type) {
+  return 0;
+}
+
+template <class T>
+inline std::size_t dotPacked(const T *ax, const T *ay, const T *az,
+                             const T *bx, const T *by, const T *bz,
+                             std::size_t size, T *result, std::true_type) {
+  using P = Packed<T>;
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    P::store(result + i, P::add(P::add(
+        P::multiply(P::load(ax + i), P::load(bx + i)),
+        P::multiply(P::load(ay + i), P::load(by + i))),
+        P::multiply(P::load(az + i), P::load(bz + i))));
+  }
+  return i;
+}
+
+template <class T>
+inline std::size_t crossPacked(const T *, const T *, const T *,
+                               const T *, const T *, const T *,
+                               std::size_t, T *, T *, T *, std::false_type) {
+  return 0;
+}
+
+template <class T>
+inline std::size_t crossPacked(const T *ax, const T *ay, const T *az,
+                               const T *bx, const T *by, const T *bz,
+                               std::size_t size, T *rx, T *ry, T *rz,
+                               std::true_type) {
+  using P = Packed<T>;
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    const auto x1 = P::load(ax + i);
+    const auto y1 = P::load(ay + i);
+    const auto z1 = P::load(az + i);
+    const auto x2 = P::load(bx + i);
+    const auto y2 = P::load(by + i);
+    const auto z2 = P::load(bz + i);
+    P::store(rx + i, P::subtract(P::multiply(y1, z2), P::multiply(z1, y2)));
+    P::store(ry + i, P::subtract(P::multiply(z1, x2), P::multiply(x1, z2)));
+    P::store(rz + i, P::subtract(P::multiply(x1, y2), P::multiply(y1, x2)));
+  }
+  return i;
+}
+
+template <class T, class U>
+inline std::size_t magnitudePacked(const T *, const T *, const T *,
+                                   std::size_t, U *, bool, std::false_type) {
+  return 0;
+}
+
+template <class T>
+inline std::size_t magnitudePacked(const T *ax, const T *ay, const T *az,
+                                   std::size_t size, T *result, bool root,
+                                   std::true_type) {
+  using P = Packed<T>;
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    const auto x = P::load(ax + i);
+    const auto y = P::load(ay + i);
+    const auto z = P::load(az + i);
+    auto squared = P::add(P::add(P::multiply(x, x), P::multiply(y, y)),
+                          P::multiply(z, z));
+    P::store(result + i, root ? P::sqrt(squared) : squared);
+  }
+  return i;
+}
+
+template <class T>
+inline std::size_t normalizePacked(T *, T *, T *, std::size_t,
+                                   std::false_type) {
+  return 0;
+}
+
+template <class T>
+inline std::size_t normalizePacked(T *ax, T *ay, T *az, std::size_t size,
+                                   std::true_type) {
+  using P = Packed<T>;
+  const auto zero = P::set(0);
+  const auto one = P::set(1);
+  std::size_t i = 0;
+  for (; i + P::size <= size; i += P::size) {
+    const auto x = P::load(ax + i);
+    const auto y = P::load(ay + i);
+    const auto z = P::load(az + i);
+    const auto magnitude = P::sqrt(P::add(
+        P::add(P::multiply(x, x), P::multiply(y, y)), P::multiply(z, z)));
+    const auto denominator = P::select(P::equal(magnitude, zero),
+                                       one, magnitude);
+    P::store(ax + i, P::divide(x, denominator));
+    P::store(ay + i, P::divide(y, denominator));
+    P::store(az + i, P::divide(z, denominator));
+  }
+  return i;
+}
+
+// Vectors of the types that promote to themselves run in packed registers
+template <class T>
+using IsPacked = std::integral_constant<
+    bool, HasPacked<T>::value && std::is_same<Promote<T>, T>::value>;
+
+}  // namespace detail
+
+template <class T>
+inline VecBuffer<T, 3>::VecBuffer(std::size_t size)
+    : x(size),
+      y(size),
+      z(size) {}
+
+template <class T>
+inline VecBuffer<T, 3>::VecBuffer(std::size_t size, const Vec3<T>& value)
+    : x(size, value.x),
+      y(size, value.y),
+      z(size, value.z) {}
+
+template <class T>
+inline VecBuffer<T, 3>::VecBuffer(const Vec3<T> *values, std::size_t size) {
+  set(values, size);
+}
+
+template <class T>
+template <class Iterator>
+inline VecBuffer<T, 3>::VecBuffer(Iterator first, Iterator last) {
+  set(first, last);
+}
+
+template <class T>
+inline VecBuffer<T, 3>::VecBuffer(std::initializer_list<Vec3<T>> list) {
+  set(list);
+}
+
+// MARK: Mutators
+
+template <class T>
+inline void VecBuffer<T, 3>::set(std::size_t index, const Vec3<T>& value) {
+  assert(index < size());
+  x[index] = value.x;
+  y[index] = value.y;
+  z[index] = value.z;
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::set(const Vec3<T> *values, std::size_t size) {
+  assert(values || !size);
+  resize(size);
+  T * const vx = x.data();
+  T * const vy = y.data();
+  T * const vz = z.data();
+  for (std::size_t i = 0; i < size; ++i) {
+    vx[i] = values[i].x;
+    vy[i] = values[i].y;
+    vz[i] = values[i].z;
+  }
+}
+
+template <class T>
+template <class Iterator>
+inline void VecBuffer<T, 3>::set(Iterator first, Iterator last) {
+  reset();
+  reserve(std::distance(first, last));
+  for (auto itr = first; itr != last; ++itr) {
+    push(*itr);
+  }
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::set(std::initializer_list<Vec3<T>> list) {
+  set(std::begin(list), std::end(list));
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::push(const Vec3<T>& value) {
+  x.push_back(value.x);
+  y.push_back(value.y);
+  z.push_back(value.z);
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::resize(std::size_t size) {
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::reserve(std::size_t size) {
+  x.reserve(size);
+  y.reserve(size);
+  z.reserve(size);
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::reset() {
+  x.clear();
+  y.clear();
+  z.clear();
+}
+
+// MARK: Element access
+
+template <class T>
+inline Vec3<T> VecBuffer<T, 3>::at(std::size_t index) const {
+  assert(index < size());
+  return Vec3<T>(x[index], y[index], z[index]);
+}
+
+// MARK: Conversion
+
+template <class T>
+template <class Iterator>
+inline Iterator VecBuffer<T, 3>::copy(Iterator result) const {
+  const auto size = this->size();
+  for (std::size_t i = 0; i < size; ++i, ++result) {
+    *result = Vec3<T>(x[i], y[i], z[i]);
+  }
+  return result;
+}
+
+template <class T>
+inline std::vector<Vec3<T>> VecBuffer<T, 3>::vectors() const {
+  std::vector<Vec3<T>> result(size());
+  copy(result.begin());
+  return result;
+}
+
+// MARK: Arithmetic
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator+=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::plus<T>());
+  apply(other.y.data(), &y, std::plus<T>());
+  apply(other.z.data(), &z, std::plus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator-=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::minus<T>());
+  apply(other.y.data(), &y, std::minus<T>());
+  apply(other.z.data(), &z, std::minus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator*=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::multiplies<T>());
+  apply(other.y.data(), &y, std::multiplies<T>());
+  apply(other.z.data(), &z, std::multiplies<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator/=(const VecBuffer& other) {
+  assert(other.size() == size());
+  apply(other.x.data(), &x, std::divides<T>());
+  apply(other.y.data(), &y, std::divides<T>());
+  apply(other.z.data(), &z, std::divides<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator+(const Vec3Buffer<T>& lhs,
+                               const Vec3Buffer<T>& rhs) {
+  return Vec3Buffer<T>(lhs) += rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator-(const Vec3Buffer<T>& lhs,
+                               const Vec3Buffer<T>& rhs) {
+  return Vec3Buffer<T>(lhs) -= rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator*(const Vec3Buffer<T>& lhs,
+                               const Vec3Buffer<T>& rhs) {
+  return Vec3Buffer<T>(lhs) *= rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator/(const Vec3Buffer<T>& lhs,
+                               const Vec3Buffer<T>& rhs) {
+  return Vec3Buffer<T>(lhs) /= rhs;
+}
+
+// MARK: Vector arithmetic
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator+=(const Vec3<T>& vector) {
+  apply(vector.x, &x, std::plus<T>());
+  apply(vector.y, &y, std::plus<T>());
+  apply(vector.z, &z, std::plus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator-=(const Vec3<T>& vector) {
+  apply(vector.x, &x, std::minus<T>());
+  apply(vector.y, &y, std::minus<T>());
+  apply(vector.z, &z, std::minus<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator*=(const Vec3<T>& vector) {
+  apply(vector.x, &x, std::multiplies<T>());
+  apply(vector.y, &y, std::multiplies<T>());
+  apply(vector.z, &z, std::multiplies<T>());
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator/=(const Vec3<T>& vector) {
+  apply(vector.x, &x, std::divides<T>());
+  apply(vector.y, &y, std::divides<T>());
+  apply(vector.z, &z, std::divides<T>());
+  return *this;
+}
+
+// MARK: Scalar arithmetic
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator+=(T scalar) {
+  return *this += Vec3<T>(scalar);
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator-=(T scalar) {
+  return *this -= Vec3<T>(scalar);
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator*=(T scalar) {
+  return *this *= Vec3<T>(scalar);
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::operator/=(T scalar) {
+  return *this /= Vec3<T>(scalar);
+}
+
+template <class T>
+inline Vec3Buffer<T> operator+(const Vec3Buffer<T>& lhs, T rhs) {
+  return Vec3Buffer<T>(lhs) += rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator-(const Vec3Buffer<T>& lhs, T rhs) {
+  return Vec3Buffer<T>(lhs) -= rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator*(const Vec3Buffer<T>& lhs, T rhs) {
+  return Vec3Buffer<T>(lhs) *= rhs;
+}
+
+template <class T>
+inline Vec3Buffer<T> operator/(const Vec3Buffer<T>& lhs, T rhs) {
+  return Vec3Buffer<T>(lhs) /= rhs;
+}
+
+// MARK: Element-wise operation
+
+template <class T>
+template <class Operation>
+inline void VecBuffer<T, 3>::apply(const T *values,
+                                   Container *result,
+                                   Operation operation) {
+  const auto size = result->size();
+  T * const data = result->data();
+  auto i = detail::applyPacked(values, data, size, operation,
+                               detail::HasPacked<T>());
+  for (; i < size; ++i) {
+    data[i] = operation(data[i], values[i]);
+  }
+}
+
+template <class T>
+template <class Operation>
+inline void VecBuffer<T, 3>::apply(T value,
+                                   Container *result,
+                                   Operation operation) {
+  const auto size = result->size();
+  T * const data = result->data();
+  auto i = detail::applyPacked(value, data, size, operation,
+                               detail::HasPacked<T>());
+  for (; i < size; ++i) {
+    data[i] = operation(data[i], value);
+  }
+}
+
+// MARK: Magnitude
+
+template <class T>
+inline void VecBuffer<T, 3>::magnitude(Promote<T> *result) const {
+  assert(result || empty());
+  const auto size = this->size();
+  const auto packed = detail::magnitudePacked(
+      x.data(), y.data(), z.data(), size, result, true,
+      detail::IsPacked<T>());
+  magnitudeSquared(result, packed);
+  for (auto i = packed; i < size; ++i) {
+    result[i] = std::sqrt(result[i]);
+  }
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::magnitudeSquared(Promote<T> *result) const {
+  assert(result || empty());
+  magnitudeSquared(result, detail::magnitudePacked(
+      x.data(), y.data(), z.data(), size(), result, false,
+      detail::IsPacked<T>()));
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::magnitudeSquared(Promote<T> *result,
+                                              std::size_t first) const {
+  using V = Promote<T>;
+  const auto size = this->size();
+  const T * const ax = x.data();
+  const T * const ay = y.data();
+  const T * const az = z.data();
+  for (auto i = first; i < size; ++i) {
+    result[i] = static_cast<V>(ax[i]) * ax[i] +
+                static_cast<V>(ay[i]) * ay[i] +
+                static_cast<V>(az[i]) * az[i];
+  }
+}
+
+// MARK: Normalization
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::normalize() {
+  using V = Promote<T>;
+  const auto size = this->size();
+  T * const ax = x.data();
+  T * const ay = y.data();
+  T * const az = z.data();
+  auto i = detail::normalizePacked(ax, ay, az, size, detail::IsPacked<T>());
+  for (; i < size; ++i) {
+    const V magnitude = std::sqrt(static_cast<V>(ax[i]) * ax[i] +
+                                  static_cast<V>(ay[i]) * ay[i] +
+                                  static_cast<V>(az[i]) * az[i]);
+    // Zero vectors stay zero, as in Vec::normalize()
+    const V denominator = magnitude ? magnitude : 1;
+    ax[i] /= denominator;
+    ay[i] /= denominator;
+    az[i] /= denominator;
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T> VecBuffer<T, 3>::normalized() const {
+  return VecBuffer(*this).normalize();
+}
+
+template <class T>
+inline Vec3Buffer<T>& VecBuffer<T, 3>::normalizeFast() {
+  using V = Promote<T>;
+  // Squared magnitudes are converted in blocks that stay in the L1 cache
+  constexpr std::size_t block = 256;
+  V squared[block];
+  V factors[block];
+  const auto size = this->size();
+  T * const ax = x.data();
+  T * const ay = y.data();
+  T * const az = z.data();
+  for (std::size_t first = 0; first < size; first += block) {
+    const auto count = std::min(block, size - first);
+    const T * const bx = ax + first;
+    const T * const by = ay + first;
+    const T * const bz = az + first;
+    for (std::size_t i = 0; i < count; ++i) {
+      squared[i] = (static_cast<V>(bx[i]) * bx[i] +
+                    static_cast<V>(by[i]) * by[i] +
+                    static_cast<V>(bz[i]) * bz[i]);
+    }
+    rsqrt(squared, static_cast<int>(count), factors);
+    for (std::size_t i = 0; i < count; ++i) {
+      // Zero vectors stay zero, as in Vec::normalizeFast()
+      const V factor = squared[i] ? factors[i] : 0;
+      ax[first + i] *= factor;
+      ay[first + i] *= factor;
+      az[first + i] *= factor;
+    }
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec3Buffer<T> VecBuffer<T, 3>::normalizedFast() const {
+  return VecBuffer(*this).normalizeFast();
+}
+
+// MARK: Products
+
+template <class T>
+inline void VecBuffer<T, 3>::dot(const VecBuffer& other,
+                                 Promote<T> *result) const {
+  assert(other.size() == size());
+  assert(result || empty());
+  using V = Promote<T>;
+  const auto size = this->size();
+  const T * const ax = x.data();
+  const T * const ay = y.data();
+  const T * const az = z.data();
+  const T * const bx = other.x.data();
+  const T * const by = other.y.data();
+  const T * const bz = other.z.data();
+  auto i = detail::dotPacked(ax, ay, az, bx, by, bz, size, result,
+                             detail::IsPacked<T>());
+  for (; i < size; ++i) {
+    result[i] = static_cast<V>(ax[i]) * bx[i] +
+                static_cast<V>(ay[i]) * by[i] +
+                static_cast<V>(az[i]) * bz[i];
+  }
+}
+
+template <class T>
+inline void VecBuffer<T, 3>::cross(const VecBuffer& other,
+                                   VecBuffer *result) const {
+  assert(other.size() == size());
+  assert(result);
+  assert(result != this && result != &other);
+  const auto size = this->size();
+  result->resize(size);
+  const T * const ax = x.data();
+  const T * const ay = y.data();
+  const T * const az = z.data();
+  const T * const bx = other.x.data();
+  const T * const by = other.y.data();
+  const T * const bz = other.z.data();
+  T * const rx = result->x.data();
+  T * const ry = result->y.data();
+  T * const rz = result->z.data();
+  auto i = detail::crossPacked(ax, ay, az, bx, by, bz, size, rx, ry, rz,
+                               detail::HasPacked<T>());
+  for (; i < size; ++i) {
+    rx[i] = ay[i] * bz[i] - az[i] * by[i];
+    ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+    rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+  }
+}
+
+template <class T>
+inline Vec3Buffer<T> VecBuffer<T, 3>::cross(const VecBuffer& other) const {
+  VecBuffer result;
+  cross(other, &result);
+  return result;
+}
+
+}  // namespace math
+
+using math::VecBuffer;
+using math::Vec3Buffer;
+using math::Vec3iBuffer;
+using math::Vec3fBuffer;
+using math::Vec3dBuffer;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_VECTOR3_BUFFER_H_
@@ -48,8 +48,10 @@
 
 #include "shotamatsuda/math/axis.h"
 #include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/hash.h"
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rsqrt.h"
 
 namespace shotamatsuda {
 namespace math {
@@ -75,17 +77,17 @@ class Vec<T, 4> final {
   static constexpr const int dimensions = 4;
 
  public:
-  Vec();
-  explicit Vec(T value);
-  Vec(T x, T y, T z = T(), T w = T());
-  explicit Vec(const T *values, int size = 4);
+  constexpr Vec();
+  explicit constexpr Vec(T value);
+  constexpr Vec(T x, T y, T z = T(), T w = T());
+  explicit constexpr Vec(const T *values, int size = 4);
   template <class... Args>
   Vec(const std::tuple<Args...>& tuple);
-  Vec(std::initializer_list<T> list);
+  constexpr Vec(std::initializer_list<T> list);
 
   // Implicit conversion
   template <class U>
-  Vec(const Vec4<U>& other);
+  constexpr Vec(const Vec4<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENFRAMEWORKS
   Vec(const ofVec4f& other);
@@ -101,9 +103,9 @@ class Vec<T, 4> final {
 
   // Explicit conversion
   template <class U>
-  explicit Vec(const Vec2<U>& other);
+  explicit constexpr Vec(const Vec2<U>& other);
   template <class U>
-  explicit Vec(const Vec3<U>& other);
+  explicit constexpr Vec(const Vec3<U>& other);
 
 #if SHOTAMATSUDA_HAS_OPENCV
   template <class U>
@@ -117,8 +119,8 @@ class Vec<T, 4> final {
   Vec& operator=(const Vec&) = default;
 
   // Factory
-  static Vec min();
-  static Vec max();
+  static constexpr Vec min();
+  static constexpr Vec max();
   static Vec headingXY(Promote<T> angle);
   static Vec headingYZ(Promote<T> angle);
   static Vec headingZX(Promote<T> angle);
@@ -131,46 +133,50 @@ class Vec<T, 4> final {
   static Vec random(T max, Random *random);
   template <class Random>
   static Vec random(T min, T max, Random *random);
+  static void random(Vec *values, std::size_t size, T min, T max);
+  template <class Random>
+  static void random(Vec *values, std::size_t size, T min, T max,
+                     Random *random);
 
   // Mutators
-  void set(T value);
-  void set(T x, T y, T z = T(), T w = T());
-  void set(const T *values, int size = 4);
+  constexpr void set(T value);
+  constexpr void set(T x, T y, T z = T(), T w = T());
+  constexpr void set(const T *values, int size = 4);
   template <class... Args>
   void set(const std::tuple<Args...>& tuple);
-  void set(std::initializer_list<T> list);
-  void reset();
+  constexpr void set(std::initializer_list<T> list);
+  constexpr void reset();
 
   // Element access
-  T& operator[](int index) { return at(index); }
-  const T& operator[](int index) const { return at(index); }
-  T& operator[](Axis axis) { return at(axis); }
-  const T& operator[](Axis axis) const { return at(axis); }
-  T& at(int index);
-  const T& at(int index) const;
-  T& at(Axis axis);
-  const T& at(Axis axis) const;
-  T& front() { return x; }
-  const T& front() const { return x; }
-  T& back() { return w; }
-  const T& back() const { return w; }
+  constexpr T& operator[](int index) { return at(index); }
+  constexpr const T& operator[](int index) const { return at(index); }
+  constexpr T& operator[](Axis axis) { return at(axis); }
+  constexpr const T& operator[](Axis axis) const { return at(axis); }
+  constexpr T& at(int index);
+  constexpr const T& at(int index) const;
+  constexpr T& at(Axis axis);
+  constexpr const T& at(Axis axis) const;
+  constexpr T& front() { return x; }
+  constexpr const T& front() const { return x; }
+  constexpr T& back() { return w; }
+  constexpr const T& back() const { return w; }
 
   // Comparison
   template <class V, class U = T>
   bool equals(const Vec4<U>& other, V tolerance) const;
 
   // Arithmetic
-  Vec& operator+=(const Vec& other);
-  Vec& operator-=(const Vec& other);
-  Vec& operator*=(const Vec& other);
-  Vec& operator/=(const Vec& other);
-  Vec4<Promote<T>> operator-() const;
+  constexpr Vec& operator+=(const Vec& other);
+  constexpr Vec& operator-=(const Vec& other);
+  constexpr Vec& operator*=(const Vec& other);
+  constexpr Vec& operator/=(const Vec& other);
+  constexpr Vec4<Promote<T>> operator-() const;
 
   // Scalar arithmetic
-  Vec& operator+=(T scalar);
-  Vec& operator-=(T scalar);
-  Vec& operator*=(T scalar);
-  Vec& operator/=(T scalar);
+  constexpr Vec& operator+=(T scalar);
+  constexpr Vec& operator-=(T scalar);
+  constexpr Vec& operator*=(T scalar);
+  constexpr Vec& operator/=(T scalar);
 
   // Attributes
   bool empty() const { return !x && !y && !z && !w; }
@@ -194,6 +200,8 @@ class Vec<T, 4> final {
   bool normal() const { return magnitude() == 1; }
   Vec& normalize();
   Vec4<Promote<T>> normalized() const;
+  Vec& normalizeFast();
+  Vec4<Promote<T>> normalizedFast() const;
 
   // Inversion
   Vec& invert();
@@ -248,45 +256,45 @@ class Vec<T, 4> final {
 
 // Comparison
 template <class T, class U>
-bool operator==(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator==(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-bool operator!=(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator!=(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-bool operator<(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator<(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-bool operator>(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator>(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-bool operator<=(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator<=(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-bool operator>=(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr bool operator>=(const Vec4<T>& lhs, const Vec4<U>& rhs);
 
 // Arithmetic
 template <class T, class U>
-Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, const Vec4<U>& rhs);
 template <class T, class U>
-Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, const Vec4<U>& rhs);
 
 // Scalar arithmetic
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, U rhs);
+constexpr Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, U rhs);
+constexpr Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, U rhs);
+constexpr Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<U> * = nullptr>
-Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, U rhs);
+constexpr Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, U rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec4<Promote<T, U>> operator+(T lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator+(T lhs, const Vec4<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec4<Promote<T, U>> operator-(T lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator-(T lhs, const Vec4<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec4<Promote<T, U>> operator*(T lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator*(T lhs, const Vec4<U>& rhs);
 template <class T, class U, EnableIfScalar<T> * = nullptr>
-Vec4<Promote<T, U>> operator/(T lhs, const Vec4<U>& rhs);
+constexpr Vec4<Promote<T, U>> operator/(T lhs, const Vec4<U>& rhs);
 
 using Vec4i = Vec4<int>;
 using Vec4f = Vec4<float>;
@@ -303,16 +311,24 @@ using Vector4d = Vec4d;
 // MARK: -
 
 template <class T>
-inline Vec<T, 4>::Vec() : x(), y(), z(), w() {}
+inline constexpr Vec<T, 4>::Vec() : x(), y(), z(), w() {}
 
 template <class T>
-inline Vec<T, 4>::Vec(T value) : x(value), y(value), z(value), w(value) {}
+inline constexpr Vec<T, 4>::Vec(T value)
+    : x(value),
+      y(value),
+      z(value),
+      w(value) {}
 
 template <class T>
-inline Vec<T, 4>::Vec(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
+inline constexpr Vec<T, 4>::Vec(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
 
 template <class T>
-inline Vec<T, 4>::Vec(const T *values, int size) {
+inline constexpr Vec<T, 4>::Vec(const T *values, int size)
+    : x(),
+      y(),
+      z(),
+      w() {
   set(values, size);
 }
 
@@ -323,7 +339,11 @@ inline Vec<T, 4>::Vec(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline Vec<T, 4>::Vec(std::initializer_list<T> list) {
+inline constexpr Vec<T, 4>::Vec(std::initializer_list<T> list)
+    : x(),
+      y(),
+      z(),
+      w() {
   set(list);
 }
 
@@ -331,7 +351,7 @@ inline Vec<T, 4>::Vec(std::initializer_list<T> list) {
 
 template <class T>
 template <class U>
-inline Vec<T, 4>::Vec(const Vec4<U>& other)
+inline constexpr Vec<T, 4>::Vec(const Vec4<U>& other)
     : x(other.x),
       y(other.y),
       z(other.z),
@@ -375,7 +395,7 @@ inline Vec<T, 4>::operator ci::Vec4<U>() const {
 
 template <class T>
 template <class U>
-inline Vec<T, 4>::Vec(const Vec2<U>& other)
+inline constexpr Vec<T, 4>::Vec(const Vec2<U>& other)
     : x(other.x),
       y(other.y),
       z(),
@@ -383,7 +403,7 @@ inline Vec<T, 4>::Vec(const Vec2<U>& other)
 
 template <class T>
 template <class U>
-inline Vec<T, 4>::Vec(const Vec3<U>& other)
+inline constexpr Vec<T, 4>::Vec(const Vec3<U>& other)
     : x(other.x),
       y(other.y),
       z(other.z),
@@ -406,7 +426,7 @@ inline Vec<T, 4>::operator cv::Vec<U, 4>() const {
 // MARK: Factory
 
 template <class T>
-inline Vec4<T> Vec<T, 4>::min() {
+inline constexpr Vec4<T> Vec<T, 4>::min() {
   return Vec(std::numeric_limits<T>::min(),
              std::numeric_limits<T>::min(),
              std::numeric_limits<T>::min(),
@@ -414,7 +434,7 @@ inline Vec4<T> Vec<T, 4>::min() {
 }
 
 template <class T>
-inline Vec4<T> Vec<T, 4>::max() {
+inline constexpr Vec4<T> Vec<T, 4>::max() {
   return Vec(std::numeric_limits<T>::max(),
              std::numeric_limits<T>::max(),
              std::numeric_limits<T>::max(),
@@ -438,17 +458,17 @@ inline Vec4<T> Vec<T, 4>::headingZX(Promote<T> angle) {
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random() {
-  return random(&Random<>::shared());
+  return random(&Random<>::local());
 }
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &Random<>::local());
 }
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &Random<>::local());
 }
 
 template <class T>
@@ -475,15 +495,30 @@ inline Vec4<T> Vec<T, 4>::random(T min, T max, Random *random) {
              random->template uniform<T>(min, max));
 }
 
+template <class T>
+inline void Vec<T, 4>::random(Vec *values, std::size_t size, T min, T max) {
+  random(values, size, min, max, &Random<>::local());
+}
+
+template <class T>
+template <class Random>
+inline void Vec<T, 4>::random(Vec *values, std::size_t size, T min, T max,
+                              Random *random) {
+  static_assert(sizeof(Vec) == 4 * sizeof(T),
+                "Vectors must be tightly packed");
+  assert(random);
+  random->fillUniform(reinterpret_cast<T *>(values), size * 4, min, max);
+}
+
 // MARK: Mutators
 
 template <class T>
-inline void Vec<T, 4>::set(T value) {
+inline constexpr void Vec<T, 4>::set(T value) {
   x = y = z = w = value;
 }
 
 template <class T>
-inline void Vec<T, 4>::set(T x, T y, T z, T w) {
+inline constexpr void Vec<T, 4>::set(T x, T y, T z, T w) {
   this->x = x;
   this->y = y;
   this->z = z;
@@ -491,7 +526,7 @@ inline void Vec<T, 4>::set(T x, T y, T z, T w) {
 }
 
 template <class T>
-inline void Vec<T, 4>::set(const T *values, int size) {
+inline constexpr void Vec<T, 4>::set(const T *values, int size) {
   reset();
   const auto end = values + size;
   if (values == end) return;
@@ -511,7 +546,7 @@ inline void Vec<T, 4>::set(const std::tuple<Args...>& tuple) {
 }
 
 template <class T>
-inline void Vec<T, 4>::set(std::initializer_list<T> list) {
+inline constexpr void Vec<T, 4>::set(std::initializer_list<T> list) {
   reset();
   auto itr = std::begin(list);
   if (itr == std::end(list)) return;
@@ -525,14 +560,14 @@ inline void Vec<T, 4>::set(std::initializer_list<T> list) {
 }
 
 template <class T>
-inline void Vec<T, 4>::reset() {
+inline constexpr void Vec<T, 4>::reset() {
   *this = Vec();
 }
 
 // MARK: Element access
 
 template <class T>
-inline T& Vec<T, 4>::at(int index) {
+inline constexpr T& Vec<T, 4>::at(int index) {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -546,7 +581,7 @@ inline T& Vec<T, 4>::at(int index) {
 }
 
 template <class T>
-inline const T& Vec<T, 4>::at(int index) const {
+inline constexpr const T& Vec<T, 4>::at(int index) const {
   switch (index) {
     case 0: return x;
     case 1: return y;
@@ -560,48 +595,48 @@ inline const T& Vec<T, 4>::at(int index) const {
 }
 
 template <class T>
-inline T& Vec<T, 4>::at(Axis axis) {
+inline constexpr T& Vec<T, 4>::at(Axis axis) {
   return at(static_cast<int>(axis));
 }
 
 template <class T>
-inline const T& Vec<T, 4>::at(Axis axis) const {
+inline constexpr const T& Vec<T, 4>::at(Axis axis) const {
   return at(static_cast<int>(axis));
 }
 
 // MARK: Comparison
 
 template <class T, class U>
-inline bool operator==(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator==(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z && lhs.w == rhs.w;
 }
 
 template <class T, class U>
-inline bool operator!=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator!=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return !(lhs == rhs);
 }
 
 template <class T, class U>
-inline bool operator<(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator<(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return lhs.x < rhs.x || (lhs.x == rhs.x &&
         (lhs.y < rhs.y || (lhs.y == rhs.y &&
         (lhs.z < rhs.y || (lhs.z == rhs.y && lhs.w < rhs.w)))));
 }
 
 template <class T, class U>
-inline bool operator>(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator>(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return lhs.x > rhs.x || (lhs.x == rhs.x &&
         (lhs.y > rhs.y || (lhs.y == rhs.y &&
         (lhs.z > rhs.y || (lhs.z == rhs.y && lhs.w > rhs.w)))));
 }
 
 template <class T, class U>
-inline bool operator<=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator<=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return lhs < rhs || lhs == rhs;
 }
 
 template <class T, class U>
-inline bool operator>=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr bool operator>=(const Vec4<T>& lhs, const Vec4<U>& rhs) {
   return lhs > rhs || lhs == rhs;
 }
 
@@ -617,7 +652,7 @@ inline bool Vec<T, 4>::equals(const Vec4<U>& other, V tolerance) const {
 // MARK: Arithmetic
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator+=(const Vec& other) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator+=(const Vec& other) {
   x += other.x;
   y += other.y;
   z += other.z;
@@ -626,7 +661,7 @@ inline Vec4<T>& Vec<T, 4>::operator+=(const Vec& other) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator-=(const Vec& other) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator-=(const Vec& other) {
   x -= other.x;
   y -= other.y;
   z -= other.z;
@@ -635,7 +670,7 @@ inline Vec4<T>& Vec<T, 4>::operator-=(const Vec& other) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator*=(const Vec& other) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator*=(const Vec& other) {
   x *= other.x;
   y *= other.y;
   z *= other.z;
@@ -644,7 +679,7 @@ inline Vec4<T>& Vec<T, 4>::operator*=(const Vec& other) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator/=(const Vec& other) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator/=(const Vec& other) {
   x /= other.x;
   y /= other.y;
   z /= other.z;
@@ -653,7 +688,7 @@ inline Vec4<T>& Vec<T, 4>::operator/=(const Vec& other) {
 }
 
 template <class T>
-inline Vec4<Promote<T>> Vec<T, 4>::operator-() const {
+inline constexpr Vec4<Promote<T>> Vec<T, 4>::operator-() const {
   using V = Promote<T>;
   return Vec4<V>(-static_cast<V>(x),
                  -static_cast<V>(y),
@@ -662,7 +697,8 @@ inline Vec4<Promote<T>> Vec<T, 4>::operator-() const {
 }
 
 template <class T, class U>
-inline Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs,
+                                               const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) + rhs.x,
                  static_cast<V>(lhs.y) + rhs.y,
@@ -671,7 +707,8 @@ inline Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs,
+                                               const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) - rhs.x,
                  static_cast<V>(lhs.y) - rhs.y,
@@ -680,7 +717,8 @@ inline Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs,
+                                               const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) * rhs.x,
                  static_cast<V>(lhs.y) * rhs.y,
@@ -689,7 +727,8 @@ inline Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U>
-inline Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs,
+                                               const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) / rhs.x,
                  static_cast<V>(lhs.y) / rhs.y,
@@ -700,7 +739,7 @@ inline Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, const Vec4<U>& rhs) {
 // MARK: Scalar arithmetic
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator+=(T scalar) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator+=(T scalar) {
   x += scalar;
   y += scalar;
   z += scalar;
@@ -709,7 +748,7 @@ inline Vec4<T>& Vec<T, 4>::operator+=(T scalar) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator-=(T scalar) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator-=(T scalar) {
   x -= scalar;
   y -= scalar;
   z -= scalar;
@@ -718,7 +757,7 @@ inline Vec4<T>& Vec<T, 4>::operator-=(T scalar) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator*=(T scalar) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator*=(T scalar) {
   x *= scalar;
   y *= scalar;
   z *= scalar;
@@ -727,7 +766,7 @@ inline Vec4<T>& Vec<T, 4>::operator*=(T scalar) {
 }
 
 template <class T>
-inline Vec4<T>& Vec<T, 4>::operator/=(T scalar) {
+inline constexpr Vec4<T>& Vec<T, 4>::operator/=(T scalar) {
   x /= scalar;
   y /= scalar;
   z /= scalar;
@@ -736,7 +775,7 @@ inline Vec4<T>& Vec<T, 4>::operator/=(T scalar) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, U rhs) {
+inline constexpr Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) + rhs,
                  static_cast<V>(lhs.y) + rhs,
@@ -745,7 +784,7 @@ inline Vec4<Promote<T, U>> operator+(const Vec4<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, U rhs) {
+inline constexpr Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) - rhs,
                  static_cast<V>(lhs.y) - rhs,
@@ -754,7 +793,7 @@ inline Vec4<Promote<T, U>> operator-(const Vec4<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, U rhs) {
+inline constexpr Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) * rhs,
                  static_cast<V>(lhs.y) * rhs,
@@ -763,7 +802,7 @@ inline Vec4<Promote<T, U>> operator*(const Vec4<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<U> *>
-inline Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, U rhs) {
+inline constexpr Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, U rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs.x) / rhs,
                  static_cast<V>(lhs.y) / rhs,
@@ -772,7 +811,7 @@ inline Vec4<Promote<T, U>> operator/(const Vec4<T>& lhs, U rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec4<Promote<T, U>> operator+(T lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator+(T lhs, const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs) + rhs.x,
                  static_cast<V>(lhs) + rhs.y,
@@ -781,7 +820,7 @@ inline Vec4<Promote<T, U>> operator+(T lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec4<Promote<T, U>> operator-(T lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator-(T lhs, const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs) - rhs.x,
                  static_cast<V>(lhs) - rhs.y,
@@ -790,7 +829,7 @@ inline Vec4<Promote<T, U>> operator-(T lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec4<Promote<T, U>> operator*(T lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator*(T lhs, const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs) * rhs.x,
                  static_cast<V>(lhs) * rhs.y,
@@ -799,7 +838,7 @@ inline Vec4<Promote<T, U>> operator*(T lhs, const Vec4<U>& rhs) {
 }
 
 template <class T, class U, EnableIfScalar<T> *>
-inline Vec4<Promote<T, U>> operator/(T lhs, const Vec4<U>& rhs) {
+inline constexpr Vec4<Promote<T, U>> operator/(T lhs, const Vec4<U>& rhs) {
   using V = Promote<T, U>;
   return Vec4<V>(static_cast<V>(lhs) / rhs.x,
                  static_cast<V>(lhs) / rhs.y,
@@ -874,6 +913,20 @@ inline Vec4<Promote<T>> Vec<T, 4>::normalized() const {
   return Vec4<Promote<T>>(*this).normalize();
 }
 
+template <class T>
+inline Vec4<T>& Vec<T, 4>::normalizeFast() {
+  const auto squared = magnitudeSquared();
+  if (squared) {
+    *this *= rsqrt(squared);
+  }
+  return *this;
+}
+
+template <class T>
+inline Vec4<Promote<T>> Vec<T, 4>::normalizedFast() const {
+  return Vec4<Promote<T>>(*this).normalizeFast();
+}
+
 // MARK: Inversion
 
 template <class T>
@@ -936,7 +989,7 @@ inline Vec4<Promote<T, U>> Vec<T, 4>::lerp(const Vec4<U>& other,
 template <class T>
 template <class U>
 inline Vec4<T>& Vec<T, 4>::jitter(const Vec4<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &Random<>::local());
 }
 
 template <class T>
@@ -993,11 +1046,7 @@ using math::Vector4d;
 template <class T>
 struct std::hash<shotamatsuda::math::Vec4<T>> {
   std::size_t operator()(const shotamatsuda::math::Vec4<T>& value) const {
-    std::hash<T> hash;
-    return ((hash(value.x) << 0) ^
-            (hash(value.y) << 1) ^
-            (hash(value.z) << 2) ^
-            (hash(value.w) << 3));
+    return shotamatsuda::math::hash(value.x, value.y, value.z, value.w);
   }
 };
 
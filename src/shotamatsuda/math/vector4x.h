@@ -0,0 +1,503 @@
+//
+//  shotamatsuda/math/vector4x.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_VECTOR4X_H_
+#define SHOTAMATSUDA_MATH_VECTOR4X_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ostream>
+
+#include "shotamatsuda/math/axis.h"
+#include "shotamatsuda/math/rsqrt.h"
+#include "shotamatsuda/math/simd.h"
+#include "shotamatsuda/math/vector4.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Aligned companion of Vec4f whose storage doubles as an SSE register, so
+// that arithmetic and products compile to single packed instructions. The
+// members x, y, z and w are accessible as in Vec4f.
+class alignas(16) Vec4fx final {
+ public:
+  using Type = float;
+  using Iterator = float *;
+  using ConstIterator = const float *;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  static constexpr const int dimensions = 4;
+
+ public:
+  Vec4fx();
+  explicit Vec4fx(float value);
+  Vec4fx(float x, float y, float z = 0.f, float w = 0.f);
+  explicit Vec4fx(const float *values);
+#if SHOTAMATSUDA_HAS_SSE
+  explicit Vec4fx(__m128 vector) : vector(vector) {}
+#endif  // SHOTAMATSUDA_HAS_SSE
+
+  // Implicit conversion
+  Vec4fx(const Vec4f& other);
+  operator Vec4f() const;
+
+  // Copy semantics
+  Vec4fx(const Vec4fx&) = default;
+  Vec4fx& operator=(const Vec4fx&) = default;
+
+  // Mutators
+  void set(float value);
+  void set(float x, float y, float z = 0.f, float w = 0.f);
+  void set(const float *values);
+  void reset();
+
+  // Element access
+  float& operator[](int index) { return at(index); }
+  const float& operator[](int index) const { return at(index); }
+  float& operator[](Axis axis) { return at(axis); }
+  const float& operator[](Axis axis) const { return at(axis); }
+  float& at(int index);
+  const float& at(int index) const;
+  float& at(Axis axis) { return at(static_cast<int>(axis)); }
+  const float& at(Axis axis) const { return at(static_cast<int>(axis)); }
+  float& front() { return x; }
+  const float& front() const { return x; }
+  float& back() { return w; }
+  const float& back() const { return w; }
+
+  // Comparison
+  bool equals(const Vec4fx& other, float tolerance) const;
+
+  // Arithmetic
+  Vec4fx& operator+=(const Vec4fx& other);
+  Vec4fx& operator-=(const Vec4fx& other);
+  Vec4fx& operator*=(const Vec4fx& other);
+  Vec4fx& operator/=(const Vec4fx& other);
+  Vec4fx operator-() const;
+
+  // Scalar arithmetic
+  Vec4fx& operator+=(float scalar);
+  Vec4fx& operator-=(float scalar);
+  Vec4fx& operator*=(float scalar);
+  Vec4fx& operator/=(float scalar);
+
+  // Attributes
+  bool empty() const { return !x && !y && !z && !w; }
+
+  // Magnitude
+  float magnitude() const;
+  float magnitudeSquared() const;
+
+  // Normalization
+  bool normal() const { return magnitude() == 1.f; }
+  Vec4fx& normalize();
+  Vec4fx normalized() const;
+  Vec4fx& normalizeFast();
+  Vec4fx normalizedFast() const;
+
+  // Distance
+  float distance(const Vec4fx& other) const;
+  float distanceSquared(const Vec4fx& other) const;
+
+  // Products
+  float dot(const Vec4fx& other) const;
+
+  // Interpolation
+  Vec4fx lerp(const Vec4fx& other, float factor) const;
+
+  // Iterator
+  Iterator begin() { return &x; }
+  ConstIterator begin() const { return &x; }
+  Iterator end() { return &w + 1; }
+  ConstIterator end() const { return &w + 1; }
+  ReverseIterator rbegin() { return ReverseIterator(end()); }
+  ConstReverseIterator rbegin() const { return ConstReverseIterator(end()); }
+  ReverseIterator rend() { return ReverseIterator(begin()); }
+  ConstReverseIterator rend() const { return ConstReverseIterator(begin()); }
+
+  // Pointer
+  float * pointer() { return &x; }
+  const float * pointer() const { return &x; }
+
+ public:
+  union {
+#if SHOTAMATSUDA_HAS_SSE
+    __m128 vector;
+#endif  // SHOTAMATSUDA_HAS_SSE
+    struct { float x; float y; float z; float w; };
+  };
+};
+
+// Comparison
+bool operator==(const Vec4fx& lhs, const Vec4fx& rhs);
+bool operator!=(const Vec4fx& lhs, const Vec4fx& rhs);
+
+// Arithmetic
+Vec4fx operator+(const Vec4fx& lhs, const Vec4fx& rhs);
+Vec4fx operator-(const Vec4fx& lhs, const Vec4fx& rhs);
+Vec4fx operator*(const Vec4fx& lhs, const Vec4fx& rhs);
+Vec4fx operator/(const Vec4fx& lhs, const Vec4fx& rhs);
+
+// Scalar arithmetic
+Vec4fx operator+(const Vec4fx& lhs, float rhs);
+Vec4fx operator-(const Vec4fx& lhs, float rhs);
+Vec4fx operator*(const Vec4fx& lhs, float rhs);
+Vec4fx operator/(const Vec4fx& lhs, float rhs);
+Vec4fx operator+(float lhs, const Vec4fx& rhs);
+Vec4fx operator-(float lhs, const Vec4fx& rhs);
+Vec4fx operator*(float lhs, const Vec4fx& rhs);
+Vec4fx operator/(float lhs, const Vec4fx& rhs);
+
+using Vector4fx = Vec4fx;
+
+// MARK: -
+
+#if SHOTAMATSUDA_HAS_SSE
+
+inline Vec4fx::Vec4fx() : vector(_mm_setzero_ps()) {}
+
+inline Vec4fx::Vec4fx(float value) : vector(_mm_set1_ps(value)) {}
+
+inline Vec4fx::Vec4fx(float x, float y, float z, float w)
+    : vector(_mm_setr_ps(x, y, z, w)) {}
+
+inline Vec4fx::Vec4fx(const float *values) : vector(_mm_loadu_ps(values)) {}
+
+#else  // SHOTAMATSUDA_HAS_SSE
+
+inline Vec4fx::Vec4fx() {
+  set(0.f);
+}
+
+inline Vec4fx::Vec4fx(float value) {
+  set(value);
+}
+
+inline Vec4fx::Vec4fx(float x, float y, float z, float w) {
+  set(x, y, z, w);
+}
+
+inline Vec4fx::Vec4fx(const float *values) {
+  set(values);
+}
+
+#endif  // SHOTAMATSUDA_HAS_SSE
+
+// MARK: Implicit conversion
+
+inline Vec4fx::Vec4fx(const Vec4f& other) : Vec4fx(other.pointer()) {}
+
+inline Vec4fx::operator Vec4f() const {
+  return Vec4f(x, y, z, w);
+}
+
+// MARK: Mutators
+
+inline void Vec4fx::set(float value) {
+  set(value, value, value, value);
+}
+
+inline void Vec4fx::set(float x, float y, float z, float w) {
+#if SHOTAMATSUDA_HAS_SSE
+  vector = _mm_setr_ps(x, y, z, w);
+#else
+  this->x = x;
+  this->y = y;
+  this->z = z;
+  this->w = w;
+#endif  // SHOTAMATSUDA_HAS_SSE
+}
+
+inline void Vec4fx::set(const float *values) {
+  assert(values);
+  set(values[0], values[1], values[2], values[3]);
+}
+
+inline void Vec4fx::reset() {
+  *this = Vec4fx();
+}
+
+// MARK: Element access
+
+inline float& Vec4fx::at(int index) {
+  assert(0 <= index && index < dimensions);
+  return pointer()[index];
+}
+
+inline const float& Vec4fx::at(int index) const {
+  assert(0 <= index && index < dimensions);
+  return pointer()[index];
+}
+
+// MARK: Comparison
+
+inline bool operator==(const Vec4fx& lhs, const Vec4fx& rhs) {
+#if SHOTAMATSUDA_HAS_SSE
+  return _mm_movemask_ps(_mm_cmpeq_ps(lhs.vector, rhs.vector)) == 0xf;
+#else
+  return (lhs.x == rhs.x && lhs.y == rhs.y &&
+          lhs.z == rhs.z && lhs.w == rhs.w);
+#endif  // SHOTAMATSUDA_HAS_SSE
+}
+
+inline bool operator!=(const Vec4fx& lhs, const Vec4fx& rhs) {
+  return !(lhs == rhs);
+}
+
+inline bool Vec4fx::equals(const Vec4fx& other, float tolerance) const {
+#if SHOTAMATSUDA_HAS_SSE
+  const auto difference = _mm_andnot_ps(_mm_set1_ps(-0.f),
+                                        _mm_sub_ps(vector, other.vector));
+  const auto mask = _mm_cmple_ps(difference, _mm_set1_ps(tolerance));
+  return _mm_movemask_ps(mask) == 0xf;
+#else
+  return (std::abs(x - other.x) <= tolerance &&
+          std::abs(y - other.y) <= tolerance &&
+          std::abs(z - other.z) <= tolerance &&
+          std::abs(w - other.w) <= tolerance);
+#endif  // SHOTAMATSUDA_HAS_SSE
+}
+
+// MARK: Arithmetic
+
+inline Vec4fx& Vec4fx::operator+=(const Vec4fx& other) {
+#if SHOTAMATSUDA_HAS_SSE
+  vector = _mm_add_ps(vector, other.vector);
+#else
+  x += other.x;
+  y += other.y;
+  z += other.z;
+  w += other.w;
+#endif  // SHOTAMATSUDA_HAS_SSE
+  return *this;
+}
+
+inline Vec4fx& Vec4fx::operator-=(const Vec4fx& other) {
+#if SHOTAMATSUDA_HAS_SSE
+  vector = _mm_sub_ps(vector, other.vector);
+#else
+  x -= other.x;
+  y -= other.y;
+  z -= other.z;
+  w -= other.w;
+#endif  // SHOTAMATSUDA_HAS_SSE
+  return *this;
+}
+
+inline Vec4fx& Vec4fx::operator*=(const Vec4fx& other) {
+#if SHOTAMATSUDA_HAS_SSE
+  vector = _mm_mul_ps(vector, other.vector);
+#else
+  x *= other.x;
+  y *= other.y;
+  z *= other.z;
+  w *= other.w;
+#endif  // SHOTAMATSUDA_HAS_SSE
+  return *this;
+}
+
+inline Vec4fx& Vec4fx::operator/=(const Vec4fx& other) {
+#if SHOTAMATSUDA_HAS_SSE
+  vector = _mm_div_ps(vector, other.vector);
+#else
+  x /= other.x;
+  y /= other.y;
+  z /= other.z;
+  w /= other.w;
+#endif  // SHOTAMATSUDA_HAS_SSE
+  return *this;
+}
+
+inline Vec4fx Vec4fx::operator-() const {
+#if SHOTAMATSUDA_HAS_SSE
+  return Vec4fx(_mm_xor_ps(vector, _mm_set1_ps(-0.f)));
+#else
+  return Vec4fx(-x, -y, -z, -w);
+#endif  // SHOTAMATSUDA_HAS_SSE
+}
+
+inline Vec4fx operator+(const Vec4fx& lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) += rhs;
+}
+
+inline Vec4fx operator-(const Vec4fx& lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) -= rhs;
+}
+
+inline Vec4fx operator*(const Vec4fx& lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) *= rhs;
+}
+
+inline Vec4fx operator/(const Vec4fx& lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) /= rhs;
+}
+
+// MARK: Scalar arithmetic
+
+inline Vec4fx& Vec4fx::operator+=(float scalar) {
+  return *this += Vec4fx(scalar);
+}
+
+inline Vec4fx& Vec4fx::operator-=(float scalar) {
+  return *this -= Vec4fx(scalar);
+}
+
+inline Vec4fx& Vec4fx::operator*=(float scalar) {
+  return *this *= Vec4fx(scalar);
+}
+
+inline Vec4fx& Vec4fx::operator/=(float scalar) {
+  return *this /= Vec4fx(scalar);
+}
+
+inline Vec4fx operator+(const Vec4fx& lhs, float rhs) {
+  return Vec4fx(lhs) += rhs;
+}
+
+inline Vec4fx operator-(const Vec4fx& lhs, float rhs) {
+  return Vec4fx(lhs) -= rhs;
+}
+
+inline Vec4fx operator*(const Vec4fx& lhs, float rhs) {
+  return Vec4fx(lhs) *= rhs;
+}
+
+inline Vec4fx operator/(const Vec4fx& lhs, float rhs) {
+  return Vec4fx(lhs) /= rhs;
+}
+
+inline Vec4fx operator+(float lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) += rhs;
+}
+
+inline Vec4fx operator-(float lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) -= rhs;
+}
+
+inline Vec4fx operator*(float lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) *= rhs;
+}
+
+inline Vec4fx operator/(float lhs, const Vec4fx& rhs) {
+  return Vec4fx(lhs) /= rhs;
+}
+
+// MARK: Magnitude
+
+inline float Vec4fx::magnitude() const {
+  return std::sqrt(magnitudeSquared());
+}
+
+inline float Vec4fx::magnitudeSquared() const {
+  return dot(*this);
+}
+
+// MARK: Normalization
+
+inline Vec4fx& Vec4fx::normalize() {
+  const auto denominator = magnitude();
+  if (denominator) {
+    *this /= denominator;
+  }
+  return *this;
+}
+
+inline Vec4fx Vec4fx::normalized() const {
+  return Vec4fx(*this).normalize();
+}
+
+inline Vec4fx& Vec4fx::normalizeFast() {
+  const auto squared = magnitudeSquared();
+  if (squared) {
+    *this *= rsqrt(squared);
+  }
+  return *this;
+}
+
+inline Vec4fx Vec4fx::normalizedFast() const {
+  return Vec4fx(*this).normalizeFast();
+}
+
+// MARK: Distance
+
+inline float Vec4fx::distance(const Vec4fx& other) const {
+  return (*this - other).magnitude();
+}
+
+inline float Vec4fx::distanceSquared(const Vec4fx& other) const {
+  return (*this - other).magnitudeSquared();
+}
+
+// MARK: Products
+
+inline float Vec4fx::dot(const Vec4fx& other) const {
+#if SHOTAMATSUDA_HAS_SSE4_1
+  return _mm_cvtss_f32(_mm_dp_ps(vector, other.vector, 0xf1));
+#elif SHOTAMATSUDA_HAS_SSE3
+  const auto product = _mm_mul_ps(vector, other.vector);
+  const auto sum = _mm_hadd_ps(product, product);
+  return _mm_cvtss_f32(_mm_hadd_ps(sum, sum));
+#elif SHOTAMATSUDA_HAS_SSE
+  const auto product = _mm_mul_ps(vector, other.vector);
+  const auto sum = _mm_add_ps(product, _mm_movehl_ps(product, product));
+  return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55)));
+#else
+  return x * other.x + y * other.y + z * other.z + w * other.w;
+#endif  // SHOTAMATSUDA_HAS_SSE4_1
+}
+
+// MARK: Interpolation
+
+inline Vec4fx Vec4fx::lerp(const Vec4fx& other, float factor) const {
+  return *this + (other - *this) * factor;
+}
+
+// MARK: Stream
+
+inline std::ostream& operator<<(std::ostream& os, const Vec4fx& vector) {
+  return os << "( " << vector.x << ", " << vector.y << ", " << vector.z
+            << ", " << vector.w << " )";
+}
+
+}  // namespace math
+
+using math::Vec4fx;
+using math::Vector4fx;
+
+}  // namespace shotamatsuda
+
+template <>
+struct std::hash<shotamatsuda::math::Vec4fx> {
+  std::size_t operator()(const shotamatsuda::math::Vec4fx& value) const {
+    return std::hash<shotamatsuda::math::Vec4f>()(value);
+  }
+};
+
+#endif  // SHOTAMATSUDA_MATH_VECTOR4X_H_
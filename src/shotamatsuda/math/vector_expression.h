@@ -0,0 +1,398 @@
+//
+//  shotamatsuda/math/vector_expression.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_VECTOR_EXPRESSION_H_
+#define SHOTAMATSUDA_MATH_VECTOR_EXPRESSION_H_
+
+#include <functional>
+#include <utility>
+
+#include "shotamatsuda/math/enablers.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Opt-in expression templates for Vec2, Vec3 and Vec4. Wrapping an operand
+// with lazy() makes the arithmetic that follows build an expression instead
+// of intermediate vectors, and the whole chain is evaluated component-wise
+// in one pass on conversion to Vec:
+//
+//   Vec2d p = lazy(a) + (lazy(b) - a) * s;
+//
+// Expressions refer to their vector operands, so they must be evaluated
+// before the end of the full-expression that creates them. The saving
+// relies on inlining; at -O0 every node costs a call per component and
+// eager arithmetic is faster.
+
+template <class E>
+class VecExpression {
+ public:
+  const E& self() const { return static_cast<const E&>(*this); }
+
+  // Evaluation
+  template <class T, int D>
+  operator Vec<T, D>() const;
+  template <class F = E>
+  Vec<typename F::Type, F::dimensions> evaluate() const;
+};
+
+template <class T, int D>
+class VecTerminal final : public VecExpression<VecTerminal<T, D>> {
+ public:
+  using Type = T;
+  static constexpr const int dimensions = D;
+
+ public:
+  explicit VecTerminal(const Vec<T, D>& vector) : vector_(vector) {}
+
+  // Element access
+  Type operator[](int index) const { return vector_.begin()[index]; }
+
+ private:
+  const Vec<T, D>& vector_;
+};
+
+template <class T, int D>
+class VecBroadcast final : public VecExpression<VecBroadcast<T, D>> {
+ public:
+  using Type = T;
+  static constexpr const int dimensions = D;
+
+ public:
+  explicit VecBroadcast(T scalar) : scalar_(scalar) {}
+
+  // Element access
+  Type operator[](int index) const { return scalar_; }
+
+ private:
+  T scalar_;
+};
+
+template <class L, class R, class Operation>
+class VecBinary final : public VecExpression<VecBinary<L, R, Operation>> {
+ public:
+  using Type = Promote<typename L::Type, typename R::Type>;
+  static constexpr const int dimensions = L::dimensions;
+  static_assert(L::dimensions == R::dimensions, "Dimensions mismatch");
+
+ public:
+  VecBinary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+
+  // Element access
+  Type operator[](int index) const {
+    return Operation()(static_cast<Type>(lhs_[index]), rhs_[index]);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <class E>
+class VecNegation final : public VecExpression<VecNegation<E>> {
+ public:
+  using Type = Promote<typename E::Type>;
+  static constexpr const int dimensions = E::dimensions;
+
+ public:
+  explicit VecNegation(const E& operand) : operand_(operand) {}
+
+  // Element access
+  Type operator[](int index) const {
+    return -static_cast<Type>(operand_[index]);
+  }
+
+ private:
+  E operand_;
+};
+
+// Entry point
+template <class T, int D>
+VecTerminal<T, D> lazy(const Vec<T, D>& vector);
+
+// Negation
+template <class E>
+VecNegation<E> operator-(const VecExpression<E>& operand);
+
+// Arithmetic
+template <class L, class R>
+VecBinary<L, R, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs);
+template <class L, class T, int D>
+VecBinary<L, VecTerminal<T, D>, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs);
+template <class T, int D, class R>
+VecBinary<VecTerminal<T, D>, R, std::plus<void>> operator+(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs);
+template <class L, class R>
+VecBinary<L, R, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs);
+template <class L, class T, int D>
+VecBinary<L, VecTerminal<T, D>, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs);
+template <class T, int D, class R>
+VecBinary<VecTerminal<T, D>, R, std::minus<void>> operator-(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs);
+template <class L, class R>
+VecBinary<L, R, std::multiplies<void>> operator*(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs);
+template <class L, class T, int D>
+VecBinary<L, VecTerminal<T, D>, std::multiplies<void>> operator*(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs);
+template <class T, int D, class R>
+VecBinary<VecTerminal<T, D>, R, std::multiplies<void>> operator*(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs);
+template <class L, class R>
+VecBinary<L, R, std::divides<void>> operator/(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs);
+template <class L, class T, int D>
+VecBinary<L, VecTerminal<T, D>, std::divides<void>> operator/(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs);
+template <class T, int D, class R>
+VecBinary<VecTerminal<T, D>, R, std::divides<void>> operator/(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs);
+
+// Scalar arithmetic
+template <class L, class T, EnableIfScalar<T> * = nullptr>
+VecBinary<L, VecBroadcast<T, L::dimensions>, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, T rhs);
+template <class T, class R, EnableIfScalar<T> * = nullptr>
+VecBinary<VecBroadcast<T, R::dimensions>, R, std::plus<void>> operator+(
+    T lhs, const VecExpression<R>& rhs);
+template <class L, class T, EnableIfScalar<T> * = nullptr>
+VecBinary<L, VecBroadcast<T, L::dimensions>, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, T rhs);
+template <class T, class R, EnableIfScalar<T> * = nullptr>
+VecBinary<VecBroadcast<T, R::dimensions>, R, std::minus<void>> operator-(
+    T lhs, const VecExpression<R>& rhs);
+template <class L, class T, EnableIfScalar<T> * = nullptr>
+VecBinary<L, VecBroadcast<T, L::dimensions>, std::multiplies<void>> operator*(
+    const VecExpression<L>& lhs, T rhs);
+template <class T, class R, EnableIfScalar<T> * = nullptr>
+VecBinary<VecBroadcast<T, R::dimensions>, R, std::multiplies<void>> operator*(
+    T lhs, const VecExpression<R>& rhs);
+template <class L, class T, EnableIfScalar<T> * = nullptr>
+VecBinary<L, VecBroadcast<T, L::dimensions>, std::divides<void>> operator/(
+    const VecExpression<L>& lhs, T rhs);
+template <class T, class R, EnableIfScalar<T> * = nullptr>
+VecBinary<VecBroadcast<T, R::dimensions>, R, std::divides<void>> operator/(
+    T lhs, const VecExpression<R>& rhs);
+
+// MARK: -
+
+namespace detail {
+
+template <class T, int D, int... Indices>
+inline Vec<T, D> makeVec(const T *values,
+                         std::integer_sequence<int, Indices...>) {
+  return Vec<T, D>(values[Indices]...);
+}
+
+}  // namespace detail
+
+template <class E>
+template <class T, int D>
+inline VecExpression<E>::operator Vec<T, D>() const {
+  static_assert(D == E::dimensions, "Dimensions mismatch");
+  // Evaluate into a plain array rather than a default-constructed Vec, which
+  // would zero-fill the result before overwriting it.
+  T values[D];
+  for (int i = 0; i < D; ++i) {
+    values[i] = self()[i];
+  }
+  return detail::makeVec<T, D>(values, std::make_integer_sequence<int, D>());
+}
+
+template <class E>
+template <class F>
+inline Vec<typename F::Type, F::dimensions> VecExpression<E>::evaluate() const {
+  return *this;
+}
+
+// MARK: Entry point
+
+template <class T, int D>
+inline VecTerminal<T, D> lazy(const Vec<T, D>& vector) {
+  return VecTerminal<T, D>(vector);
+}
+
+// MARK: Negation
+
+template <class E>
+inline VecNegation<E> operator-(const VecExpression<E>& operand) {
+  return VecNegation<E>(operand.self());
+}
+
+// MARK: Arithmetic
+
+template <class L, class R>
+inline VecBinary<L, R, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs) {
+  return VecBinary<L, R, std::plus<void>>(lhs.self(), rhs.self());
+}
+
+template <class L, class T, int D>
+inline VecBinary<L, VecTerminal<T, D>, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs) {
+  using R = VecTerminal<T, D>;
+  return VecBinary<L, R, std::plus<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, int D, class R>
+inline VecBinary<VecTerminal<T, D>, R, std::plus<void>> operator+(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs) {
+  using L = VecTerminal<T, D>;
+  return VecBinary<L, R, std::plus<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class R>
+inline VecBinary<L, R, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs) {
+  return VecBinary<L, R, std::minus<void>>(lhs.self(), rhs.self());
+}
+
+template <class L, class T, int D>
+inline VecBinary<L, VecTerminal<T, D>, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs) {
+  using R = VecTerminal<T, D>;
+  return VecBinary<L, R, std::minus<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, int D, class R>
+inline VecBinary<VecTerminal<T, D>, R, std::minus<void>> operator-(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs) {
+  using L = VecTerminal<T, D>;
+  return VecBinary<L, R, std::minus<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class R>
+inline VecBinary<L, R, std::multiplies<void>> operator*(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs) {
+  return VecBinary<L, R, std::multiplies<void>>(lhs.self(), rhs.self());
+}
+
+template <class L, class T, int D>
+inline VecBinary<L, VecTerminal<T, D>, std::multiplies<void>> operator*(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs) {
+  using R = VecTerminal<T, D>;
+  return VecBinary<L, R, std::multiplies<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, int D, class R>
+inline VecBinary<VecTerminal<T, D>, R, std::multiplies<void>> operator*(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs) {
+  using L = VecTerminal<T, D>;
+  return VecBinary<L, R, std::multiplies<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class R>
+inline VecBinary<L, R, std::divides<void>> operator/(
+    const VecExpression<L>& lhs, const VecExpression<R>& rhs) {
+  return VecBinary<L, R, std::divides<void>>(lhs.self(), rhs.self());
+}
+
+template <class L, class T, int D>
+inline VecBinary<L, VecTerminal<T, D>, std::divides<void>> operator/(
+    const VecExpression<L>& lhs, const Vec<T, D>& rhs) {
+  using R = VecTerminal<T, D>;
+  return VecBinary<L, R, std::divides<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, int D, class R>
+inline VecBinary<VecTerminal<T, D>, R, std::divides<void>> operator/(
+    const Vec<T, D>& lhs, const VecExpression<R>& rhs) {
+  using L = VecTerminal<T, D>;
+  return VecBinary<L, R, std::divides<void>>(L(lhs), rhs.self());
+}
+
+// MARK: Scalar arithmetic
+
+template <class L, class T, EnableIfScalar<T> *>
+inline VecBinary<L, VecBroadcast<T, L::dimensions>, std::plus<void>> operator+(
+    const VecExpression<L>& lhs, T rhs) {
+  using R = VecBroadcast<T, L::dimensions>;
+  return VecBinary<L, R, std::plus<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, class R, EnableIfScalar<T> *>
+inline VecBinary<VecBroadcast<T, R::dimensions>, R, std::plus<void>> operator+(
+    T lhs, const VecExpression<R>& rhs) {
+  using L = VecBroadcast<T, R::dimensions>;
+  return VecBinary<L, R, std::plus<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class T, EnableIfScalar<T> *>
+inline VecBinary<L, VecBroadcast<T, L::dimensions>, std::minus<void>> operator-(
+    const VecExpression<L>& lhs, T rhs) {
+  using R = VecBroadcast<T, L::dimensions>;
+  return VecBinary<L, R, std::minus<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, class R, EnableIfScalar<T> *>
+inline VecBinary<VecBroadcast<T, R::dimensions>, R, std::minus<void>> operator-(
+    T lhs, const VecExpression<R>& rhs) {
+  using L = VecBroadcast<T, R::dimensions>;
+  return VecBinary<L, R, std::minus<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class T, EnableIfScalar<T> *>
+inline VecBinary<L, VecBroadcast<T, L::dimensions>, std::multiplies<void>>
+operator*(const VecExpression<L>& lhs, T rhs) {
+  using R = VecBroadcast<T, L::dimensions>;
+  return VecBinary<L, R, std::multiplies<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, class R, EnableIfScalar<T> *>
+inline VecBinary<VecBroadcast<T, R::dimensions>, R, std::multiplies<void>>
+operator*(T lhs, const VecExpression<R>& rhs) {
+  using L = VecBroadcast<T, R::dimensions>;
+  return VecBinary<L, R, std::multiplies<void>>(L(lhs), rhs.self());
+}
+
+template <class L, class T, EnableIfScalar<T> *>
+inline VecBinary<L, VecBroadcast<T, L::dimensions>, std::divides<void>>
+operator/(const VecExpression<L>& lhs, T rhs) {
+  using R = VecBroadcast<T, L::dimensions>;
+  return VecBinary<L, R, std::divides<void>>(lhs.self(), R(rhs));
+}
+
+template <class T, class R, EnableIfScalar<T> *>
+inline VecBinary<VecBroadcast<T, R::dimensions>, R, std::divides<void>>
+operator/(T lhs, const VecExpression<R>& rhs) {
+  using L = VecBroadcast<T, R::dimensions>;
+  return VecBinary<L, R, std::divides<void>>(L(lhs), rhs.self());
+}
+
+}  // namespace math
+
+using math::lazy;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_VECTOR_EXPRESSION_H_
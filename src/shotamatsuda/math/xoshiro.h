@@ -0,0 +1,181 @@
+//
+//  shotamatsuda/math/xoshiro.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_XOSHIRO_H_
+#define SHOTAMATSUDA_MATH_XOSHIRO_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "shotamatsuda/math/hash.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// xoshiro256** engine of Blackman and Vigna, with 32 bytes of state and a
+// period of 2^256 - 1. jump() and longJump() advance by 2^128 and 2^192
+// outputs, which splits the sequence into non-overlapping streams. Satisfies
+// the requirements of a uniform random bit generator and can be used as
+// Random<Xoshiro256>.
+class Xoshiro256 final {
+ public:
+  using result_type = std::uint64_t;
+  using State = std::array<std::uint64_t, 4>;
+
+  static constexpr result_type default_seed = 0x853c49e6748fea9b;
+
+ public:
+  Xoshiro256() : Xoshiro256(default_seed) {}
+  explicit Xoshiro256(std::uint64_t seed);
+  explicit Xoshiro256(const State& state);
+
+  // Copy semantics
+  Xoshiro256(const Xoshiro256&) = default;
+  Xoshiro256& operator=(const Xoshiro256&) = default;
+
+  // Comparison
+  bool operator==(const Xoshiro256& other) const;
+  bool operator!=(const Xoshiro256& other) const;
+
+  // Generation
+  void seed(std::uint64_t seed = default_seed);
+  result_type operator()();
+  void discard(unsigned long long count);
+
+  // Stream splitting
+  void jump();
+  void longJump();
+
+  // Attributes
+  const State& state() const { return state_; }
+
+  // Limits
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+ private:
+  void jump(const State& polynomial);
+
+ private:
+  State state_;
+};
+
+// MARK: -
+
+namespace detail {
+
+inline std::uint64_t splitMix64(std::uint64_t *state) {
+  auto result = (*state += 0x9e3779b97f4a7c15);
+  result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9;
+  result = (result ^ (result >> 27)) * 0x94d049bb133111eb;
+  return result ^ (result >> 31);
+}
+
+}  // namespace detail
+
+inline Xoshiro256::Xoshiro256(std::uint64_t seed) {
+  this->seed(seed);
+}
+
+inline Xoshiro256::Xoshiro256(const State& state) : state_(state) {}
+
+// MARK: Comparison
+
+inline bool Xoshiro256::operator==(const Xoshiro256& other) const {
+  return state_ == other.state_;
+}
+
+inline bool Xoshiro256::operator!=(const Xoshiro256& other) const {
+  return !(*this == other);
+}
+
+// MARK: Generation
+
+inline void Xoshiro256::seed(std::uint64_t seed) {
+  // Expanding the seed with SplitMix64 never produces the all-zero state
+  for (auto& element : state_) {
+    element = detail::splitMix64(&seed);
+  }
+}
+
+inline Xoshiro256::result_type Xoshiro256::operator()() {
+  const auto result = detail::rotateLeft(state_[1] * 5, 7) * 9;
+  const auto shifted = state_[1] << 17;
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= shifted;
+  state_[3] = detail::rotateLeft(state_[3], 45);
+  return result;
+}
+
+inline void Xoshiro256::discard(unsigned long long count) {
+  for (; count; --count) {
+    (*this)();
+  }
+}
+
+// MARK: Stream splitting
+
+inline void Xoshiro256::jump() {
+  jump({{0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+         0xa9582618e03fc9aa, 0x39abdc4529b1661c}});
+}
+
+inline void Xoshiro256::longJump() {
+  jump({{0x76e15d3efefdcbbf, 0xc5004e441c522fb3,
+         0x77710069854ee241, 0x39109bb02acbe635}});
+}
+
+inline void Xoshiro256::jump(const State& polynomial) {
+  State result{};
+  for (const auto word : polynomial) {
+    for (int bit = 0; bit < 64; ++bit) {
+      if (word & std::uint64_t(1) << bit) {
+        for (int i = 0; i < 4; ++i) {
+          result[i] ^= state_[i];
+        }
+      }
+      (*this)();
+    }
+  }
+  state_ = result;
+}
+
+}  // namespace math
+
+using math::Xoshiro256;
+
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_XOSHIRO_H_
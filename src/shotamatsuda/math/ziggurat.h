@@ -0,0 +1,159 @@
+//
+//  shotamatsuda/math/ziggurat.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef SHOTAMATSUDA_MATH_ZIGGURAT_H_
+#define SHOTAMATSUDA_MATH_ZIGGURAT_H_
+
+#include <cmath>
+#include <cstdint>
+
+namespace shotamatsuda {
+namespace math {
+
+// Ziggurat method of Marsaglia and Tsang with 256 layers, in the form of
+// Doornik that draws the layer and the abscissa from a single 64-bit word.
+// The generator must return uniformly random 64-bit words. About 99% of
+// samples take one word and a multiplication, and the rest fall back to
+// rejection against the density or to the tail.
+template <class Generator>
+double zigguratNormal(Generator generator);
+template <class Generator>
+double zigguratExponential(Generator generator);
+
+// MARK: -
+
+namespace detail {
+
+struct ZigguratTable {
+  double x[257];
+  double f[257];
+};
+
+// Builds the layers of equal area from the base width r and the area v of
+// each layer, given the unnormalized density and its inverse.
+template <class Density, class Inverse>
+inline ZigguratTable makeZigguratTable(double r, double v,
+                                       Density density, Inverse inverse) {
+  ZigguratTable table;
+  table.x[0] = v / density(r);
+  table.x[1] = r;
+  for (int i = 1; i < 255; ++i) {
+    table.x[i + 1] = inverse(v / table.x[i] + density(table.x[i]));
+  }
+  table.x[256] = 0;
+  for (int i = 0; i < 257; ++i) {
+    table.f[i] = density(table.x[i]);
+  }
+  return table;
+}
+
+constexpr double kZigguratNormalR = 3.6541528853610088;
+constexpr double kZigguratNormalV = 0.00492867323399;
+constexpr double kZigguratExponentialR = 7.69711747013104972;
+constexpr double kZigguratExponentialV = 0.0039496598225815571993;
+
+inline const ZigguratTable& zigguratNormalTable() {
+  static const auto table = makeZigguratTable(
+      kZigguratNormalR, kZigguratNormalV,
+      [](double x) { return std::exp(-x * x / 2); },
+      [](double y) { return std::sqrt(-2 * std::log(y)); });
+  return table;
+}
+
+inline const ZigguratTable& zigguratExponentialTable() {
+  static const auto table = makeZigguratTable(
+      kZigguratExponentialR, kZigguratExponentialV,
+      [](double x) { return std::exp(-x); },
+      [](double y) { return -std::log(y); });
+  return table;
+}
+
+// Returns the upper 53 bits of the word in [0, 1).
+inline double zigguratCanonical(std::uint64_t word) {
+  return (word >> 11) * (1.0 / 9007199254740992.0);
+}
+
+}  // namespace detail
+
+template <class Generator>
+inline double zigguratNormal(Generator generator) {
+  const auto& table = detail::zigguratNormalTable();
+  while (true) {
+    const std::uint64_t word = generator();
+    const auto layer = word & 0xff;
+    const auto u = 2 * detail::zigguratCanonical(word) - 1;
+    const auto x = u * table.x[layer];
+    if (std::abs(x) < table.x[layer + 1]) {
+      return x;
+    }
+    if (!layer) {
+      // Marsaglia's tail method beyond r, with uniforms in (0, 1]
+      double tail;
+      double y;
+      do {
+        tail = std::log(1 - detail::zigguratCanonical(generator())) /
+            detail::kZigguratNormalR;
+        y = std::log(1 - detail::zigguratCanonical(generator()));
+      } while (-2 * y < tail * tail);
+      return u < 0 ? tail - detail::kZigguratNormalR
+                   : detail::kZigguratNormalR - tail;
+    }
+    const auto f = table.f[layer] + (table.f[layer + 1] - table.f[layer]) *
+        detail::zigguratCanonical(generator());
+    if (f < std::exp(-x * x / 2)) {
+      return x;
+    }
+  }
+}
+
+template <class Generator>
+inline double zigguratExponential(Generator generator) {
+  const auto& table = detail::zigguratExponentialTable();
+  while (true) {
+    const std::uint64_t word = generator();
+    const auto layer = word & 0xff;
+    const auto x = detail::zigguratCanonical(word) * table.x[layer];
+    if (x < table.x[layer + 1]) {
+      return x;
+    }
+    if (!layer) {
+      // The tail beyond r is r plus another exponential variate
+      return (detail::kZigguratExponentialR -
+              std::log(1 - detail::zigguratCanonical(generator())));
+    }
+    const auto f = table.f[layer] + (table.f[layer + 1] - table.f[layer]) *
+        detail::zigguratCanonical(generator());
+    if (f < std::exp(-x)) {
+      return x;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
+
+#endif  // SHOTAMATSUDA_MATH_ZIGGURAT_H_
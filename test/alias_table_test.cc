@@ -0,0 +1,153 @@
+//
+//  alias_table_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/alias_table.h"
+#include "shotamatsuda/math/philox.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/xoshiro.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class AliasTableTest : public ::testing::Test {};
+
+using Engines = ::testing::Types<std::mt19937, std::minstd_rand,
+                                 Philox4x32, Xoshiro256>;
+TYPED_TEST_CASE(AliasTableTest, Engines);
+
+// Returns the chi-squared statistic of the counts of the indices against the
+// probabilities proportional to the weights
+template <class T>
+double chiSquared(const std::vector<std::size_t>& indices,
+                  const std::vector<T>& weights) {
+  double sum = 0;
+  for (const auto weight : weights) {
+    sum += weight;
+  }
+  std::vector<std::size_t> counts(weights.size());
+  for (const auto index : indices) {
+    ++counts[index];
+  }
+  double result = 0;
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    const auto expected = indices.size() * weights[i] / sum;
+    if (expected == 0) {
+      EXPECT_EQ(counts[i], 0);
+      continue;
+    }
+    const auto difference = counts[i] - expected;
+    result += difference * difference / expected;
+  }
+  return result;
+}
+
+TYPED_TEST(AliasTableTest, Discrete) {
+  using Engine = TypeParam;
+  const std::vector<double> weights = {1, 0, 2, 3, 0.5, 8, 0, 4.5, 1, 1};
+  const AliasTable table(weights.data(), weights.size());
+  ASSERT_EQ(table.size(), weights.size());
+  Random<Engine> random(1);
+  std::vector<std::size_t> indices(100000);
+  for (auto& index : indices) {
+    index = random.discrete(table);
+  }
+  // The 99.9th percentile with 6 degrees of freedom, excluding zero weights
+  ASSERT_LT(chiSquared(indices, weights), 22.458);
+}
+
+TYPED_TEST(AliasTableTest, FillDiscrete) {
+  using Engine = TypeParam;
+  std::vector<float> weights(1000);
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<float>(i % 7);
+  }
+  const AliasTable table(weights.data(), weights.size());
+  Random<Engine> random1(2);
+  Random<Engine> random2(2);
+  std::vector<std::size_t> indices(1000000);
+  random1.fillDiscrete(table, indices.data(), indices.size());
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(indices[i], random2.discrete(table));
+  }
+  // The 99.9th percentile with 856 degrees of freedom
+  ASSERT_LT(chiSquared(indices, weights), 1008.0);
+}
+
+TEST(AliasTableTest, Build) {
+  const std::vector<int> weights1 = {0, 0, 1};
+  const std::vector<int> weights2 = {1, 0, 0, 0};
+  AliasTable table;
+  ASSERT_TRUE(table.empty());
+  table.build(weights1.data(), weights1.size());
+  ASSERT_EQ(table.size(), 3);
+  Random<> random(3);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(random.discrete(table), 2);
+  }
+  table.build(weights2.data(), weights2.size());
+  ASSERT_EQ(table.size(), 4);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(random.discrete(table), 0);
+  }
+}
+
+TEST(AliasTableTest, BuildWithWorkspace) {
+  const std::vector<double> weights1 = {3, 1, 0, 2, 5};
+  const std::vector<double> weights2 = {1, 4, 2};
+  AliasTable::Workspace workspace;
+  for (const auto& weights : {weights1, weights2, weights1}) {
+    const AliasTable expected(weights.data(), weights.size());
+    AliasTable table;
+    table.build(weights.data(), weights.size(), &workspace);
+    ASSERT_EQ(table.size(), expected.size());
+    Random<> random(4);
+    for (int i = 0; i < 1000; ++i) {
+      const auto word = random.next();
+      ASSERT_EQ(table(word), expected(word));
+    }
+  }
+}
+
+TEST(AliasTableTest, Uniform) {
+  const std::vector<double> weights(6, 1);
+  const AliasTable table(weights.data(), weights.size());
+  // The columns split the range of words evenly
+  const std::uint64_t step = 0xffffffffffffffff / 6;
+  for (std::size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(table(step * i + step / 2), i);
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
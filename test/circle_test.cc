@@ -0,0 +1,65 @@
+//
+//  circle_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/circle.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class CircleTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(CircleTest, Types);
+
+TYPED_TEST(CircleTest, RandomPoint) {
+  using T = TypeParam;
+  const Circle2<T> circle(Vec2<T>(10, -20), 5);
+  Random<> random(1);
+  std::vector<Vec2<T>> points(10000);
+  circle.randomPoints(points.data(), points.size(), &random);
+  points.emplace_back(circle.randomPoint(&random));
+  Vec2<T> mean;
+  int inner = 0;
+  for (const auto& point : points) {
+    ASSERT_LE(point.distance(circle.center), circle.radius * (1 + 1e-6));
+    mean += point / points.size();
+    inner += point.distance(circle.center) < circle.radius / 2;
+  }
+  // The inner circle of half the radius covers a quarter of the area
+  ASSERT_NEAR(inner, points.size() / 4, points.size() / 50);
+  ASSERT_NEAR(mean.x, circle.x, 0.1);
+  ASSERT_NEAR(mean.y, circle.y, 0.1);
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,138 @@
+//
+//  hash_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/circle.h"
+#include "shotamatsuda/math/hash.h"
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/size.h"
+#include "shotamatsuda/math/triangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+// Fraction of buckets that a uniform hash is expected to occupy.
+double expectedOccupancy(std::size_t size, std::size_t buckets) {
+  return 1.0 - std::exp(-static_cast<double>(size) / buckets);
+}
+
+template <class Set>
+double occupancy(const Set& set) {
+  std::size_t occupied = 0;
+  for (std::size_t i = 0; i < set.bucket_count(); ++i) {
+    if (set.bucket_size(i)) {
+      ++occupied;
+    }
+  }
+  return static_cast<double>(occupied) / set.bucket_count();
+}
+
+template <class Set>
+std::size_t longestBucket(const Set& set) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < set.bucket_count(); ++i) {
+    result = std::max(result, set.bucket_size(i));
+  }
+  return result;
+}
+
+TEST(HashTest, SpreadsGridPoints2) {
+  std::unordered_set<Vec2i> set;
+  for (int y = 0; y < 256; ++y) {
+    for (int x = 0; x < 256; ++x) {
+      set.emplace(x, y);
+    }
+  }
+  ASSERT_EQ(set.size(), 256 * 256);
+  const auto expected = expectedOccupancy(set.size(), set.bucket_count());
+  EXPECT_GT(occupancy(set), expected * 0.95);
+  EXPECT_LT(longestBucket(set), 12);
+}
+
+TEST(HashTest, SpreadsGridPoints3) {
+  std::unordered_set<Vec3i> set;
+  for (int z = -20; z < 20; ++z) {
+    for (int y = -20; y < 20; ++y) {
+      for (int x = -20; x < 20; ++x) {
+        set.emplace(x * 8, y * 8, z * 8);
+      }
+    }
+  }
+  ASSERT_EQ(set.size(), 40 * 40 * 40);
+  const auto expected = expectedOccupancy(set.size(), set.bucket_count());
+  EXPECT_GT(occupancy(set), expected * 0.95);
+  EXPECT_LT(longestBucket(set), 12);
+}
+
+TEST(HashTest, SpreadsGridRectangles) {
+  std::unordered_set<Rect2i> set;
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      for (int size = 1; size < 5; ++size) {
+        set.emplace(x, y, size, size);
+      }
+    }
+  }
+  ASSERT_EQ(set.size(), 64 * 64 * 4);
+  const auto expected = expectedOccupancy(set.size(), set.bucket_count());
+  EXPECT_GT(occupancy(set), expected * 0.95);
+  EXPECT_LT(longestBucket(set), 12);
+}
+
+TEST(HashTest, DistinguishesComponentOrder) {
+  EXPECT_NE(std::hash<Vec2i>()(Vec2i(1, 2)), std::hash<Vec2i>()(Vec2i(2, 1)));
+  EXPECT_NE(std::hash<Vec3i>()(Vec3i(1, 1, 0)),
+            std::hash<Vec3i>()(Vec3i(0, 0, 0)));
+  EXPECT_NE(std::hash<Line2i>()(Line2i(0, 0, 1, 1)),
+            std::hash<Line2i>()(Line2i(1, 1, 0, 0)));
+  EXPECT_NE(std::hash<Triangle2i>()(Triangle2i(0, 0, 1, 0, 1, 0)),
+            std::hash<Triangle2i>()(Triangle2i(0, 0, 0, 0, 0, 0)));
+}
+
+TEST(HashTest, AgreesWithEquality) {
+  EXPECT_EQ(std::hash<Vec2d>()(Vec2d(0.0, 1.0)),
+            std::hash<Vec2d>()(Vec2d(-0.0, 1.0)));
+  EXPECT_EQ(std::hash<Size3f>()(Size3f(1, 2, 3)),
+            std::hash<Size3f>()(Size3f(1, 2, 3)));
+  EXPECT_EQ(std::hash<Circle2d>()(Circle2d(Vec2d(1, 2), 3)),
+            std::hash<Circle2d>()(Circle2d(Vec2d(1, 2), 3)));
+  EXPECT_EQ(std::hash<Line3d>()(Line3d(1, 2, 3, 4, 5, 6)),
+            std::hash<Line3d>()(Line3d(1, 2, 3, 4, 5, 6)));
+  EXPECT_EQ(hash(1, 2, 3), hash(1, 2, 3));
+  EXPECT_NE(hash(1, 2, 3), hash(1, 2));
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
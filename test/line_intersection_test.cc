@@ -0,0 +1,286 @@
+//
+//  line_intersection_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/line_intersection.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class LineIntersectionTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(LineIntersectionTest, Types);
+
+template <class T>
+using IntersectionMap = std::map<std::pair<std::size_t, std::size_t>,
+                                 LineIntersection<T>>;
+
+template <class T>
+IntersectionMap<T> intersectAll(const std::vector<Line2<T>>& lines) {
+  const auto intersections = intersectLines(lines.data(), lines.size());
+  IntersectionMap<T> result;
+  for (const auto& intersection : intersections) {
+    EXPECT_LT(intersection.first, intersection.second);
+    const auto pair = std::make_pair(intersection.first, intersection.second);
+    EXPECT_TRUE(result.emplace(pair, intersection).second);
+  }
+  return result;
+}
+
+// Brute-force oracle in exact integer arithmetic, for lines whose
+// coordinates are integers after multiplying by the scale
+template <class T>
+IntersectionMap<T> intersectPairs(const std::vector<Line2<T>>& lines,
+                                  T scale = 1) {
+  using Point = std::pair<std::int64_t, std::int64_t>;
+  const auto convert = [scale](const Vec2<T>& vector) {
+    const Point point(std::llround(vector.x * scale),
+                      std::llround(vector.y * scale));
+    EXPECT_EQ(point.first, vector.x * scale);
+    EXPECT_EQ(point.second, vector.y * scale);
+    return point;
+  };
+  const auto orientation = [](const Point& a, const Point& b,
+                              const Point& c) {
+    const auto value = ((b.first - a.first) * (c.second - a.second) -
+                        (b.second - a.second) * (c.first - a.first));
+    return (value > 0) - (value < 0);
+  };
+  const auto vector = [scale](const Point& point) {
+    return Vec2<T>(static_cast<T>(point.first / scale),
+                   static_cast<T>(point.second / scale));
+  };
+  std::vector<Point> starts;
+  std::vector<Point> ends;
+  for (const auto& line : lines) {
+    const auto a = convert(line.a);
+    const auto b = convert(line.b);
+    starts.emplace_back(std::min(a, b));
+    ends.emplace_back(std::max(a, b));
+  }
+  IntersectionMap<T> result;
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    for (std::size_t j = i + 1; j < lines.size(); ++j) {
+      const auto& s1 = starts[i];
+      const auto& e1 = ends[i];
+      const auto& s2 = starts[j];
+      const auto& e2 = ends[j];
+      const auto o1 = orientation(s1, e1, s2);
+      const auto o2 = orientation(s1, e1, e2);
+      const auto o3 = orientation(s2, e2, s1);
+      const auto o4 = orientation(s2, e2, e1);
+      LineIntersection<T> intersection{i, j};
+      if (!o1 && !o2 && !o3 && !o4) {
+        const auto first = std::max(s1, s2);
+        const auto last = std::min(e1, e2);
+        if (last < first) {
+          continue;
+        }
+        intersection.point = vector(first);
+        intersection.end = vector(last);
+      } else if (o1 * o2 > 0 || o3 * o4 > 0) {
+        continue;
+      } else {
+        if (!o3) {
+          intersection.point = vector(s1);
+        } else if (!o4) {
+          intersection.point = vector(e1);
+        } else if (!o1) {
+          intersection.point = vector(s2);
+        } else if (!o2) {
+          intersection.point = vector(e2);
+        } else {
+          const auto rx = e1.first - s1.first;
+          const auto ry = e1.second - s1.second;
+          const auto qx = e2.first - s2.first;
+          const auto qy = e2.second - s2.second;
+          const auto numerator = ((s2.first - s1.first) * qy -
+                                  (s2.second - s1.second) * qx);
+          const auto denominator = rx * qy - ry * qx;
+          const auto t = static_cast<long double>(numerator) / denominator;
+          intersection.point = Vec2<T>(
+              static_cast<T>((s1.first + rx * t) / scale),
+              static_cast<T>((s1.second + ry * t) / scale));
+        }
+        intersection.end = intersection.point;
+      }
+      result.emplace(std::make_pair(i, j), intersection);
+    }
+  }
+  return result;
+}
+
+template <class T>
+void expectEqual(const IntersectionMap<T>& actual,
+                 const IntersectionMap<T>& expected, T tolerance) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (const auto& pair : expected) {
+    const auto found = actual.find(pair.first);
+    ASSERT_NE(found, actual.end());
+    ASSERT_NEAR(found->second.point.x, pair.second.point.x, tolerance);
+    ASSERT_NEAR(found->second.point.y, pair.second.point.y, tolerance);
+    ASSERT_NEAR(found->second.end.x, pair.second.end.x, tolerance);
+    ASSERT_NEAR(found->second.end.y, pair.second.end.y, tolerance);
+  }
+}
+
+TYPED_TEST(LineIntersectionTest, Crossing) {
+  using T = TypeParam;
+  const std::vector<Line2<T>> lines = {
+    Line2<T>(0, 0, 4, 4),
+    Line2<T>(0, 4, 4, 0),
+    Line2<T>(5, 0, 6, 1),
+  };
+  const auto intersections = intersectAll(lines);
+  ASSERT_EQ(intersections.size(), 1);
+  const auto& intersection = intersections.begin()->second;
+  ASSERT_EQ(intersection.first, 0);
+  ASSERT_EQ(intersection.second, 1);
+  ASSERT_EQ(intersection.point, Vec2<T>(2, 2));
+  ASSERT_FALSE(intersection.overlaps());
+}
+
+TYPED_TEST(LineIntersectionTest, Degenerate) {
+  using T = TypeParam;
+  const std::vector<Line2<T>> lines = {
+    Line2<T>(0, 0, 4, 0),  // Shares an endpoint with 1
+    Line2<T>(4, 0, 4, 4),  // Vertical
+    Line2<T>(2, 0, 2, -3),  // Ends on 0
+    Line2<T>(1, 0, 3, 0),  // Collinear within 0
+    Line2<T>(3, 0, 6, 0),  // Overlaps 0 and touches 3
+    Line2<T>(4, 2, 4, 2),  // Zero length on 1
+    Line2<T>(2, 2, 6, 2),  // Through 5
+    Line2<T>(10, 10, 10, 10),  // Isolated
+    Line2<T>(10, 10, 10, 10),  // Coincides with 7
+  };
+  const auto intersections = intersectAll(lines);
+  expectEqual(intersections, intersectPairs(lines), T());
+  using Pair = std::pair<std::size_t, std::size_t>;
+  const auto& overlap = intersections.at(Pair(0, 4));
+  ASSERT_TRUE(overlap.overlaps());
+  ASSERT_EQ(overlap.point, Vec2<T>(3, 0));
+  ASSERT_EQ(overlap.end, Vec2<T>(4, 0));
+  ASSERT_EQ(intersections.at(Pair(0, 3)).end, Vec2<T>(3, 0));
+  ASSERT_FALSE(intersections.at(Pair(3, 4)).overlaps());
+  ASSERT_EQ(intersections.at(Pair(5, 6)).point, Vec2<T>(4, 2));
+  ASSERT_EQ(intersections.count(Pair(7, 8)), 1);
+  ASSERT_EQ(intersections.size(), 11);
+}
+
+TYPED_TEST(LineIntersectionTest, Concurrent) {
+  using T = TypeParam;
+  // Lines through the same point, which are crossings rather than endpoints
+  std::vector<Line2<T>> lines;
+  for (int i = -5; i <= 5; ++i) {
+    lines.emplace_back(-10, -i, 10, i);
+    lines.emplace_back(-i, -10, i, 10);
+  }
+  const auto intersections = intersectAll(lines);
+  expectEqual(intersections, intersectPairs(lines), T());
+  ASSERT_EQ(intersections.size(), lines.size() * (lines.size() - 1) / 2);
+}
+
+TYPED_TEST(LineIntersectionTest, Grid) {
+  using T = TypeParam;
+  // Lines on a coarse grid hit every degenerate case many times
+  Random<> random(1);
+  for (int trial = 0; trial < 20; ++trial) {
+    std::vector<Line2<T>> lines(200);
+    for (auto& line : lines) {
+      line.set(random.uniform<int>(0, 12), random.uniform<int>(0, 12),
+               random.uniform<int>(0, 12), random.uniform<int>(0, 12));
+    }
+    expectEqual(intersectAll(lines), intersectPairs(lines), T(1e-3));
+  }
+}
+
+TYPED_TEST(LineIntersectionTest, Random) {
+  using T = TypeParam;
+  // Coordinates on a lattice of 1 / 1024, which the oracle handles exactly
+  const T scale = 1024;
+  const auto lattice = [scale](const Vec2<T>& point) {
+    return Vec2<T>(std::round(point.x * scale) / scale,
+                   std::round(point.y * scale) / scale);
+  };
+  Random<> random(2);
+  std::vector<Line2<T>> lines(2000);
+  for (auto& line : lines) {
+    const auto point = Vec2<T>::random(0, 100, &random);
+    line.set(lattice(point),
+             lattice(point + Vec2<T>::random(-5, 5, &random)));
+  }
+  expectEqual(intersectAll(lines), intersectPairs(lines, scale), T(1e-3));
+}
+
+TYPED_TEST(LineIntersectionTest, NearlyParallel) {
+  using T = TypeParam;
+  // Disjoint lines on nearly the same line, whose rounded cross products
+  // placed an intersection at the end of the first
+  const std::vector<Line2<T>> lines = {
+    Line2<T>(T(0.1), T(0.2), T(1.3), T(1.4)),
+    Line2<T>(T(1.8), T(1.9), T(2), T(2.1)),
+    Line2<T>(T(0.4), T(1.3), T(2.1), T(3)),
+    Line2<T>(T(2.4), T(3.3), T(2.5), T(3.4)),
+  };
+  ASSERT_TRUE(intersectAll(lines).empty());
+  for (std::size_t i = 0; i < lines.size(); i += 2) {
+    Vec2<T> point;
+    Vec2<T> end;
+    ASSERT_FALSE(detail::intersectSweepLines(
+        lines[i].a, lines[i].b, lines[i + 1].a, lines[i + 1].b,
+        &point, &end));
+    ASSERT_FALSE(detail::intersectSweepLines(
+        lines[i + 1].a, lines[i + 1].b, lines[i].a, lines[i].b,
+        &point, &end));
+  }
+  // Lines that cross at a shallow angle are still found
+  const std::vector<Line2<T>> crossing = {
+    Line2<T>(0, 0, 1000, 1),
+    Line2<T>(0, 1, 1000, 0),
+  };
+  const auto intersections = intersectAll(crossing);
+  ASSERT_EQ(intersections.size(), 1);
+  ASSERT_NEAR(intersections.begin()->second.point.x, 500, T(1e-3));
+  ASSERT_NEAR(intersections.begin()->second.point.y, T(0.5), T(1e-3));
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
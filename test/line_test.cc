@@ -24,9 +24,12 @@
 //  DEALINGS IN THE SOFTWARE.
 //
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -328,5 +331,56 @@ TYPED_TEST(LineTest, ImplicitlyConvertibleFromOtherTypes) {
   }
 }
 
+TEST(LineTest, Side) {
+  // Left is the side of negative cross products, as in y-down coordinates
+  const Line2d line(0, 0, 2, 0);
+  ASSERT_EQ(line.side(Vec2d(1, -1)), Side::LEFT);
+  ASSERT_EQ(line.side(Vec2d(1, 1)), Side::RIGHT);
+  ASSERT_EQ(line.side(Vec2d(5, 0)), Side::COINCIDENT);
+  ASSERT_EQ(Line2i(0, 0, 0, 2).side(Vec2i(1, 1)), Side::LEFT);
+  ASSERT_EQ(Line2i(0, 0, 0, 2).side(Vec2i(-1, 1)), Side::RIGHT);
+}
+
+template <class T>
+void expectSides() {
+  Random<> random(1);
+  const Line2<T> line(-3, 2, 4, -5);
+  // Points on a coarse grid include many on the line
+  std::vector<Vec2<T>> points(203);
+  for (auto& point : points) {
+    point.set(random.uniform<int>(-8, 8), random.uniform<int>(-8, 8));
+  }
+  points[5] = Vec2<T>(std::numeric_limits<T>::quiet_NaN(), 0);
+  std::vector<Side> sides(points.size());
+  line.side(points.data(), points.size(), sides.data());
+  std::vector<std::uint64_t> left((points.size() + 63) / 64, ~0ull);
+  std::vector<std::uint64_t> right((points.size() + 63) / 64, ~0ull);
+  line.side(points.data(), points.size(), left.data(), right.data());
+  std::vector<std::uint64_t> left_only(left.size());
+  line.side(points.data(), points.size(), left_only.data(), nullptr);
+  ASSERT_EQ(left_only, left);
+  std::vector<std::uint64_t> right_only(right.size(), ~0ull);
+  line.side(points.data(), points.size(), nullptr, right_only.data());
+  ASSERT_EQ(right_only, right);
+  line.side(points.data(), points.size(), nullptr, nullptr);
+  int coincident = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto side = line.side(points[i]);
+    ASSERT_EQ(sides[i], side);
+    ASSERT_EQ((left[i / 64] >> (i % 64)) & 1, side == Side::LEFT);
+    ASSERT_EQ((right[i / 64] >> (i % 64)) & 1, side == Side::RIGHT);
+    coincident += side == Side::COINCIDENT;
+  }
+  ASSERT_GT(coincident, 1);
+  ASSERT_EQ(left.back() >> (points.size() % 64), 0);
+  ASSERT_EQ(right.back() >> (points.size() % 64), 0);
+}
+
+TEST(LineTest, Sides) {
+  expectSides<float>();
+  expectSides<double>();
+  expectSides<long double>();
+}
+
 }  // namespace math
 }  // namespace shotamatsuda
@@ -0,0 +1,99 @@
+//
+//  mesh_sampler_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/mesh_sampler.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/triangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class MeshSamplerTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(MeshSamplerTest, Types);
+
+TYPED_TEST(MeshSamplerTest, Build) {
+  using T = TypeParam;
+  MeshSampler2<T> sampler;
+  ASSERT_TRUE(sampler.empty());
+  // Clockwise triangles have negative areas in 2 dimensions
+  const std::vector<Triangle2<T>> triangles = {
+    Triangle2<T>(0, 0, 1, 0, 0, 1),
+    Triangle2<T>(0, 0, 0, 2, 2, 0),
+  };
+  sampler.build(triangles.data(), triangles.size());
+  ASSERT_EQ(sampler.size(), 2);
+  ASSERT_EQ(sampler[1], triangles[1]);
+  ASSERT_NEAR(sampler.area(), 2.5, 1e-6);
+}
+
+TYPED_TEST(MeshSamplerTest, RandomPoint) {
+  using T = TypeParam;
+  // Unit squares at z = 0 and 1 as two triangles each, and a degenerate one
+  const std::vector<Triangle3<T>> triangles = {
+    Triangle3<T>(0, 0, 0, 1, 0, 0, 1, 1, 0),
+    Triangle3<T>(0, 0, 0, 1, 1, 0, 0, 1, 0),
+    Triangle3<T>(0, 0, 1, 2, 0, 1, 2, 2, 1),
+    Triangle3<T>(0, 0, 1, 2, 2, 1, 0, 2, 1),
+    Triangle3<T>(0, 0, 2, 1, 1, 2, 2, 2, 2),
+  };
+  const MeshSampler3<T> sampler(triangles.data(), triangles.size());
+  ASSERT_NEAR(sampler.area(), 5, 1e-6);
+  Random<> random(1);
+  std::vector<Vec3<T>> points(100000);
+  sampler.randomPoints(points.data(), points.size(), &random);
+  points.emplace_back(sampler.randomPoint(&random));
+  std::size_t counts[2] = {};
+  std::size_t quadrant = 0;
+  for (const auto& point : points) {
+    ASSERT_TRUE(point.z == 0 || point.z == 1);
+    const auto extent = point.z ? 2 : 1;
+    ASSERT_GE(point.x, 0);
+    ASSERT_LE(point.x, extent);
+    ASSERT_GE(point.y, 0);
+    ASSERT_LE(point.y, extent);
+    ++counts[static_cast<int>(point.z)];
+    // Quadrants of each square have the same area
+    quadrant += point.x < extent / T(2) && point.y < extent / T(2);
+  }
+  ASSERT_NEAR(counts[0], points.size() / 5, points.size() / 100);
+  ASSERT_NEAR(counts[1], points.size() * 4 / 5, points.size() / 100);
+  ASSERT_NEAR(quadrant, points.size() / 4, points.size() / 100);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_LT(sampler.randomIndex(&random), 4);
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,106 @@
+//
+//  pairwise_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/pairwise.h"
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class PairwiseTest : public ::testing::Test {};
+
+using Types = ::testing::Types<std::int32_t, float, double>;
+TYPED_TEST_CASE(PairwiseTest, Types);
+
+namespace {
+
+template <class T, int D>
+std::vector<Vec<T, D>> randomVectors(std::size_t size,
+                                     Random<>::Type seed) {
+  Random<> random(seed);
+  std::vector<Vec<T, D>> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    result.emplace_back(Vec<T, D>::random(-100, 100, &random));
+  }
+  return result;
+}
+
+}  // namespace
+
+// 197 rows split into several chunks of row blocks, the last one partial
+TYPED_TEST(PairwiseTest, ComputesDistanceMatrix) {
+  const auto a = randomVectors<TypeParam, 3>(197, 1);
+  const auto b = randomVectors<TypeParam, 3>(601, 2);
+  for (int concurrency : {1, 3}) {
+    std::vector<Promote<TypeParam>> result(a.size() * b.size());
+    distanceSquared(a.data(), a.size(), b.data(), b.size(),
+                    result.data(), concurrency);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      for (std::size_t j = 0; j < b.size(); ++j) {
+        ASSERT_NEAR(result[i * b.size() + j], a[i].distanceSquared(b[j]),
+                    1e-2);
+      }
+    }
+  }
+}
+
+TYPED_TEST(PairwiseTest, FindsNearestNeighbors) {
+  const auto a = randomVectors<TypeParam, 2>(197, 3);
+  auto b = randomVectors<TypeParam, 2>(700, 4);
+  b[500] = b[20];
+  const std::size_t k = 5;
+  for (int concurrency : {1, 4}) {
+    std::vector<std::size_t> indices(a.size() * k);
+    std::vector<Promote<TypeParam>> distances(a.size() * k);
+    nearest(a.data(), a.size(), b.data(), b.size(), k,
+            indices.data(), distances.data(), concurrency);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      std::vector<std::pair<Promote<TypeParam>, std::size_t>> expected;
+      for (std::size_t j = 0; j < b.size(); ++j) {
+        expected.emplace_back(a[i].distanceSquared(b[j]), j);
+      }
+      std::sort(expected.begin(), expected.end());
+      for (std::size_t j = 0; j < k; ++j) {
+        ASSERT_EQ(indices[i * k + j], expected[j].second);
+        ASSERT_NEAR(distances[i * k + j], expected[j].first, 1e-3);
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
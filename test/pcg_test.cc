@@ -0,0 +1,93 @@
+//
+//  pcg_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/pcg.h"
+#include "shotamatsuda/math/random.h"
+
+namespace shotamatsuda {
+namespace math {
+
+TEST(PcgTest, KnownAnswers) {
+  // Output of pcg64 rng(42, 54) in the pcg-cpp demo
+  Pcg64 engine(42, 54);
+  ASSERT_EQ(engine(), 0x86b1da1d72062b68);
+  ASSERT_EQ(engine(), 0x1304aa46c9853d39);
+  ASSERT_EQ(engine(), 0xa3670e9e0dd50358);
+  ASSERT_EQ(engine(), 0xf9090e529a7dae00);
+  ASSERT_EQ(engine(), 0xc85b9fd837996f2c);
+  ASSERT_EQ(engine(), 0x606121f8e3919196);
+}
+
+TEST(PcgTest, Discard) {
+  Pcg64 engine(3, 1);
+  Pcg64 other(3, 1);
+  for (unsigned long long count : {0, 1, 2, 3, 100, 1000}) {
+    engine.discard(count);
+    for (unsigned long long i = 0; i < count; ++i) {
+      other();
+    }
+    ASSERT_EQ(engine, other);
+    ASSERT_EQ(engine(), other());
+  }
+}
+
+TEST(PcgTest, Streams) {
+  Pcg64 engine(7);
+  Pcg64 stream(7, 1);
+  Pcg64 jumped(engine);
+  jumped.jump();
+  Pcg64 long_jumped(engine);
+  long_jumped.longJump();
+  ASSERT_NE(stream, engine);
+  ASSERT_NE(jumped, engine);
+  ASSERT_NE(long_jumped, jumped);
+  std::set<std::uint64_t> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.emplace(engine());
+    values.emplace(stream());
+    values.emplace(jumped());
+    values.emplace(long_jumped());
+  }
+  ASSERT_EQ(values.size(), 4000);
+}
+
+TEST(PcgTest, UsableWithRandom) {
+  Random<Pcg64> random(5);
+  Random<Pcg64> other(5);
+  for (int i = 0; i < 100; ++i) {
+    const auto value = random.gaussian<double>();
+    ASSERT_EQ(other.gaussian<double>(), value);
+  }
+  ASSERT_EQ(random.engine(), other.engine());
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,125 @@
+//
+//  philox_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/parallel.h"
+#include "shotamatsuda/math/philox.h"
+#include "shotamatsuda/math/random.h"
+
+namespace shotamatsuda {
+namespace math {
+
+TEST(PhiloxTest, KnownAnswers) {
+  // Known-answer vectors published with Random123
+  using Counter = Philox4x32::Counter;
+  using Key = Philox4x32::Key;
+  ASSERT_EQ(Philox4x32::generate(Counter{{0, 0, 0, 0}}, Key{{0, 0}}),
+            (Counter{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  const std::uint32_t ones = 0xffffffff;
+  ASSERT_EQ(Philox4x32::generate(Counter{{ones, ones, ones, ones}},
+                                 Key{{ones, ones}}),
+            (Counter{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+  ASSERT_EQ(Philox4x32::generate(
+                Counter{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                Key{{0xa4093822, 0x299f31d0}}),
+            (Counter{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+}
+
+TEST(PhiloxTest, Addressing) {
+  Philox4x32 engine(0x0123456789abcdef, 42);
+  ASSERT_EQ(engine.stream(), 42);
+  std::vector<std::uint32_t> sequence;
+  for (int i = 0; i < 11; ++i) {
+    sequence.emplace_back(engine());
+  }
+  ASSERT_EQ(engine.position(), 11);
+  for (std::uint64_t i = 0; i < sequence.size(); ++i) {
+    Philox4x32 other(0x0123456789abcdef, 42);
+    other.seek(i);
+    ASSERT_EQ(other(), sequence[i]);
+    Philox4x32 discarded(0x0123456789abcdef, 42);
+    discarded.discard(i);
+    other.seek(i);
+    ASSERT_EQ(discarded, other);
+  }
+  ASSERT_NE(Philox4x32(1, 0)(), Philox4x32(1, 1)());
+  ASSERT_NE(Philox4x32(1, 0)(), Philox4x32(2, 0)());
+}
+
+TEST(PhiloxTest, Jump) {
+  Philox4x32 engine(0x0123456789abcdef, 42);
+  engine.discard(7);
+  engine.jump();
+  ASSERT_EQ(engine.stream(), 43);
+  ASSERT_EQ(engine.position(), 7);
+  Philox4x32 other(0x0123456789abcdef, 43);
+  other.discard(7);
+  ASSERT_EQ(engine, other);
+  ASSERT_EQ(engine(), other());
+}
+
+TEST(PhiloxTest, IndependentOfThreadCount) {
+  const std::size_t size = 10000;
+  const auto generate = [size](int concurrency) {
+    std::vector<double> result(size);
+    const auto chunks = chunkCount(size, concurrency, 1);
+    parallelFor(size, chunks, [&result](std::size_t first,
+                                        std::size_t last,
+                                        int) {
+      Philox4x32 engine(7, 3);
+      // generate_canonical() consumes two outputs per 64-bit double
+      engine.seek(first * 2);
+      for (auto i = first; i < last; ++i) {
+        result[i] = std::generate_canonical<double, 64>(engine);
+      }
+    });
+    return result;
+  };
+  const auto expected = generate(1);
+  ASSERT_EQ(generate(3), expected);
+  ASSERT_EQ(generate(8), expected);
+}
+
+TEST(PhiloxTest, UsableWithRandom) {
+  Random<Philox4x32> random(5);
+  Random<Philox4x32> other(5);
+  for (int i = 0; i < 100; ++i) {
+    const auto value = random.uniform<double>(-1, 1);
+    ASSERT_GE(value, -1);
+    ASSERT_LE(value, 1);
+    ASSERT_EQ(other.uniform<double>(-1, 1), value);
+  }
+  ASSERT_EQ(random.engine(), other.engine());
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,174 @@
+//
+//  poisson_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/circle.h"
+#include "shotamatsuda/math/poisson.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class PoissonTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(PoissonTest, Types);
+
+template <class T>
+T minimumDistance(const std::vector<Vec2<T>>& points) {
+  T result = std::numeric_limits<T>::max();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = i + 1; j < points.size(); ++j) {
+      result = std::min(result, points[i].distance(points[j]));
+    }
+  }
+  return result;
+}
+
+TYPED_TEST(PoissonTest, Rect) {
+  using T = TypeParam;
+  const Rect2<T> domain(-10, 20, 300, 200);
+  const T distance = 4;
+  Random<std::mt19937> random(1);
+  const auto points = poissonDisk(domain, distance, &random);
+  for (const auto& point : points) {
+    ASSERT_TRUE(domain.contains(point));
+  }
+  ASSERT_GE(minimumDistance(points), distance);
+  // Bridson sampling reaches a little over half of the hexagonal packing
+  const auto packing = domain.area() / (std::sqrt(T(3)) / 2 * distance *
+                                        distance);
+  ASSERT_GT(points.size(), packing * T(0.5));
+  ASSERT_LT(points.size(), packing);
+}
+
+TYPED_TEST(PoissonTest, Circle) {
+  using T = TypeParam;
+  const Circle2<T> domain(Vec2<T>(50, -30), 120);
+  const T distance = 3;
+  Random<std::mt19937> random(2);
+  const auto points = poissonDisk(domain, distance, &random);
+  for (const auto& point : points) {
+    ASSERT_TRUE(domain.contains(point));
+  }
+  ASSERT_GE(minimumDistance(points), distance);
+  const auto area = pi<T>() * domain.radius * domain.radius;
+  const auto packing = area / (std::sqrt(T(3)) / 2 * distance * distance);
+  ASSERT_GT(points.size(), packing * T(0.5));
+  ASSERT_LT(points.size(), packing);
+}
+
+// Every point of the domain on a grid of the given step has a sample within
+// twice the distance
+template <class T, class Domain>
+void expectCoverage(const Domain& domain, const Rect2<T>& bounds,
+                    const std::vector<Vec2<T>>& points, T distance, T step) {
+  const auto cell = 2 * distance;
+  const auto columns = static_cast<std::size_t>(bounds.width / cell) + 1;
+  const auto rows = static_cast<std::size_t>(bounds.height / cell) + 1;
+  std::vector<std::vector<Vec2<T>>> cells(columns * rows);
+  for (const auto& point : points) {
+    const auto column = static_cast<std::size_t>(
+        (point.x - bounds.minX()) / cell);
+    const auto row = static_cast<std::size_t>(
+        (point.y - bounds.minY()) / cell);
+    cells[row * columns + column].emplace_back(point);
+  }
+  for (auto y = bounds.minY(); y <= bounds.maxY(); y += step) {
+    for (auto x = bounds.minX(); x <= bounds.maxX(); x += step) {
+      const Vec2<T> point(x, y);
+      if (!domain.contains(point)) {
+        continue;
+      }
+      const auto column = static_cast<std::size_t>((x - bounds.minX()) / cell);
+      const auto row = static_cast<std::size_t>((y - bounds.minY()) / cell);
+      bool found = false;
+      for (auto j = row ? row - 1 : 0; j <= row + 1 && j < rows; ++j) {
+        for (auto i = column ? column - 1 : 0; i <= column + 1 && i < columns;
+             ++i) {
+          for (const auto& other : cells[j * columns + i]) {
+            found = found || point.distance(other) <= cell;
+          }
+        }
+      }
+      ASSERT_TRUE(found) << point;
+    }
+  }
+}
+
+TYPED_TEST(PoissonTest, CircleCoverage) {
+  using T = TypeParam;
+  const Circle2<T> domain(Vec2<T>(), 150);
+  const Rect2<T> bounds(-150, -150, 300, 300);
+  const T distance = 1;
+  for (int seed = 0; seed < 4; ++seed) {
+    Random<std::mt19937> random(seed);
+    const auto points = poissonDisk(domain, distance, &random);
+    expectCoverage(domain, bounds, points, distance, T(0.5));
+  }
+}
+
+TYPED_TEST(PoissonTest, RectCoverage) {
+  using T = TypeParam;
+  const Rect2<T> domain(-10, 20, 300, 200);
+  Random<std::mt19937> random(6);
+  const auto points = poissonDisk(domain, T(2), &random);
+  expectCoverage(domain, domain, points, T(2), T(0.5));
+}
+
+TYPED_TEST(PoissonTest, Concurrency) {
+  using T = TypeParam;
+  const Rect2<T> domain(0, 0, 200, 150);
+  Random<std::mt19937> random1(3);
+  Random<std::mt19937> random2(3);
+  const auto expected = poissonDisk(domain, T(1.5), &random1, 30, 1);
+  const auto points = poissonDisk(domain, T(1.5), &random2, 30, 4);
+  ASSERT_EQ(points, expected);
+  ASSERT_GE(minimumDistance(points), T(1.5));
+}
+
+TYPED_TEST(PoissonTest, Seed) {
+  using T = TypeParam;
+  const Rect2<T> domain(0, 0, 100, 100);
+  Random<std::mt19937> random1(4);
+  Random<std::mt19937> random2(5);
+  ASSERT_NE(poissonDisk(domain, T(5), &random1),
+            poissonDisk(domain, T(5), &random2));
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
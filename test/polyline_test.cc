@@ -0,0 +1,179 @@
+//
+//  polyline_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/polyline.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class PolylineTest : public ::testing::Test {};
+
+using Types = ::testing::Types<std::int32_t, float, double>;
+TYPED_TEST_CASE(PolylineTest, Types);
+
+TEST(PolylineTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Polyline2d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Polyline2d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Polyline2d>::value);
+  ASSERT_TRUE(std::is_move_constructible<Polyline2d>::value);
+  ASSERT_TRUE(std::is_move_assignable<Polyline2d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Polyline2d>::value);
+}
+
+TYPED_TEST(PolylineTest, Length) {
+  using Real = Promote<TypeParam>;
+  Polyline2<TypeParam> polyline;
+  ASSERT_TRUE(polyline.empty());
+  ASSERT_EQ(polyline.length(), Real());
+  polyline.set({{0, 0}, {3, 0}, {3, 4}});
+  ASSERT_EQ(polyline.size(), 3);
+  ASSERT_EQ(polyline.length(), 7);
+  ASSERT_EQ(polyline.distance(0), 0);
+  ASSERT_EQ(polyline.distance(1), 3);
+  ASSERT_EQ(polyline.distance(2), 7);
+  ASSERT_EQ(polyline.segment(1), Line2<TypeParam>(3, 0, 3, 4));
+
+  // Changes to the vertices update the distances after them
+  polyline.push_back({6, 4});
+  ASSERT_EQ(polyline.length(), 10);
+  polyline.set(1, {0, 4});
+  ASSERT_EQ(polyline.distance(1), 4);
+  ASSERT_EQ(polyline.distance(2), 7);
+  ASSERT_EQ(polyline.length(), 10);
+  polyline.pop_back();
+  ASSERT_EQ(polyline.length(), 7);
+  polyline.set({{1, 1}});
+  ASSERT_EQ(polyline.length(), 0);
+  polyline.reset();
+  ASSERT_TRUE(polyline.empty());
+}
+
+TYPED_TEST(PolylineTest, PointAt) {
+  using Real = Promote<TypeParam>;
+  const Polyline2<TypeParam> polyline({{0, 0}, {3, 0}, {3, 4}});
+  ASSERT_EQ(polyline.pointAt(-1), Vec2<Real>());
+  ASSERT_EQ(polyline.pointAt(0), Vec2<Real>());
+  ASSERT_EQ(polyline.pointAt(1.5), Vec2<Real>(1.5, 0));
+  ASSERT_EQ(polyline.pointAt(3), Vec2<Real>(3, 0));
+  ASSERT_EQ(polyline.pointAt(5), Vec2<Real>(3, 2));
+  ASSERT_EQ(polyline.pointAt(7), Vec2<Real>(3, 4));
+  ASSERT_EQ(polyline.pointAt(8), Vec2<Real>(3, 4));
+  ASSERT_EQ(polyline.tangentAt(-1), Vec2<Real>(1, 0));
+  ASSERT_EQ(polyline.tangentAt(1.5), Vec2<Real>(1, 0));
+  ASSERT_EQ(polyline.tangentAt(3), Vec2<Real>(0.0, 1.0));
+  ASSERT_EQ(polyline.tangentAt(8), Vec2<Real>(0.0, 1.0));
+  ASSERT_EQ(polyline.segmentAt(1.5), 0);
+  ASSERT_EQ(polyline.segmentAt(3), 1);
+  ASSERT_EQ(polyline.segmentAt(8), 1);
+}
+
+TYPED_TEST(PolylineTest, ZeroLengthSegments) {
+  using Real = Promote<TypeParam>;
+  const Polyline2<TypeParam> polyline({
+      {0, 0}, {0, 0}, {2, 0}, {2, 0}, {2, 2}, {2, 2}});
+  ASSERT_EQ(polyline.length(), 4);
+  ASSERT_EQ(polyline.segmentAt(0), 1);
+  ASSERT_EQ(polyline.segmentAt(2), 3);
+  ASSERT_EQ(polyline.segmentAt(4), 3);
+  ASSERT_EQ(polyline.tangentAt(0), Vec2<Real>(1, 0));
+  ASSERT_EQ(polyline.tangentAt(2), Vec2<Real>(0.0, 1.0));
+  ASSERT_EQ(polyline.tangentAt(4), Vec2<Real>(0.0, 1.0));
+  ASSERT_EQ(polyline.pointAt(4), Vec2<Real>(2, 2));
+
+  // A polyline of a single point has no direction
+  const Polyline2<TypeParam> point({{1, 1}, {1, 1}});
+  ASSERT_EQ(point.pointAt(1), Vec2<Real>(1, 1));
+  ASSERT_EQ(point.tangentAt(1), Vec2<Real>());
+}
+
+TYPED_TEST(PolylineTest, Resample) {
+  using Real = Promote<TypeParam>;
+  Random<> random(1);
+  std::vector<Vec2<TypeParam>> points(100);
+  for (auto& point : points) {
+    point.set(random.uniform<int>(-100, 100), random.uniform<int>(-100, 100));
+  }
+  points[10] = points[11] = points[12];
+  const Polyline2<TypeParam> polyline(points.data(), points.size());
+  for (const std::size_t size : {0, 1, 2, 3, 57, 1000}) {
+    const auto resampled = polyline.resample(size);
+    ASSERT_EQ(resampled.size(), size);
+    if (size == 1) {
+      ASSERT_EQ(resampled.front(), Vec2<Real>(polyline.front()));
+    } else if (size) {
+      for (std::size_t i = 0; i < size; ++i) {
+        const auto distance = polyline.length() * i / (size - 1);
+        ASSERT_EQ(resampled[i], polyline.pointAt(distance));
+      }
+      ASSERT_EQ(resampled.back(), Vec2<Real>(polyline.back()));
+    }
+  }
+
+  // Points along a line are evenly spaced
+  const Polyline2<TypeParam> line({{0, 0}, {1, 0}, {5, 0}, {8, 0}});
+  const auto resampled = line.resample(9);
+  for (std::size_t i = 0; i < resampled.size(); ++i) {
+    ASSERT_EQ(resampled[i], Vec2<Real>(i, 0));
+  }
+}
+
+TYPED_TEST(PolylineTest, ResamplePolylines) {
+  using Real = Promote<TypeParam>;
+  Random<> random(1);
+  std::vector<Polyline2<TypeParam>> polylines(300);
+  for (auto& polyline : polylines) {
+    const auto size = random.uniform<int>(1, 20);
+    for (int i = 0; i < size; ++i) {
+      polyline.push_back(Vec2<TypeParam>(random.uniform<int>(-100, 100),
+                                         random.uniform<int>(-100, 100)));
+    }
+  }
+  const std::size_t size = 17;
+  std::vector<Vec2<Real>> expected(polylines.size() * size);
+  for (std::size_t i = 0; i < polylines.size(); ++i) {
+    polylines[i].resample(expected.data() + i * size, size);
+  }
+  for (const int concurrency : {1, 4, 0}) {
+    std::vector<Vec2<Real>> points(expected.size());
+    resamplePolylines(polylines.data(), polylines.size(), size,
+                      points.data(), concurrency);
+    ASSERT_EQ(points, expected);
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
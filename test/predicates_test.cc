@@ -0,0 +1,174 @@
+//
+//  predicates_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/predicates.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/side.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+namespace {
+
+int sign(double value) {
+  return (value > 0) - (value < 0);
+}
+
+// Points within a few units in the last place of 0.5 are hard to classify
+// against lines and planes through it
+double nearHalf(int units) {
+  return 0.5 + units * std::numeric_limits<double>::epsilon() / 2;
+}
+
+}  // namespace
+
+TEST(PredicatesTest, Orient2d) {
+  const Vec2d a(0.0, 0.0);
+  const Vec2d b(1.0, 0.0);
+  ASSERT_GT(orient2d(a, b, Vec2d(0.0, 1.0)), 0);
+  ASSERT_LT(orient2d(a, b, Vec2d(0.0, -1.0)), 0);
+  ASSERT_EQ(orient2d(a, b, Vec2d(5.0, 0.0)), 0);
+  ASSERT_EQ(orient2d(a, b, Vec2d(0.0, 1.0)), 1);
+  ASSERT_GT(orient2d(Vec2f(0.0, 0.0), Vec2f(1.0, 0.0), Vec2f(0.0, 1.0)), 0);
+  ASSERT_GT(orient2d(Vec2i(0, 0), Vec2i(1, 0), Vec2i(0, 1)), 0);
+}
+
+TEST(PredicatesTest, Orient2dNearDegenerate) {
+  // The line y = x through points near 0.5, where the sign of the
+  // determinant is that of y - x
+  const Vec2d a(12.0, 12.0);
+  const Vec2d b(24.0, 24.0);
+  int naive_errors = 0;
+  for (int i = -32; i <= 32; ++i) {
+    for (int j = -32; j <= 32; ++j) {
+      const Vec2d point(nearHalf(i), nearHalf(j));
+      const auto expected = sign(point.y - point.x);
+      ASSERT_EQ(sign(orient2d(a, b, point)), expected);
+      const auto naive = ((b.x - a.x) * (point.y - a.y) -
+                          (b.y - a.y) * (point.x - a.x));
+      naive_errors += sign(naive) != expected;
+    }
+  }
+  // Otherwise the points would not test the exact evaluation
+  ASSERT_GT(naive_errors, 0);
+}
+
+TEST(PredicatesTest, Orient3d) {
+  const Vec3d a(0.0, 0.0, 0.0);
+  const Vec3d b(1.0, 0.0, 0.0);
+  const Vec3d c(0.0, 1.0, 0.0);
+  ASSERT_GT(orient3d(a, b, c, Vec3d(0.0, 0.0, -1.0)), 0);
+  ASSERT_LT(orient3d(a, b, c, Vec3d(0.0, 0.0, 1.0)), 0);
+  ASSERT_EQ(orient3d(a, b, c, Vec3d(3.0, 4.0, 0.0)), 0);
+  ASSERT_GT(orient3d(Vec3f(0.0, 0.0, 0.0), Vec3f(1.0, 0.0, 0.0),
+                     Vec3f(0.0, 1.0, 0.0), Vec3f(0.0, 0.0, -1.0)), 0);
+}
+
+TEST(PredicatesTest, Orient3dNearDegenerate) {
+  // The plane x + y = 2z through points near 0.5
+  const Vec3d a(12.0, 12.0, 12.0);
+  const Vec3d b(24.0, 24.0, 24.0);
+  const Vec3d c(24.0, 0.0, 12.0);
+  for (int i = -8; i <= 8; ++i) {
+    for (int j = -8; j <= 8; ++j) {
+      for (int k = -8; k <= 8; ++k) {
+        const Vec3d point(nearHalf(i), nearHalf(j), nearHalf(k));
+        ASSERT_EQ(sign(orient3d(a, b, c, point)), -sign(i + j - 2 * k));
+      }
+    }
+  }
+}
+
+TEST(PredicatesTest, Incircle) {
+  const Vec2d a(1.0, 0.0);
+  const Vec2d b(0.0, 1.0);
+  const Vec2d c(-1.0, 0.0);
+  ASSERT_GT(incircle(a, b, c, Vec2d(0.0, 0.0)), 0);
+  ASSERT_LT(incircle(a, b, c, Vec2d(2.0, 0.0)), 0);
+  ASSERT_EQ(incircle(a, b, c, Vec2d(0.0, -1.0)), 0);
+  ASSERT_LT(incircle(c, b, a, Vec2d(0.0, 0.0)), 0);
+  ASSERT_GT(incircle(Vec2f(1.0, 0.0), Vec2f(0.0, 1.0), Vec2f(-1.0, 0.0),
+                     Vec2f(0.0, 0.0)), 0);
+}
+
+TEST(PredicatesTest, IncircleNearDegenerate) {
+  // The circle of radius 5000 about (0, 0.5) through the points at
+  // multiples of (3, 4), against points within a few units in the last place
+  // of another point on it, whose squared distances from the center change
+  // by 8i + 6j units to the first order
+  const double scale = 1000;
+  const Vec2d a(3 * scale, 0.5 + 4 * scale);
+  const Vec2d b(-4 * scale, 0.5 + 3 * scale);
+  const Vec2d c(-3 * scale, 0.5 - 4 * scale);
+  const Vec2d d(4 * scale, 0.5 - 3 * scale);
+  const auto unit = std::ldexp(1.0, std::ilogb(d.x) -
+                                    std::numeric_limits<double>::digits + 1);
+  int naive_errors = 0;
+  for (int i = -16; i <= 16; ++i) {
+    for (int j = -16; j <= 16; ++j) {
+      const Vec2d point(d.x - i * unit, d.y + j * unit);
+      const auto expected = 8 * i + 6 * j > 0 ? 1 : i || j ? -1 : 0;
+      ASSERT_EQ(sign(incircle(a, b, c, point)), expected);
+      const auto adx = a.x - point.x;
+      const auto ady = a.y - point.y;
+      const auto bdx = b.x - point.x;
+      const auto bdy = b.y - point.y;
+      const auto cdx = c.x - point.x;
+      const auto cdy = c.y - point.y;
+      const auto naive = ((adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+                          (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                          (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady));
+      naive_errors += sign(naive) != expected;
+    }
+  }
+  ASSERT_GT(naive_errors, 0);
+}
+
+TEST(PredicatesTest, Side) {
+  Random<> random(1);
+  for (int i = 0; i < 1000; ++i) {
+    const Line2d line(random.uniform(-1.0, 1.0), random.uniform(-1.0, 1.0),
+                      random.uniform(-1.0, 1.0), random.uniform(-1.0, 1.0));
+    const Vec2d point(random.uniform(-1.0, 1.0), random.uniform(-1.0, 1.0));
+    ASSERT_EQ(side(line.a, line.b, point), line.side(point));
+  }
+  const Vec2d a(12.0, 12.0);
+  const Vec2d b(24.0, 24.0);
+  ASSERT_EQ(side(a, b, Vec2d(nearHalf(1), nearHalf(0))), Side::LEFT);
+  ASSERT_EQ(side(a, b, Vec2d(nearHalf(0), nearHalf(1))), Side::RIGHT);
+  ASSERT_EQ(side(a, b, Vec2d(nearHalf(1), nearHalf(1))), Side::COINCIDENT);
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -24,11 +24,24 @@
 //  DEALINGS IN THE SOFTWARE.
 //
 
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
+#include "shotamatsuda/math/pcg.h"
+#include "shotamatsuda/math/philox.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/xoshiro.h"
 
 namespace shotamatsuda {
 namespace math {
@@ -42,5 +55,390 @@ TEST(RandomTest, Concepts) {
   ASSERT_FALSE(std::has_virtual_destructor<Random<>>::value);
 }
 
+TEST(RandomTest, LocalInstancePerThread) {
+  const auto main = &Random<>::local();
+  ASSERT_EQ(&Random<>::local(), main);
+  const Random<> *other = nullptr;
+  std::thread([&other] { other = &Random<>::local(); }).join();
+  ASSERT_NE(other, main);
+}
+
+TEST(RandomTest, SeedsLocalInstancesDeterministically) {
+  const auto draw = [] {
+    std::vector<Random<>::Type> result;
+    random::seed(42);
+    result.emplace_back(random::next());
+    for (int i = 0; i < 3; ++i) {
+      std::thread([&result] {
+        result.emplace_back(random::next());
+      }).join();
+    }
+    return result;
+  };
+  const auto expected = draw();
+  ASSERT_EQ(draw(), expected);
+  for (std::size_t i = 1; i < expected.size(); ++i) {
+    ASSERT_NE(expected[i], expected[i - 1]);
+  }
+}
+
+TEST(RandomTest, SeedsLocalInstancesByIndex) {
+  const auto draw = [](bool reversed) {
+    std::vector<Random<>::Type> result(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      const auto index = reversed ? result.size() - 1 - i : i;
+      threads.emplace_back([&result, index] {
+        Random<>::local().next();
+        Random<>::seedLocal(42, index);
+        result[index] = random::next();
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return result;
+  };
+  const auto expected = draw(false);
+  ASSERT_EQ(draw(true), expected);
+  ASSERT_EQ(std::set<Random<>::Type>(expected.begin(), expected.end()).size(),
+            expected.size());
+  random::seed(42);
+  ASSERT_EQ(random::next(), expected[0]);
+}
+
+TEST(RandomTest, ReseedsThreadsAccessedBeforeSeeding) {
+  const auto draw = [] {
+    std::atomic<int> step(0);
+    Random<>::Type result;
+    std::thread thread([&step, &result] {
+      random::next();
+      step = 1;
+      while (step != 2) {
+        std::this_thread::yield();
+      }
+      result = random::next();
+    });
+    while (step != 1) {
+      std::this_thread::yield();
+    }
+    random::seed(42);
+    step = 2;
+    thread.join();
+    return result;
+  };
+  ASSERT_EQ(draw(), draw());
+}
+
+TEST(RandomTest, DrawsFromLocalInstance) {
+  random::seed(7);
+  const auto integer = random::uniform<int>(-10, 10);
+  const auto real = random::uniform<double>(1.0);
+  const auto normal = random::gaussian<double>();
+  const auto vector = Vec3d::random(-1, 1);
+  auto& local = Random<>::local();
+  random::seed(7);
+  ASSERT_EQ(local.uniform<int>(-10, 10), integer);
+  ASSERT_EQ(local.uniform<double>(1.0), real);
+  ASSERT_EQ(local.gaussian<double>(), normal);
+  ASSERT_EQ(Vec3d::random(-1, 1, &local), vector);
+}
+
+template <class T>
+class RandomFillTest : public ::testing::Test {};
+
+using Engines = ::testing::Types<
+  std::mt19937,
+  std::minstd_rand,
+  Philox4x32,
+  Xoshiro256,
+  Pcg64
+>;
+TYPED_TEST_CASE(RandomFillTest, Engines);
+
+template <class T>
+void expectMoments(const std::vector<T>& values, double mean, double stddev) {
+  double sum = 0;
+  double squared_sum = 0;
+  for (const auto value : values) {
+    sum += value;
+    squared_sum += static_cast<double>(value) * value;
+  }
+  const auto actual_mean = sum / values.size();
+  const auto variance = squared_sum / values.size() - actual_mean * actual_mean;
+  EXPECT_NEAR(actual_mean, mean, 0.02 * stddev);
+  EXPECT_NEAR(std::sqrt(variance), stddev, 0.02 * stddev);
+}
+
+TYPED_TEST(RandomFillTest, FillUniform) {
+  Random<TypeParam> random(1);
+  std::vector<float> floats(10001);
+  random.fillUniform(floats.data(), floats.size(), -2.f, 6.f);
+  for (const auto value : floats) {
+    ASSERT_GE(value, -2);
+    ASSERT_LT(value, 6);
+  }
+  expectMoments(floats, 2, 8 / std::sqrt(12.0));
+  std::vector<double> doubles(10001);
+  random.fillUniform(doubles.data(), doubles.size(), 1.0, 2.0);
+  for (const auto value : doubles) {
+    ASSERT_GE(value, 1);
+    ASSERT_LT(value, 2);
+  }
+  expectMoments(doubles, 1.5, 1 / std::sqrt(12.0));
+  std::vector<int> integers(10001);
+  random.fillUniform(integers.data(), integers.size(), -3, 3);
+  for (const auto value : integers) {
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 3);
+  }
+}
+
+// Always returns the largest word, which maps to the top of the canonical
+// range and rounded up to max before
+template <class T>
+struct SaturatedEngine {
+  using result_type = T;
+  static constexpr T min() { return 0; }
+  static constexpr T max() { return std::numeric_limits<T>::max(); }
+  T operator()() { return max(); }
+};
+
+template <class Engine>
+void expectUniformBelowMax() {
+  Random<Engine> random{Engine()};
+  std::vector<float> floats(17);
+  random.fillUniform(floats.data(), floats.size(), 1.f, 2.f);
+  for (const auto value : floats) {
+    ASSERT_LT(value, 2);
+  }
+  random.fillUniform(floats.data(), floats.size(), -3.f, -1.f);
+  for (const auto value : floats) {
+    ASSERT_LT(value, -1);
+  }
+  std::vector<double> doubles(17);
+  random.fillUniform(doubles.data(), doubles.size(), 1.0, 2.0);
+  for (const auto value : doubles) {
+    ASSERT_LT(value, 2);
+  }
+  random.fillUniform(doubles.data(), doubles.size(), 100.0, 101.0);
+  for (const auto value : doubles) {
+    ASSERT_LT(value, 101);
+  }
+  std::vector<Vec3f> vectors(5);
+  Vec3f::random(vectors.data(), vectors.size(), 1.f, 2.f, &random);
+  for (const auto& vector : vectors) {
+    ASSERT_LT(vector.x, 2);
+    ASSERT_LT(vector.y, 2);
+    ASSERT_LT(vector.z, 2);
+  }
+}
+
+TEST(RandomTest, FillUniformExcludesMax) {
+  expectUniformBelowMax<SaturatedEngine<std::uint32_t>>();
+  expectUniformBelowMax<SaturatedEngine<std::uint64_t>>();
+}
+
+TYPED_TEST(RandomFillTest, FillGaussian) {
+  Random<TypeParam> random(2);
+  std::vector<double> doubles(20001);
+  random.fillGaussian(doubles.data(), doubles.size(), 3, 2);
+  expectMoments(doubles, 3, 2);
+  std::vector<float> floats(20001);
+  random.fillGaussian(floats.data(), floats.size());
+  for (const auto value : floats) {
+    ASSERT_TRUE(std::isfinite(value));
+  }
+  expectMoments(floats, 0, 1);
+}
+
+TYPED_TEST(RandomFillTest, Deterministic) {
+  Random<TypeParam> random(3);
+  Random<TypeParam> other(3);
+  std::vector<Vec3f> vectors(1000);
+  std::vector<Vec3f> expected(1000);
+  Vec3f::random(vectors.data(), vectors.size(), -1, 1, &random);
+  other.fillUniform(&expected.front().x, expected.size() * 3, -1.f, 1.f);
+  ASSERT_EQ(vectors, expected);
+  ASSERT_EQ(random.engine(), other.engine());
+}
+
+// Returns the chi-squared statistic of values against the distribution
+// function over bins of equal width in [min, max), plus the two tails.
+template <class Distribution>
+double chiSquared(const std::vector<double>& values, double min, double max,
+                  int bins, Distribution distribution) {
+  std::vector<double> counts(bins + 2);
+  for (const auto value : values) {
+    if (value < min) {
+      ++counts.front();
+    } else if (value >= max) {
+      ++counts.back();
+    } else {
+      ++counts[1 + static_cast<int>((value - min) / (max - min) * bins)];
+    }
+  }
+  double result = 0;
+  for (int i = 0; i < bins + 2; ++i) {
+    const auto width = (max - min) / bins;
+    const auto lower = i ? distribution(min + width * (i - 1)) : 0;
+    const auto upper = i <= bins ? distribution(min + width * i) : 1;
+    const auto expected = (upper - lower) * values.size();
+    if (!expected) {
+      EXPECT_EQ(counts[i], 0);
+      continue;
+    }
+    result += (counts[i] - expected) * (counts[i] - expected) / expected;
+  }
+  return result;
+}
+
+TYPED_TEST(RandomFillTest, ZigguratGaussian) {
+  Random<TypeParam> random(4);
+  std::vector<double> values(200000);
+  random.fillGaussian(values.data(), values.size(), 0, 1, Sampling::ZIGGURAT);
+  expectMoments(values, 0, 1);
+  // 42 bins leave 41 degrees of freedom, whose 99.99th percentile is 80.
+  const auto normal = [](double x) { return std::erfc(-x / std::sqrt(2)) / 2; };
+  EXPECT_LT(chiSquared(values, -4, 4, 40, normal), 80);
+  std::size_t tail = 0;
+  for (const auto value : values) {
+    tail += std::abs(value) > 3.6541528853610088;
+  }
+  EXPECT_GT(tail, 0);
+  EXPECT_NEAR(tail / 200000.0, 2.58e-4, 1.5e-4);
+  for (int i = 0; i < 1000; ++i) {
+    const auto value = random.template gaussian<float>(
+        5, 2, Sampling::ZIGGURAT);
+    ASSERT_TRUE(std::isfinite(value));
+  }
+}
+
+TYPED_TEST(RandomFillTest, ZigguratExponential) {
+  Random<TypeParam> random(5);
+  std::vector<double> values(200000);
+  random.fillExponential(values.data(), values.size(), 2, Sampling::ZIGGURAT);
+  for (const auto value : values) {
+    ASSERT_GE(value, 0);
+  }
+  expectMoments(values, 0.5, 0.5);
+  const auto exponential = [](double x) {
+    return x < 0 ? 0 : 1 - std::exp(-2 * x);
+  };
+  EXPECT_LT(chiSquared(values, 0, 4, 40, exponential), 80);
+  std::vector<double> standard(200000);
+  random.fillExponential(standard.data(), standard.size(), 2);
+  expectMoments(standard, 0.5, 0.5);
+  EXPECT_LT(chiSquared(standard, 0, 4, 40, exponential), 80);
+}
+
+TYPED_TEST(RandomFillTest, Split) {
+  using Engine = TypeParam;
+  Random<Engine> random1(6);
+  Random<Engine> random2(6);
+  const auto children1 = random1.spawn(64);
+  const auto children2 = random2.spawn(64);
+  ASSERT_EQ(random1.engine(), random2.engine());
+  std::set<std::vector<std::uint64_t>> sequences;
+  for (std::size_t i = 0; i < children1.size(); ++i) {
+    ASSERT_EQ(children1[i].engine(), children2[i].engine());
+    auto child = children1[i];
+    std::vector<std::uint64_t> sequence;
+    for (int j = 0; j < 4; ++j) {
+      sequence.emplace_back(child.next());
+    }
+    sequences.emplace(sequence);
+  }
+  std::vector<std::uint64_t> sequence;
+  for (int j = 0; j < 4; ++j) {
+    sequence.emplace_back(random1.next());
+  }
+  sequences.emplace(sequence);
+  ASSERT_EQ(sequences.size(), children1.size() + 1);
+}
+
+TYPED_TEST(RandomFillTest, NestedSplit) {
+  using Engine = TypeParam;
+  Random<Engine> parent(7);
+  auto child = parent.split();
+  auto sibling = parent.split();
+  auto grandchild = child.split();
+  auto great_grandchild = grandchild.split();
+  auto nephew = sibling.split();
+  std::vector<Random<Engine> *> randoms = {
+    &parent, &child, &sibling, &grandchild, &great_grandchild, &nephew,
+  };
+  // No window of three consecutive outputs may appear in two streams
+  std::set<std::vector<std::uint64_t>> windows;
+  std::size_t count = 0;
+  for (const auto random : randoms) {
+    std::vector<std::uint64_t> window(3);
+    for (auto& value : window) {
+      value = random->next();
+    }
+    for (int i = 0; i < 1000; ++i) {
+      windows.emplace(window);
+      ++count;
+      window.erase(window.begin());
+      window.emplace_back(random->next());
+    }
+  }
+  ASSERT_EQ(windows.size(), count);
+}
+
+TYPED_TEST(RandomFillTest, State) {
+  using Engine = TypeParam;
+  Random<Engine> random(7);
+  random.engine().discard(5);
+  const auto state = random.saveState();
+  std::vector<std::uint64_t> expected;
+  for (int i = 0; i < 10; ++i) {
+    expected.emplace_back(random.next());
+  }
+  Random<Engine> restored(8);
+  ASSERT_TRUE(restored.loadState(state.data(), state.size()));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(restored.next(), expected[i]);
+  }
+  ASSERT_EQ(restored.engine(), random.engine());
+}
+
+TEST(RandomTest, RejectsMismatchingState) {
+  Random<std::mt19937> random(9);
+  const auto state = random.saveState();
+  Random<std::mt19937_64> other(9);
+  const auto engine = other.engine();
+  ASSERT_FALSE(other.loadState(state.data(), state.size()));
+  ASSERT_EQ(other.engine(), engine);
+  Random<std::minstd_rand> minstd1(9);
+  Random<std::minstd_rand0> minstd0(9);
+  const auto minstd_state = minstd1.saveState();
+  ASSERT_FALSE(minstd0.loadState(minstd_state.data(), minstd_state.size()));
+  Random<std::mt19937> restored;
+  ASSERT_FALSE(restored.loadState(state.data(), state.size() - 1));
+  ASSERT_FALSE(restored.loadState(state.data(), 0));
+  auto versioned = state;
+  ++versioned[4];
+  ASSERT_FALSE(restored.loadState(versioned.data(), versioned.size()));
+  ASSERT_TRUE(restored.loadState(state.data(), state.size()));
+  ASSERT_EQ(restored.engine(), random.engine());
+}
+
+TEST(RandomTest, TextState) {
+  // Engines that are not trivially copyable go through their text form
+  std::mt19937 engine(10);
+  engine.discard(3);
+  std::vector<std::uint8_t> data;
+  detail::saveEngine(engine, &data, std::false_type());
+  const auto header = sizeof(detail::RandomStateHeader);
+  std::mt19937 restored;
+  ASSERT_FALSE(detail::loadEngine(&restored, data.data() + header, 16,
+                                  std::false_type()));
+  ASSERT_EQ(restored, std::mt19937());
+  ASSERT_TRUE(detail::loadEngine(&restored, data.data() + header,
+                                 data.size() - header, std::false_type()));
+  ASSERT_EQ(restored, engine);
+}
+
 }  // namespace math
 }  // namespace shotamatsuda
@@ -0,0 +1,69 @@
+//
+//  rectangle_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class RectTest : public ::testing::Test {};
+
+using Types = ::testing::Types<std::int32_t, float, double>;
+TYPED_TEST_CASE(RectTest, Types);
+
+TYPED_TEST(RectTest, RandomPoint) {
+  using T = TypeParam;
+  using Real = Promote<T>;
+  const Rect2<T> rect(-10, 20, 40, 10);
+  Random<> random(1);
+  std::vector<Vec2<Real>> points(10000);
+  rect.randomPoints(points.data(), points.size(), &random);
+  points.emplace_back(rect.randomPoint(&random));
+  Vec2<Real> mean;
+  int left = 0;
+  for (const auto& point : points) {
+    ASSERT_GE(point.x, rect.minX());
+    ASSERT_LE(point.x, rect.maxX());
+    ASSERT_GE(point.y, rect.minY());
+    ASSERT_LE(point.y, rect.maxY());
+    mean += point / points.size();
+    left += point.x < rect.midX();
+  }
+  ASSERT_NEAR(left, points.size() / 2, points.size() / 50);
+  ASSERT_NEAR(mean.x, rect.midX(), 0.5);
+  ASSERT_NEAR(mean.y, rect.midY(), 0.25);
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,146 @@
+//
+//  reduction_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/promotion.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rectangle.h"
+#include "shotamatsuda/math/reduction.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class ReductionTest : public ::testing::Test {};
+
+using Types = ::testing::Types<
+  std::int16_t,
+  std::int32_t,
+  float,
+  double
+>;
+TYPED_TEST_CASE(ReductionTest, Types);
+
+namespace {
+
+template <class T, int D>
+std::vector<Vec<T, D>> randomVectors(std::size_t size,
+                                     Random<>::Type seed) {
+  Random<> random(seed);
+  std::vector<Vec<T, D>> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    result.emplace_back(Vec<T, D>::random(-100, 100, &random));
+  }
+  return result;
+}
+
+// Below one grain, and above four grains with an uneven last chunk
+const std::size_t kSizes[] = {1001, (4 << 16) + 4321};
+
+}  // namespace
+
+TYPED_TEST(ReductionTest, MatchesSequentialLoops) {
+  for (const auto size : kSizes) {
+    const auto values = randomVectors<TypeParam, 3>(size, 1);
+    Vec3<Promote<TypeParam>> expected;
+    Vec3<TypeParam> min = values.front();
+    Vec3<TypeParam> max = values.front();
+    for (const auto& value : values) {
+      expected += value;
+      for (int i = 0; i < 3; ++i) {
+        min[i] = std::min(min[i], value[i]);
+        max[i] = std::max(max[i], value[i]);
+      }
+    }
+    const auto tolerance = 1e-3 * values.size();
+    for (int concurrency : {1, 4}) {
+      for (auto summation : {Summation::NAIVE, Summation::COMPENSATED}) {
+        const auto result = sum(values.data(), values.size(),
+                                summation, concurrency);
+        ASSERT_TRUE(result.equals(expected, tolerance));
+        ASSERT_TRUE(centroid(values.data(), values.size(),
+                             summation, concurrency).equals(
+            expected / values.size(), tolerance / values.size()));
+      }
+      ASSERT_EQ(minimum(values.data(), values.size(), concurrency), min);
+      ASSERT_EQ(maximum(values.data(), values.size(), concurrency), max);
+    }
+  }
+}
+
+TYPED_TEST(ReductionTest, ComputesBounds) {
+  for (const auto size : kSizes) {
+    const auto values = randomVectors<TypeParam, 2>(size, 2);
+    Rect2<TypeParam> expected(values.front(), values.front());
+    expected.include(values.begin(), values.end());
+    ASSERT_TRUE(bounds(values.data(), values.size()).equals(expected, 1e-4));
+    ASSERT_TRUE(bounds(values.data(), values.size(), 3).equals(expected,
+                                                              1e-4));
+  }
+  ASSERT_EQ(bounds<TypeParam>(nullptr, 0), Rect2<TypeParam>());
+}
+
+TEST(ReductionTest, CompensatesRoundingErrors) {
+  // Every small term is lost to rounding without compensation
+  std::vector<Vec2f> values(1 << 20, Vec2f(1e-4f, -1e-4f));
+  values.front().set(1e4f, -1e4f);
+  const auto naive = sum(values.data(), values.size());
+  const auto compensated = sum(values.data(), values.size(),
+                               Summation::COMPENSATED);
+  const Vec2d expected(1e4 + 1e-4 * (values.size() - 1),
+                       -1e4 - 1e-4 * (values.size() - 1));
+  ASSERT_GT(Vec2d(naive).distance(expected), 1);
+  ASSERT_LT(Vec2d(compensated).distance(expected), 1);
+  ASSERT_LT(Vec2d(sum(values.data(), values.size(), Summation::COMPENSATED,
+                      4)).distance(expected), 1);
+}
+
+TEST(ReductionTest, SplitsWorkIntoChunks) {
+  ASSERT_EQ(chunkCount(0, 4, 16), 1);
+  ASSERT_EQ(chunkCount(100, 4, 16), 4);
+  ASSERT_EQ(chunkCount(40, 4, 16), 2);
+  ASSERT_GE(chunkCount(1 << 20, 0, 1), 1);
+  std::vector<int> visited(1000);
+  parallelFor(visited.size(), 3, [&](std::size_t first, std::size_t last,
+                                     int chunk) {
+    for (auto i = first; i < last; ++i) {
+      visited[i] += chunk + 1;
+    }
+  });
+  ASSERT_EQ(visited.front(), 1);
+  ASSERT_EQ(visited.back(), 3);
+  for (auto count : visited) {
+    ASSERT_GT(count, 0);
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
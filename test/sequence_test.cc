@@ -0,0 +1,152 @@
+//
+//  sequence_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/sequence.h"
+#include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/vector_buffer.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class SequenceTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(SequenceTest, Types);
+
+// Returns whether every elementary interval of 2^k cells with k = log2(size)
+// contains exactly one point, which is the (0, m, 2)-net property.
+template <class T>
+bool isNet(const std::vector<Vec2<T>>& points) {
+  int bits = 0;
+  while ((std::size_t(1) << bits) < points.size()) {
+    ++bits;
+  }
+  for (int xbits = 0; xbits <= bits; ++xbits) {
+    const auto columns = std::size_t(1) << xbits;
+    const auto rows = std::size_t(1) << (bits - xbits);
+    std::vector<int> counts(points.size());
+    for (const auto& point : points) {
+      const auto column = static_cast<std::size_t>(point.x * columns);
+      const auto row = static_cast<std::size_t>(point.y * rows);
+      if (++counts[row * columns + column] > 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class Sequence, class T, int D>
+void expectConsistentFills(const Sequence& sequence) {
+  const std::uint64_t first = 123456;
+  const std::size_t size = 100003;
+  std::vector<Vec<T, D>> expected(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    expected[i] = sequence.at(first + i);
+    for (int j = 0; j < D; ++j) {
+      ASSERT_GE(expected[i][j], 0);
+      ASSERT_LT(expected[i][j], 1);
+    }
+  }
+  std::vector<Vec<T, D>> values(size);
+  sequence.fill(first, values.data(), values.size(), 4);
+  ASSERT_EQ(values, expected);
+  VecBuffer<T, D> buffer(size);
+  sequence.fill(first, &buffer, 3);
+  ASSERT_EQ(buffer.vectors(), expected);
+}
+
+TYPED_TEST(SequenceTest, Halton) {
+  const HaltonSequence<TypeParam, 3> sequence;
+  ASSERT_EQ(sequence[0], Vec3<TypeParam>());
+  ASSERT_TRUE(sequence[1].equals(Vec3<TypeParam>(0.5, 1.0 / 3, 0.2), 1e-6));
+  ASSERT_TRUE(sequence[5].equals(
+      Vec3<TypeParam>(0.625, 7.0 / 9, 1.0 / 25), 1e-6));
+  expectConsistentFills<HaltonSequence<TypeParam, 2>, TypeParam, 2>({});
+  expectConsistentFills<HaltonSequence<TypeParam, 3>, TypeParam, 3>({});
+}
+
+TYPED_TEST(SequenceTest, Sobol) {
+  const SobolSequence<TypeParam, 3> sequence;
+  ASSERT_EQ(sequence[0], Vec3<TypeParam>());
+  ASSERT_EQ(sequence[1], Vec3<TypeParam>(0.5, 0.5, 0.5));
+  ASSERT_EQ(sequence[2], Vec3<TypeParam>(0.25, 0.75, 0.75));
+  ASSERT_EQ(sequence[3], Vec3<TypeParam>(0.75, 0.25, 0.25));
+  for (std::uint32_t seed = 0; seed < 3; ++seed) {
+    const SobolSequence<TypeParam, 2> scrambled(seed);
+    std::vector<Vec2<TypeParam>> points;
+    std::vector<Vec2<TypeParam>> unscrambled;
+    for (std::uint64_t i = 0; i < 256; ++i) {
+      points.emplace_back(scrambled[i]);
+      unscrambled.emplace_back(SobolSequence<TypeParam, 2>()[i]);
+    }
+    ASSERT_TRUE(isNet(points));
+    ASSERT_TRUE(isNet(unscrambled));
+    ASSERT_NE(points, unscrambled);
+  }
+  expectConsistentFills<SobolSequence<TypeParam, 2>, TypeParam, 2>({});
+  expectConsistentFills<SobolSequence<TypeParam, 3>, TypeParam, 3>(
+      SobolSequence<TypeParam, 3>(7));
+}
+
+TYPED_TEST(SequenceTest, Roberts) {
+  const R2<TypeParam> sequence;
+  ASSERT_EQ(sequence[0], Vec2<TypeParam>(0.5, 0.5));
+  ASSERT_TRUE(sequence[1].equals(
+      Vec2<TypeParam>(0.2548776662, 0.0698402551), 1e-6));
+  const R3<TypeParam> other(0);
+  ASSERT_TRUE(other[1].equals(
+      Vec3<TypeParam>(0.8191725134, 0.6710436067, 0.5497004779), 1e-6));
+  expectConsistentFills<R2<TypeParam>, TypeParam, 2>({});
+  expectConsistentFills<R3<TypeParam>, TypeParam, 3>(R3<TypeParam>(0.25));
+}
+
+TYPED_TEST(SequenceTest, Integrates) {
+  // Integral of x * y * z over the unit cube, where the standard error of
+  // 4096 uniform random points would be 2.3e-3
+  const auto integrate = [](const auto& sequence) {
+    double sum = 0;
+    for (std::uint64_t i = 0; i < 4096; ++i) {
+      const auto point = sequence[i];
+      sum += static_cast<double>(point.x) * point.y * point.z;
+    }
+    return sum / 4096;
+  };
+  EXPECT_NEAR(integrate(HaltonSequence<TypeParam, 3>()), 0.125, 2e-3);
+  EXPECT_NEAR(integrate(SobolSequence<TypeParam, 3>()), 0.125, 2e-3);
+  EXPECT_NEAR(integrate(SobolSequence<TypeParam, 3>(1)), 0.125, 2e-3);
+  EXPECT_NEAR(integrate(R3<TypeParam>()), 0.125, 2e-3);
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
@@ -0,0 +1,240 @@
+//
+//  simplification_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/line.h"
+#include "shotamatsuda/math/polyline.h"
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/simplification.h"
+#include "shotamatsuda/math/vector.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class SimplificationTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(SimplificationTest, Types);
+
+namespace {
+
+template <class T>
+std::vector<Vec2<T>> randomWalk(std::size_t size) {
+  Random<> random(1);
+  std::vector<Vec2<T>> points(size);
+  for (std::size_t i = 1; i < size; ++i) {
+    points[i] = points[i - 1] + Vec2<T>(random.uniform<T>(0, 1),
+                                        random.uniform<T>(-1, 1));
+  }
+  return points;
+}
+
+template <class T>
+void douglasPeucker(const std::vector<Vec2<T>>& points, std::size_t first,
+                    std::size_t last, T tolerance,
+                    std::vector<Vec2<T>> *result) {
+  const Line2<T> line(points[first], points[last]);
+  auto farthest = first;
+  auto distance = tolerance;
+  for (auto i = first + 1; i < last; ++i) {
+    if (points[i].distance(line.project(points[i])) > distance) {
+      farthest = i;
+      distance = points[i].distance(line.project(points[i]));
+    }
+  }
+  if (farthest == first) {
+    result->push_back(points[last]);
+  } else {
+    douglasPeucker(points, first, farthest, tolerance, result);
+    douglasPeucker(points, farthest, last, tolerance, result);
+  }
+}
+
+// Returns whether the simplified points are a subsequence of the points
+// that keeps the ends, and every point lies within the tolerance of the
+// line that replaces it
+template <class T>
+bool isWithinTolerance(const std::vector<Vec2<T>>& points,
+                       const std::vector<Vec2<T>>& simplified,
+                       T tolerance) {
+  if (simplified.front() != points.front() ||
+      simplified.back() != points.back()) {
+    return false;
+  }
+  std::size_t index = 0;
+  for (std::size_t i = 1; i < simplified.size(); ++i) {
+    const Line2<T> line(simplified[i - 1], simplified[i]);
+    for (++index; index < points.size() && points[index] != simplified[i];
+         ++index) {
+      if (points[index].distance(line.project(points[index])) >
+          tolerance * (1 + 1e-4)) {
+        return false;
+      }
+    }
+    if (index == points.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TYPED_TEST(SimplificationTest, DouglasPeucker) {
+  using Vec = Vec2<TypeParam>;
+  std::vector<Vec> result;
+  const std::vector<Vec> line{
+      {0, 0}, {1, 0.1}, {2, -0.1}, {3, 5}, {4, 6}, {5, 7}, {6, 8.1}};
+  simplify(line.data(), line.size(), Simplification::DOUGLAS_PEUCKER,
+           TypeParam(0.5), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{{0, 0}, {2, -0.1}, {3, 5}, {6, 8.1}}));
+  simplify(line.data(), 2, Simplification::DOUGLAS_PEUCKER,
+           TypeParam(0.5), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{{0, 0}, {1, 0.1}}));
+  simplify(line.data(), 0, Simplification::DOUGLAS_PEUCKER,
+           TypeParam(0.5), &result);
+  ASSERT_TRUE(result.empty());
+
+  // Matches the recursive algorithm
+  const auto points = randomWalk<TypeParam>(5000);
+  for (const TypeParam tolerance : {0.0, 0.5, 2.0, 10.0}) {
+    std::vector<Vec> expected{points.front()};
+    douglasPeucker(points, 0, points.size() - 1, tolerance, &expected);
+    simplify(points.data(), points.size(), Simplification::DOUGLAS_PEUCKER,
+             tolerance, &result);
+    ASSERT_EQ(result, expected);
+    ASSERT_TRUE(isWithinTolerance(points, result, tolerance));
+  }
+}
+
+TYPED_TEST(SimplificationTest, Visvalingam) {
+  using Vec = Vec2<TypeParam>;
+  std::vector<Vec> result;
+  // Collinear points have no area, and the smaller triangle goes first
+  const std::vector<Vec> points{
+      {0, 0}, {1, 0}, {2, 0}, {3, 1}, {4, 0}, {5, 4}, {6, 0}};
+  simplify(points.data(), points.size(), Simplification::VISVALINGAM,
+           TypeParam(0.5), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{
+      {0, 0}, {2, 0}, {3, 1}, {4, 0}, {5, 4}, {6, 0}}));
+  simplify(points.data(), points.size(), Simplification::VISVALINGAM,
+           TypeParam(2), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{
+      {0, 0}, {3, 1}, {4, 0}, {5, 4}, {6, 0}}));
+  simplify(points.data(), points.size(), Simplification::VISVALINGAM,
+           TypeParam(3), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{{0, 0}, {4, 0}, {5, 4}, {6, 0}}));
+  simplify(points.data(), points.size(), Simplification::VISVALINGAM,
+           TypeParam(100), &result);
+  ASSERT_EQ(result, (std::vector<Vec>{{0, 0}, {6, 0}}));
+
+  // Larger tolerances remove more points
+  const auto walk = randomWalk<TypeParam>(5000);
+  std::size_t size = walk.size();
+  for (const TypeParam tolerance : {0.0, 0.1, 1.0, 10.0}) {
+    simplify(walk.data(), walk.size(), Simplification::VISVALINGAM,
+             tolerance, &result);
+    ASSERT_LE(result.size(), size);
+    ASSERT_EQ(result.front(), walk.front());
+    ASSERT_EQ(result.back(), walk.back());
+    size = result.size();
+  }
+  ASSERT_LT(size, walk.size() / 10);
+}
+
+TYPED_TEST(SimplificationTest, Polylines) {
+  std::vector<Polyline2<TypeParam>> polylines;
+  for (std::size_t size = 0; size < 100; ++size) {
+    const auto points = randomWalk<TypeParam>(size * 7);
+    polylines.emplace_back(points.data(), points.size());
+  }
+  for (const auto method : {Simplification::DOUGLAS_PEUCKER,
+                            Simplification::VISVALINGAM}) {
+    std::vector<Polyline2<TypeParam>> expected;
+    for (const auto& polyline : polylines) {
+      expected.push_back(simplify(polyline, method, TypeParam(1)));
+    }
+    for (const int concurrency : {1, 4, 0}) {
+      std::vector<Polyline2<TypeParam>> results(polylines.size());
+      simplify(polylines.data(), polylines.size(), method, TypeParam(1),
+               results.data(), concurrency);
+      ASSERT_EQ(results, expected);
+    }
+  }
+}
+
+TYPED_TEST(SimplificationTest, Streaming) {
+  using Vec = Vec2<TypeParam>;
+  const auto points = randomWalk<TypeParam>(20000);
+  const TypeParam tolerance = 2;
+  for (const auto method : {Simplification::DOUGLAS_PEUCKER,
+                            Simplification::VISVALINGAM}) {
+    // A capacity beyond the polyline simplifies it at once
+    std::vector<Vec> expected;
+    simplify(points.data(), points.size(), method, tolerance, &expected);
+    Simplifier<TypeParam> whole(method, tolerance, points.size() + 1);
+    std::vector<Vec> result;
+    whole.push(points.data(), points.size(), &result);
+    ASSERT_TRUE(result.empty());
+    whole.finish(&result);
+    ASSERT_EQ(result, expected);
+
+    // Chunks of any size give the same result
+    Simplifier<TypeParam> simplifier(method, tolerance, 256);
+    std::vector<Vec> streamed;
+    for (const std::size_t chunk : {1, 7, 256, 1000, 20000}) {
+      std::vector<Vec> simplified;
+      for (std::size_t first = 0; first < points.size(); first += chunk) {
+        const auto size = std::min(chunk, points.size() - first);
+        result.clear();
+        simplifier.push(points.data() + first, size, &result);
+        simplified.insert(simplified.end(), result.begin(), result.end());
+      }
+      result.clear();
+      simplifier.finish(&result);
+      simplified.insert(simplified.end(), result.begin(), result.end());
+      if (streamed.empty()) {
+        streamed = simplified;
+        // Windows change the result only near their boundaries
+        ASSERT_GT(streamed.size(), expected.size() * 0.9);
+        ASSERT_LT(streamed.size(), expected.size() * 1.1);
+      }
+      ASSERT_EQ(simplified, streamed);
+    }
+    if (method == Simplification::DOUGLAS_PEUCKER) {
+      ASSERT_TRUE(isWithinTolerance(points, streamed, tolerance));
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
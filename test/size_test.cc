@@ -33,6 +33,7 @@
 
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rectangle.h"
 #include "shotamatsuda/math/size.h"
 
 namespace shotamatsuda {
@@ -60,6 +61,20 @@ TEST(SizeTest, Concepts) {
   ASSERT_FALSE(std::has_virtual_destructor<Size2d>::value);
 }
 
+TEST(SizeTest, UsableInConstantExpressions) {
+  constexpr Size2i unit(1);
+  static_assert(unit == Size2i(1, 1), "");
+  static_assert(unit * 2 + Vec2i(1, 0) == Size2i(3, 2), "");
+  static_assert((unit * 2)[1] == 2, "");
+  constexpr Size3d volume = Size3d(1.0, 2.0, 3.0) / 2.0;
+  static_assert(volume.vector == Vec3d(0.5, 1.0, 1.5), "");
+  constexpr Rect2i square(Vec2i(-1), Vec2i(1));
+  static_assert(square == Rect2i(-1, -1, 2, 2), "");
+  static_assert(square.translated(1).origin == Vec2i(), "");
+  static_assert(square.scaled(2, 3).size == Size2i(4, 6), "");
+  ASSERT_EQ(square.size, unit * 2);
+}
+
 TYPED_TEST(SizeTest, DefaultConstructible) {
   {
     Size2<TypeParam> s;
@@ -35,6 +35,7 @@ template class Random<>;
 template class Vec<double, 2>;
 template class Vec<double, 3>;
 template class Vec<double, 4>;
+template class VecBuffer<double, 3>;
 template class Size<double, 2>;
 template class Size<double, 3>;
 template class Line<double, 2>;
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <random>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -380,5 +381,48 @@ TYPED_TEST(TriangleTest, ImplicitlyConvertibleFromOtherTypes) {
   }
 }
 
+TYPED_TEST(TriangleTest, RandomPoint) {
+  using T = TypeParam;
+  using Real = Promote<T>;
+  Random<> random(1);
+  {
+    const Triangle2<T> triangle(0, 0, 40, 0, 0, 20);
+    std::vector<Vec2<Real>> points(10000);
+    triangle.randomPoints(points.data(), points.size(), &random);
+    points.emplace_back(triangle.randomPoint(&random));
+    Vec2<Real> mean;
+    int inner = 0;
+    for (const auto& point : points) {
+      ASSERT_GE(point.x, 0);
+      ASSERT_GE(point.y, 0);
+      ASSERT_LE(point.x / 40 + point.y / 20, 1 + 1e-6);
+      mean += point / points.size();
+      inner += point.x / 40 + point.y / 20 < 0.5;
+    }
+    // The inner triangle of half the size covers a quarter of the area
+    ASSERT_NEAR(inner, points.size() / 4, points.size() / 50);
+    ASSERT_NEAR(mean.x, triangle.centroid().x, 0.5);
+    ASSERT_NEAR(mean.y, triangle.centroid().y, 0.25);
+  } {
+    const Triangle3<T> triangle(0, 0, 10, 40, 0, 10, 0, 20, 10);
+    std::vector<Vec3<Real>> points(10000);
+    triangle.randomPoints(points.data(), points.size(), &random);
+    points.emplace_back(triangle.randomPoint(&random));
+    Vec3<Real> mean;
+    int inner = 0;
+    for (const auto& point : points) {
+      ASSERT_GE(point.x, 0);
+      ASSERT_GE(point.y, 0);
+      ASSERT_NEAR(point.z, 10, 1e-6);
+      ASSERT_LE(point.x / 40 + point.y / 20, 1 + 1e-6);
+      mean += point / points.size();
+      inner += point.x / 40 + point.y / 20 < 0.5;
+    }
+    ASSERT_NEAR(inner, points.size() / 4, points.size() / 50);
+    ASSERT_NEAR(mean.x, triangle.centroid().x, 0.5);
+    ASSERT_NEAR(mean.y, triangle.centroid().y, 0.25);
+  }
+}
+
 }  // namespace math
 }  // namespace shotamatsuda
@@ -0,0 +1,191 @@
+//
+//  vector_buffer_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/vector_buffer.h"
+
+namespace shotamatsuda {
+namespace math {
+
+template <class T>
+class VectorBufferTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(VectorBufferTest, Types);
+
+namespace {
+
+template <class T>
+std::vector<Vec3<T>> randomVectors(std::size_t size, Random<>::Type seed) {
+  Random<> random(seed);
+  std::vector<Vec3<T>> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    result.emplace_back(Vec3<T>::random(-100, 100, &random));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(VectorBufferTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Vec3dBuffer>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Vec3dBuffer>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Vec3dBuffer>::value);
+  ASSERT_TRUE(std::is_move_constructible<Vec3dBuffer>::value);
+  ASSERT_TRUE(std::is_move_assignable<Vec3dBuffer>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Vec3dBuffer>::value);
+}
+
+TYPED_TEST(VectorBufferTest, ConvertibleFromAndToVectors) {
+  const auto vectors = randomVectors<TypeParam>(37, 1);
+  {
+    Vec3Buffer<TypeParam> buffer(vectors.data(), vectors.size());
+    ASSERT_EQ(buffer.size(), vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+      ASSERT_EQ(buffer.x[i], vectors[i].x);
+      ASSERT_EQ(buffer.y[i], vectors[i].y);
+      ASSERT_EQ(buffer.z[i], vectors[i].z);
+      ASSERT_EQ(buffer[i], vectors[i]);
+    }
+    ASSERT_EQ(buffer.vectors(), vectors);
+  } {
+    Vec3Buffer<TypeParam> buffer(vectors.begin(), vectors.end());
+    std::vector<Vec3<TypeParam>> result(vectors.size());
+    buffer.copy(result.begin());
+    ASSERT_EQ(result, vectors);
+  } {
+    Vec3Buffer<TypeParam> buffer{vectors[0], vectors[1]};
+    ASSERT_EQ(buffer.size(), 2);
+    ASSERT_EQ(buffer.front(), vectors[0]);
+    ASSERT_EQ(buffer.back(), vectors[1]);
+  }
+}
+
+TYPED_TEST(VectorBufferTest, SupportsArithmetic) {
+  const auto a = randomVectors<TypeParam>(37, 2);
+  const auto b = randomVectors<TypeParam>(37, 3);
+  const Vec3Buffer<TypeParam> buffer1(a.data(), a.size());
+  const Vec3Buffer<TypeParam> buffer2(b.data(), b.size());
+  const auto s = Random<>().uniform<TypeParam>(1, 2);
+  const Vec3<TypeParam> v(1, 2, 3);
+  const auto sum = buffer1 + buffer2;
+  const auto difference = buffer1 - buffer2;
+  const auto product = buffer1 * buffer2;
+  const auto scaled = buffer1 * s;
+  auto translated = buffer1;
+  translated += v;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(sum[i], Vec3<TypeParam>(a[i] + b[i]));
+    ASSERT_EQ(difference[i], Vec3<TypeParam>(a[i] - b[i]));
+    ASSERT_EQ(product[i], Vec3<TypeParam>(a[i] * b[i]));
+    ASSERT_EQ(scaled[i], Vec3<TypeParam>(a[i] * s));
+    ASSERT_EQ(translated[i], Vec3<TypeParam>(a[i] + v));
+  }
+}
+
+TYPED_TEST(VectorBufferTest, SupportsProducts) {
+  const auto a = randomVectors<TypeParam>(37, 4);
+  const auto b = randomVectors<TypeParam>(37, 5);
+  const Vec3Buffer<TypeParam> buffer1(a.data(), a.size());
+  const Vec3Buffer<TypeParam> buffer2(b.data(), b.size());
+  std::vector<Promote<TypeParam>> dot(a.size());
+  std::vector<Promote<TypeParam>> magnitude(a.size());
+  buffer1.dot(buffer2, dot.data());
+  buffer1.magnitude(magnitude.data());
+  const auto cross = buffer1.cross(buffer2);
+  const auto normalized = buffer1.normalized();
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_NEAR(dot[i], a[i].dot(b[i]), 1e-2);
+    ASSERT_NEAR(magnitude[i], a[i].magnitude(), 1e-3);
+    ASSERT_TRUE(cross[i].equals(a[i].cross(b[i]), 1e-1));
+    ASSERT_TRUE(normalized[i].equals(a[i].normalized(), 1e-5));
+  }
+}
+
+TYPED_TEST(VectorBufferTest, KeepsZeroVectorsOnNormalization) {
+  // Enough vectors to fill packed registers as well as the scalar tail
+  Vec3Buffer<TypeParam> buffer(9, Vec3<TypeParam>());
+  buffer.set(1, Vec3<TypeParam>(3, 0, 4));
+  buffer.set(6, Vec3<TypeParam>(0, 2, 0));
+  buffer.normalize();
+  for (std::size_t i = 0; i < buffer.size(); ++i) {
+    if (i == 1) {
+      ASSERT_EQ(buffer[i], Vec3<TypeParam>(0.6, 0, 0.8));
+    } else if (i == 6) {
+      ASSERT_EQ(buffer[i], Vec3<TypeParam>(0, 1, 0));
+    } else {
+      ASSERT_TRUE(buffer[i].empty());
+    }
+  }
+}
+
+TYPED_TEST(VectorBufferTest, NormalizesFast) {
+  auto vectors = randomVectors<TypeParam>(601, 6);
+  vectors[300] = Vec3<TypeParam>();
+  Vec3Buffer<TypeParam> buffer(vectors.data(), vectors.size());
+  buffer.normalizeFast();
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    ASSERT_TRUE(buffer[i].equals(vectors[i].normalized(), 1e-5));
+  }
+  ASSERT_TRUE(buffer[300].empty());
+}
+
+TYPED_TEST(VectorBufferTest, Supports2Dimensions) {
+  Random<> random(7);
+  std::vector<Vec2<TypeParam>> a;
+  std::vector<Vec2<TypeParam>> b;
+  for (int i = 0; i < 301; ++i) {
+    a.emplace_back(Vec2<TypeParam>::random(-100, 100, &random));
+    b.emplace_back(Vec2<TypeParam>::random(-100, 100, &random));
+  }
+  a[150] = Vec2<TypeParam>();
+  const Vec2Buffer<TypeParam> buffer1(a.data(), a.size());
+  const Vec2Buffer<TypeParam> buffer2(b.begin(), b.end());
+  ASSERT_EQ(buffer1.vectors(), a);
+  ASSERT_EQ(buffer2.vectors(), b);
+  const auto sum = buffer1 + buffer2;
+  const auto normalized = buffer1.normalized();
+  const auto normalized_fast = buffer1.normalizedFast();
+  std::vector<Promote<TypeParam>> dot(a.size());
+  buffer1.dot(buffer2, dot.data());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(sum[i], a[i] + b[i]);
+    ASSERT_NEAR(dot[i], a[i].dot(b[i]), 1e-2);
+    ASSERT_TRUE(normalized[i].equals(a[i].normalized(), 1e-5));
+    ASSERT_TRUE(normalized_fast[i].equals(a[i].normalized(), 1e-5));
+  }
+  ASSERT_TRUE(normalized_fast[150].empty());
+}
+
+}  // namespace math
+}  // namespace shotamatsuda
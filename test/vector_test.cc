@@ -24,16 +24,22 @@
 //  DEALINGS IN THE SOFTWARE.
 //
 
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <random>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "shotamatsuda/math/promotion.h"
 #include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/rsqrt.h"
 #include "shotamatsuda/math/vector.h"
+#include "shotamatsuda/math/vector_expression.h"
+#include "shotamatsuda/math/vector4x.h"
 
 namespace shotamatsuda {
 namespace math {
@@ -60,6 +66,41 @@ TEST(VectorTest, Concepts) {
   ASSERT_FALSE(std::has_virtual_destructor<Vec2d>::value);
 }
 
+TEST(VectorTest, FollowsPromotionPolicy) {
+  using std::is_same;
+  static_assert(is_same<Promote<int>, PromotionPolicy::Integral>::value, "");
+  static_assert(is_same<
+      Promotion2<int, float, DoublePromotion>::Type, double>::value, "");
+  static_assert(is_same<
+      Promotion2<int, float, FloatPromotion>::Type, float>::value, "");
+  static_assert(is_same<
+      Promotion2<std::int16_t, float, FloatPromotion>::Type, float>::value, "");
+  static_assert(is_same<
+      Promotion2<int, double, FloatPromotion>::Type, double>::value, "");
+  static_assert(is_same<
+      Promotion1<std::uint8_t, FloatPromotion>::Type, float>::value, "");
+  static_assert(is_same<
+      decltype(Vec2i() + Vec2f()), Vec2<Promote<int, float>>>::value, "");
+  ASSERT_EQ(Vec2i(3, 4).magnitude(), Promote<int>(5));
+}
+
+TEST(VectorTest, UsableInConstantExpressions) {
+  constexpr Vec2i directions[] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+  static_assert(directions[1].y == 1, "");
+  static_assert(directions[2][0] == -1, "");
+  static_assert(directions[0] + directions[1] == Vec2i(1, 1), "");
+  static_assert(directions[0] != directions[2], "");
+  static_assert(directions[2] < directions[0], "");
+  static_assert(-directions[0] == directions[2], "");
+  constexpr Vec3d offset = Vec3d(1.0, 2.0, 3.0) * 2.0 - 1.0;
+  static_assert(offset == Vec3d(1.0, 3.0, 5.0), "");
+  static_assert(Vec3d(offset) / Vec3d(1.0, 3.0, 5.0) == Vec3d(1.0), "");
+  constexpr Vec4f point(Vec3f(0.5f));
+  static_assert(point.z == 0.5f && point.back() == 0.0f, "");
+  static_assert(Vec2i::max().x == std::numeric_limits<int>::max(), "");
+  ASSERT_EQ(directions[3], Vec2i(0, -1));
+}
+
 TYPED_TEST(VectorTest, DefaultConstructible) {
   {
     Vec2<TypeParam> v;
@@ -681,5 +722,104 @@ TYPED_TEST(VectorTest, SupportsScalarArithmetic) {
   }
 }
 
+TYPED_TEST(VectorTest, EvaluatesExpressionsLazily) {
+  Random<> random(1);
+  const auto s = random.uniform<TypeParam>(0, 10);
+  {
+    const auto a = Vec2<TypeParam>::random(0, 100, &random);
+    const auto b = Vec2<TypeParam>::random(1, 100, &random);
+    const Vec2<Promote<TypeParam>> result = lazy(a) + (lazy(b) - a) * s;
+    ASSERT_EQ(result, a + (b - a) * s);
+    ASSERT_EQ((2 * -lazy(a) / b).evaluate(), 2 * -a / b);
+  } {
+    const auto a = Vec3<TypeParam>::random(0, 100, &random);
+    const auto b = Vec3<TypeParam>::random(1, 100, &random);
+    const Vec3<Promote<TypeParam>> result = lazy(a) + (lazy(b) - a) * s;
+    ASSERT_EQ(result, a + (b - a) * s);
+    ASSERT_EQ((2 * -lazy(a) / b).evaluate(), 2 * -a / b);
+  } {
+    const auto a = Vec4<TypeParam>::random(0, 100, &random);
+    const auto b = Vec4<TypeParam>::random(1, 100, &random);
+    const Vec4<Promote<TypeParam>> result = lazy(a) + (lazy(b) - a) * s;
+    ASSERT_EQ(result, a + (b - a) * s);
+    ASSERT_EQ((2 * -lazy(a) / b).evaluate(), 2 * -a / b);
+  }
+}
+
+TEST(VectorTest, ApproximatesReciprocalSquareRoot) {
+  Random<> random(1);
+  for (int i = 0; i < 10000; ++i) {
+    const auto exponent = random.uniform<int>(-36, 36);
+    const auto f = random.uniform<float>(1, 10) * std::pow(10.f, exponent);
+    const auto d = random.uniform<double>(1, 10) * std::pow(10.0, 4 * exponent);
+    ASSERT_NEAR(rsqrt(f) * std::sqrt(f), 1, 5e-6);
+    ASSERT_NEAR(rsqrt(d) * std::sqrt(d), 1, 5e-6);
+  }
+  std::vector<float> values(37);
+  std::vector<float> results(values.size());
+  for (auto& value : values) {
+    value = random.uniform<float>(1e-3, 1e3);
+  }
+  rsqrt(values.data(), static_cast<int>(values.size()), results.data());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_NEAR(results[i] * std::sqrt(values[i]), 1, 5e-6);
+  }
+}
+
+TYPED_TEST(VectorTest, NormalizesFast) {
+  {
+    const auto v = Vec2<TypeParam>::random(-100, 100);
+    ASSERT_TRUE(v.normalizedFast().equals(v.normalized(), 1e-5));
+  } {
+    const auto v = Vec3<TypeParam>::random(-100, 100);
+    ASSERT_TRUE(v.normalizedFast().equals(v.normalized(), 1e-5));
+  } {
+    const auto v = Vec4<TypeParam>::random(-100, 100);
+    ASSERT_TRUE(v.normalizedFast().equals(v.normalized(), 1e-5));
+  } {
+    ASSERT_TRUE(Vec3<TypeParam>().normalizedFast().empty());
+  }
+}
+
+TEST(VectorTest, AlignedVec4fMatchesVec4f) {
+  ASSERT_EQ(alignof(Vec4fx), 16);
+  ASSERT_EQ(sizeof(Vec4fx), sizeof(Vec4f));
+  Random<> random(1);
+  for (int i = 0; i < 100; ++i) {
+    const auto a = Vec4f::random(-10.f, 10.f, &random);
+    const auto b = Vec4f::random(1.f, 10.f, &random);
+    const auto s = random.uniform<float>(1.f, 10.f);
+    const Vec4fx ax(a);
+    const Vec4fx bx(b);
+    ASSERT_EQ(ax.x, a.x);
+    ASSERT_EQ(ax.y, a.y);
+    ASSERT_EQ(ax.z, a.z);
+    ASSERT_EQ(ax.w, a.w);
+    ASSERT_EQ(Vec4f(ax + bx), Vec4f(a + b));
+    ASSERT_EQ(Vec4f(ax - bx), Vec4f(a - b));
+    ASSERT_EQ(Vec4f(ax * bx), Vec4f(a * b));
+    ASSERT_EQ(Vec4f(ax / bx), Vec4f(a / b));
+    ASSERT_EQ(Vec4f(ax * s), Vec4f(a * s));
+    ASSERT_EQ(Vec4f(-ax), Vec4f(-a));
+    ASSERT_NEAR(ax.dot(bx), a.dot(b), 1e-3);
+    ASSERT_NEAR(ax.magnitude(), a.magnitude(), 1e-4);
+    ASSERT_TRUE(Vec4f(ax.normalized()).equals(a.normalized(), 1e-6));
+    ASSERT_TRUE(Vec4f(ax.normalizedFast()).equals(a.normalized(), 1e-5));
+    ASSERT_TRUE(ax.lerp(bx, 0.5f).equals(Vec4fx(a.lerp(b, 0.5f)), 1e-5));
+  }
+  ASSERT_TRUE(Vec4fx().normalized().empty());
+}
+
+TEST(VectorTest, IteratesAlignedVec4fInReverse) {
+  Vec4fx vector(1.f, 2.f, 3.f, 4.f);
+  const std::vector<float> reversed(vector.rbegin(), vector.rend());
+  ASSERT_EQ(reversed, (std::vector<float>{4.f, 3.f, 2.f, 1.f}));
+  const Vec4fx& constant = vector;
+  const std::vector<float> const_reversed(constant.rbegin(), constant.rend());
+  ASSERT_EQ(const_reversed, reversed);
+  *vector.rbegin() = 5.f;
+  ASSERT_EQ(vector.w, 5.f);
+}
+
 }  // namespace math
 }  // namespace shotamatsuda
@@ -0,0 +1,93 @@
+//
+//  xoshiro_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2013-2017 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "shotamatsuda/math/random.h"
+#include "shotamatsuda/math/xoshiro.h"
+
+namespace shotamatsuda {
+namespace math {
+
+TEST(XoshiroTest, KnownAnswers) {
+  Xoshiro256 engine(Xoshiro256::State{{1, 2, 3, 4}});
+  ASSERT_EQ(engine(), 11520);
+  ASSERT_EQ(engine(), 0);
+  ASSERT_EQ(engine(), 1509978240);
+  ASSERT_EQ(engine(), 1215971899390074240);
+}
+
+TEST(XoshiroTest, Seeding) {
+  Xoshiro256 engine(42);
+  Xoshiro256 other;
+  ASSERT_NE(engine, other);
+  other.seed(42);
+  ASSERT_EQ(engine, other);
+  for (const auto element : engine.state()) {
+    ASSERT_NE(element, 0);
+  }
+  engine.discard(5);
+  for (int i = 0; i < 5; ++i) {
+    other();
+  }
+  ASSERT_EQ(engine, other);
+}
+
+TEST(XoshiroTest, Jump) {
+  Xoshiro256 engine(7);
+  Xoshiro256 jumped(engine);
+  jumped.jump();
+  Xoshiro256 long_jumped(engine);
+  long_jumped.longJump();
+  ASSERT_NE(jumped, engine);
+  ASSERT_NE(long_jumped, engine);
+  ASSERT_NE(long_jumped, jumped);
+  std::set<std::uint64_t> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.emplace(engine());
+    values.emplace(jumped());
+    values.emplace(long_jumped());
+  }
+  ASSERT_EQ(values.size(), 3000);
+}
+
+TEST(XoshiroTest, UsableWithRandom) {
+  Random<Xoshiro256> random(5);
+  Random<Xoshiro256> other(5);
+  for (int i = 0; i < 100; ++i) {
+    const auto value = random.uniform<float>(-1, 1);
+    ASSERT_GE(value, -1);
+    ASSERT_LE(value, 1);
+    ASSERT_EQ(other.uniform<float>(-1, 1), value);
+  }
+  ASSERT_EQ(random.engine(), other.engine());
+}
+
+}  // namespace math
+}  // namespace shotamatsuda